@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <atomContainer/flat_map.hpp>
+#include <atomContainer/frozen_flat.hpp>
+
+template <typename Key>
+using FlatMap = atom::stl_flat_map<Key, uint64_t>;
+
+template <typename Key>
+using FrozenMap = atom::frozen_flat<FlatMap<Key>>;
+
+template <typename Key>
+static FlatMap<Key> make_flat(size_t count, std::vector<Key>& queries)
+{
+    std::mt19937_64                             rng(count);
+    std::vector<std::pair<const Key, uint64_t>> values;
+    for (size_t i = 0; i < count; i++) values.emplace_back((Key)rng(), i);
+    FlatMap<Key> map(values.begin(), values.end());
+    // half hits and half (probable) misses, shuffled so the branch predictor cannot learn the pattern
+    queries.clear();
+    for (const auto& [key, value] : map) queries.push_back(key);
+    for (size_t i = 0; i < map.size(); i++) queries.push_back((Key)rng());
+    std::shuffle(queries.begin(), queries.end(), rng);
+    return map;
+}
+
+template <typename Map, typename Key>
+static void bm_search(benchmark::State& state)
+{
+    std::vector<Key> queries;
+    const Map        map(make_flat<Key>((size_t)state.range(0), queries));
+    for (auto _ : state) {
+        size_t found = 0;
+        for (const auto& key : queries) found += map.find(key) != map.end();
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)queries.size());
+}
+
+// 16 to 4M keys, past the last level cache at the top end
+#define FROZEN_RANGE RangeMultiplier(8)->Range(16, 1 << 22)
+
+BENCHMARK_TEMPLATE(bm_search, FlatMap<uint32_t>, uint32_t)->FROZEN_RANGE;
+BENCHMARK_TEMPLATE(bm_search, FrozenMap<uint32_t>, uint32_t)->FROZEN_RANGE;
+BENCHMARK_TEMPLATE(bm_search, FlatMap<uint64_t>, uint64_t)->FROZEN_RANGE;
+BENCHMARK_TEMPLATE(bm_search, FrozenMap<uint64_t>, uint64_t)->FROZEN_RANGE;
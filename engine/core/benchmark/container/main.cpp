@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+// every container/*.cpp registers into this one binary
+BENCHMARK_MAIN();
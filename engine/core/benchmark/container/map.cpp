@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <atomContainer/btree.hpp>
+#include <atomContainer/flat_map.hpp>
+#include <atomContainer/hashmap.hpp>
+
+using Key   = uint64_t;
+using Value = uint64_t;
+
+// sorted vectors move half of their elements per random insert or erase, beyond this those runs take minutes
+static constexpr int64_t kMaxFlatRandomModify = 1 << 16;
+
+using SmallFlatMap = atom::small_flat_map<Key, Value>;
+using StlFlatMap   = atom::stl_flat_map<Key, Value>;
+using BtreeMap     = atom::btree_map<Key, Value>;
+using FlatHashMap  = atom::flat_hash_map<Key, Value>;
+using StdMap       = std::map<Key, Value>;
+using StdHashMap   = std::unordered_map<Key, Value>;
+
+// distinct keys in random order, the same set for every container of a given size
+static std::vector<Key> make_keys(size_t count)
+{
+    std::mt19937_64  rng(count);
+    std::vector<Key> keys(count);
+    for (auto& key : keys) key = rng();
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+template <typename Map>
+static Map make_map(const std::vector<Key>& keys)
+{
+    Map map;
+    if constexpr (requires { map.reserve(keys.size()); }) map.reserve(keys.size());
+    for (const auto& key : keys) map.emplace(key, key);
+    return map;
+}
+
+template <typename Map>
+static void bm_insert(benchmark::State& state)
+{
+    const auto keys = make_keys((size_t)state.range(0));
+    for (auto _ : state) {
+        Map map;
+        for (const auto& key : keys) map.emplace(key, key);
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+// the whole table in one call, how asset and format tables are loaded
+template <typename Map>
+static void bm_insert_range(benchmark::State& state)
+{
+    const auto                               keys = make_keys((size_t)state.range(0));
+    std::vector<std::pair<const Key, Value>> values;
+    for (const auto& key : keys) values.emplace_back(key, key);
+    for (auto _ : state) {
+        Map map;
+        map.insert(values.begin(), values.end());
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+template <typename Map>
+static void bm_find(benchmark::State& state)
+{
+    const auto keys = make_keys((size_t)state.range(0));
+    const Map  map  = make_map<Map>(keys);
+    for (auto _ : state) {
+        Value sum = 0;
+        for (const auto& key : keys) sum += map.find(key)->second;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+template <typename Map>
+static void bm_find_miss(benchmark::State& state)
+{
+    const auto keys = make_keys((size_t)state.range(0));
+    const Map  map  = make_map<Map>(keys);
+    for (auto _ : state) {
+        size_t found = 0;
+        // neighbours of present keys, a collision with another key is unlikely enough to not matter
+        for (const auto& key : keys) found += map.find(key + 1) != map.end();
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+template <typename Map>
+static void bm_erase(benchmark::State& state)
+{
+    const auto keys = make_keys((size_t)state.range(0));
+    const Map  full = make_map<Map>(keys);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Map map = full;
+        state.ResumeTiming();
+        for (const auto& key : keys) map.erase(key);
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+template <typename Map>
+static void bm_iterate(benchmark::State& state)
+{
+    const auto keys = make_keys((size_t)state.range(0));
+    const Map  map  = make_map<Map>(keys);
+    for (auto _ : state) {
+        Value sum = 0;
+        for (const auto& [key, value] : map) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)keys.size());
+}
+
+// 16 to 1M elements, each step 8 times the last
+#define CONTAINER_RANGE(max) RangeMultiplier(8)->Range(16, (max))
+#define CONTAINER_BENCHMARKS(Map, modify_max)                                   \
+    BENCHMARK_TEMPLATE(bm_insert, Map)->CONTAINER_RANGE(modify_max);             \
+    BENCHMARK_TEMPLATE(bm_insert_range, Map)->CONTAINER_RANGE(1 << 20);          \
+    BENCHMARK_TEMPLATE(bm_find, Map)->CONTAINER_RANGE(1 << 20);                  \
+    BENCHMARK_TEMPLATE(bm_find_miss, Map)->CONTAINER_RANGE(1 << 20);             \
+    BENCHMARK_TEMPLATE(bm_erase, Map)->CONTAINER_RANGE(modify_max);              \
+    BENCHMARK_TEMPLATE(bm_iterate, Map)->CONTAINER_RANGE(1 << 20)
+
+CONTAINER_BENCHMARKS(SmallFlatMap, kMaxFlatRandomModify);
+CONTAINER_BENCHMARKS(StlFlatMap, kMaxFlatRandomModify);
+CONTAINER_BENCHMARKS(BtreeMap, 1 << 20);
+CONTAINER_BENCHMARKS(FlatHashMap, 1 << 20);
+CONTAINER_BENCHMARKS(StdMap, 1 << 20);
+CONTAINER_BENCHMARKS(StdHashMap, 1 << 20);
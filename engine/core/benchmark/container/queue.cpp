@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <atomContainer/mpmc_queue.hpp>
+#include <atomContainer/spsc_queue.hpp>
+
+using Value = uint64_t;
+
+// enough room for every thread to have a full batch in flight
+static constexpr size_t kQueueCapacity = 1 << 14;
+static constexpr size_t kBatchSize     = 32;
+
+// the baseline, what the engine used before the lock-free queues
+class MutexQueue
+{
+public:
+    explicit MutexQueue(size_t capacity) : m_capacity{capacity} {}
+
+    bool try_push(Value value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_values.size() == m_capacity) return false;
+        m_values.push_back(value);
+        return true;
+    }
+
+    bool try_pop(Value& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_values.empty()) return false;
+        value = m_values.front();
+        m_values.pop_front();
+        return true;
+    }
+
+    size_t try_push_bulk(const Value* values, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = std::min(count, m_capacity - m_values.size());
+        m_values.insert(m_values.end(), values, values + count);
+        return count;
+    }
+
+    size_t try_pop_bulk(Value* values, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = std::min(count, m_values.size());
+        std::copy_n(m_values.begin(), count, values);
+        m_values.erase(m_values.begin(), m_values.begin() + count);
+        return count;
+    }
+
+private:
+    std::mutex        m_mutex;
+    std::deque<Value> m_values;
+    size_t            m_capacity;
+};
+
+using MpmcQueue = atom::mpmc_queue<Value>;
+using SpscQueue = atom::spsc_queue<Value>;
+
+// shared by every thread of a run, and empty again once a run is done
+template <typename Queue>
+static Queue& shared_queue()
+{
+    static Queue queue(kQueueCapacity);
+    return queue;
+}
+
+// every thread pushes one value and pops one, so any thread count works and the queue never fills up
+template <typename Queue>
+static void bm_push_pop(benchmark::State& state)
+{
+    Queue& queue = shared_queue<Queue>();
+    Value  value = (Value)state.thread_index();
+    for (auto _ : state) {
+        while (!queue.try_push(value)) std::this_thread::yield();
+        while (!queue.try_pop(value)) std::this_thread::yield();
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// the same with kBatchSize values per call, a pop may come back short when other threads were faster
+template <typename Queue>
+static void bm_push_pop_bulk(benchmark::State& state)
+{
+    Queue& queue = shared_queue<Queue>();
+    Value  values[kBatchSize];
+    for (size_t i = 0; i < kBatchSize; i++) values[i] = (Value)i;
+    for (auto _ : state) {
+        for (size_t pushed = 0; pushed < kBatchSize;) {
+            const size_t count = queue.try_push_bulk(values + pushed, kBatchSize - pushed);
+            if (!count) std::this_thread::yield();
+            pushed += count;
+        }
+        for (size_t popped = 0; popped < kBatchSize;) {
+            const size_t count = queue.try_pop_bulk(values + popped, kBatchSize - popped);
+            if (!count) std::this_thread::yield();
+            popped += count;
+        }
+    }
+    benchmark::DoNotOptimize(values);
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// thread 0 produces and thread 1 consumes, the only shape the spsc ring supports
+template <typename Queue>
+static void bm_producer_consumer(benchmark::State& state)
+{
+    Queue& queue = shared_queue<Queue>();
+    Value  value = 0;
+    if (state.thread_index() == 0) {
+        for (auto _ : state)
+            while (!queue.try_push(value++)) std::this_thread::yield();
+    } else {
+        for (auto _ : state)
+            while (!queue.try_pop(value)) std::this_thread::yield();
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Queue>
+static void bm_producer_consumer_bulk(benchmark::State& state)
+{
+    Queue& queue = shared_queue<Queue>();
+    Value  values[kBatchSize] = {};
+    for (auto _ : state) {
+        for (size_t done = 0; done < kBatchSize;) {
+            const size_t count = state.thread_index() == 0 ? queue.try_push_bulk(values + done, kBatchSize - done)
+                                                            : queue.try_pop_bulk(values + done, kBatchSize - done);
+            if (!count) std::this_thread::yield();
+            done += count;
+        }
+    }
+    benchmark::DoNotOptimize(values);
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// 1 to 64 threads, doubling, real time since the cpu time of waiting threads means little
+#define QUEUE_THREADS ThreadRange(1, 64)->UseRealTime()
+
+BENCHMARK_TEMPLATE(bm_push_pop, MutexQueue)->QUEUE_THREADS;
+BENCHMARK_TEMPLATE(bm_push_pop, MpmcQueue)->QUEUE_THREADS;
+BENCHMARK_TEMPLATE(bm_push_pop_bulk, MutexQueue)->QUEUE_THREADS;
+BENCHMARK_TEMPLATE(bm_push_pop_bulk, MpmcQueue)->QUEUE_THREADS;
+
+BENCHMARK_TEMPLATE(bm_producer_consumer, MutexQueue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_producer_consumer, MpmcQueue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_producer_consumer, SpscQueue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_producer_consumer_bulk, MutexQueue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_producer_consumer_bulk, MpmcQueue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_producer_consumer_bulk, SpscQueue)->Threads(2)->UseRealTime();
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <atomContainer/slot_map.hpp>
+
+// roughly an AGPU buffer object
+struct Resource {
+    uint64_t size;
+    uint64_t offset;
+    void*    mapped;
+    uint32_t flags;
+    uint32_t state;
+};
+
+// heap objects addressed by pointer, how AGPU objects are held today
+static void bm_pointer_lookup(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<Resource>> owned;
+    for (int64_t i = 0; i < state.range(0); i++) owned.push_back(std::make_unique<Resource>(Resource{(uint64_t)i}));
+    std::vector<Resource*> handles;
+    for (const auto& resource : owned) handles.push_back(resource.get());
+    std::shuffle(handles.begin(), handles.end(), std::mt19937_64(state.range(0)));
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (Resource* resource : handles) sum += resource->size;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_slot_map_lookup(benchmark::State& state)
+{
+    atom::slot_map<Resource>           map;
+    std::vector<atom::slot_map_handle> handles;
+    for (int64_t i = 0; i < state.range(0); i++) handles.push_back(map.emplace(Resource{(uint64_t)i}));
+    std::shuffle(handles.begin(), handles.end(), std::mt19937_64(state.range(0)));
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto handle : handles) sum += map[handle].size;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// validated lookup, what a debug layer would do per call
+static void bm_slot_map_get(benchmark::State& state)
+{
+    atom::slot_map<Resource>           map;
+    std::vector<atom::slot_map_handle> handles;
+    for (int64_t i = 0; i < state.range(0); i++) handles.push_back(map.emplace(Resource{(uint64_t)i}));
+    std::shuffle(handles.begin(), handles.end(), std::mt19937_64(state.range(0)));
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto handle : handles)
+            if (const Resource* resource = map.get(handle)) sum += resource->size;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_slot_map_iterate(benchmark::State& state)
+{
+    atom::slot_map<Resource> map;
+    for (int64_t i = 0; i < state.range(0); i++) map.emplace(Resource{(uint64_t)i});
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& resource : map) sum += resource.size;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// steady state create/free, every iteration frees a random live element and creates a new one
+static void bm_slot_map_churn(benchmark::State& state)
+{
+    atom::slot_map<Resource>           map;
+    std::vector<atom::slot_map_handle> handles;
+    for (int64_t i = 0; i < state.range(0); i++) handles.push_back(map.emplace(Resource{(uint64_t)i}));
+    std::mt19937_64 rng(state.range(0));
+    for (auto _ : state) {
+        auto& handle = handles[rng() % handles.size()];
+        map.erase(handle);
+        handle = map.emplace(Resource{});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define SLOT_MAP_RANGE RangeMultiplier(8)->Range(64, 1 << 18)
+
+BENCHMARK(bm_pointer_lookup)->SLOT_MAP_RANGE;
+BENCHMARK(bm_slot_map_lookup)->SLOT_MAP_RANGE;
+BENCHMARK(bm_slot_map_get)->SLOT_MAP_RANGE;
+BENCHMARK(bm_slot_map_iterate)->SLOT_MAP_RANGE;
+BENCHMARK(bm_slot_map_churn)->SLOT_MAP_RANGE;
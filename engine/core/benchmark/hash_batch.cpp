@@ -0,0 +1,65 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <atomCore/base/hash.h>
+
+static const uint64_t kHashSeed = 8053064571610612741ULL;
+
+// resource-name-like keys, lengths drawn from [min_length, max_length]
+struct HashBatchKeys {
+    std::vector<std::string> storage;
+    std::vector<const void*> inputs;
+    std::vector<size_t>      lengths;
+    std::vector<uint64_t>    out;
+
+    HashBatchKeys(size_t count, size_t min_length, size_t max_length)
+    {
+        std::mt19937_64                       rng(count);
+        std::uniform_int_distribution<size_t> length(min_length, max_length);
+        std::uniform_int_distribution<int>    chr('a', 'z');
+        for (size_t i = 0; i < count; i++) {
+            std::string key(length(rng), '\0');
+            for (auto& c : key) c = (char)chr(rng);
+            storage.push_back(std::move(key));
+        }
+        for (const auto& key : storage) {
+            inputs.push_back(key.data());
+            lengths.push_back(key.size());
+        }
+        out.resize(count);
+    }
+};
+
+static void bm_hash_64_loop(benchmark::State& state)
+{
+    HashBatchKeys keys((size_t)state.range(0), (size_t)state.range(1), (size_t)state.range(2));
+    for (auto _ : state) {
+        for (size_t i = 0; i < keys.inputs.size(); i++) keys.out[i] = atom_hash_64(keys.inputs[i], keys.lengths[i], kHashSeed);
+        benchmark::DoNotOptimize(keys.out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void bm_hash_batch(benchmark::State& state)
+{
+    HashBatchKeys keys((size_t)state.range(0), (size_t)state.range(1), (size_t)state.range(2));
+    for (auto _ : state) {
+        atom_hash_batch(keys.inputs.data(), keys.lengths.data(), (uint32_t)keys.inputs.size(), kHashSeed, keys.out.data());
+        benchmark::DoNotOptimize(keys.out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// {count, min length, max length}
+#define HASH_BATCH_ARGS                                                                                                 \
+    Args({256, 1, 3})->Args({256, 4, 8})->Args({256, 9, 16})->Args({256, 1, 16})->Args({256, 4, 32})->Args({16, 4, 16})
+
+BENCHMARK(bm_hash_64_loop)->HASH_BATCH_ARGS;
+BENCHMARK(bm_hash_batch)->HASH_BATCH_ARGS;
+
+BENCHMARK_MAIN();
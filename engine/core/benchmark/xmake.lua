@@ -0,0 +1,25 @@
+option("benchmarks")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the engine microbenchmarks")
+option_end()
+
+if has_config("benchmarks") then
+    add_requires("benchmark")
+
+    target("AtomEngine_Core_Benchmark")
+        set_kind("binary")
+        set_default(false)
+        add_files("./*.cpp")
+        add_deps("AtomEngine_Core")
+        add_packages("benchmark")
+
+    -- xmake run AtomEngine_Container_Benchmark leaves container_benchmark.json in the run directory to diff between versions
+    target("AtomEngine_Container_Benchmark")
+        set_kind("binary")
+        set_default(false)
+        add_files("./container/*.cpp")
+        add_deps("AtomEngine_Core")
+        add_packages("benchmark")
+        set_runargs("--benchmark_out=container_benchmark.json", "--benchmark_out_format=json")
+end
@@ -10,6 +10,8 @@ template <typename Compare, bool = std::is_empty_v<Compare> && !std::is_final_v<
 class flat_multimap_base_comp_storage : private Compare
 {
 public:
+    constexpr flat_multimap_base_comp_storage() = default;
+
     template <typename T>
     constexpr flat_multimap_base_comp_storage(T&& t) noexcept(std::is_nothrow_constructible_v<Compare, T>)
         : Compare{std::forward<T>(t)}
@@ -26,6 +28,8 @@ template <typename Compare>
 class flat_multimap_base_comp_storage<Compare, false>
 {
 public:
+    constexpr flat_multimap_base_comp_storage() = default;
+
     template <typename T>
     constexpr flat_multimap_base_comp_storage(T&& t) noexcept(std::is_nothrow_constructible_v<Compare, T>)
         : comp{std::forward<T>(t)}
@@ -68,6 +72,8 @@ public:
         return this->GetCompare()(std::get<0>(lhs), std::get<0>(rhs));
     }
 
+    constexpr bool operator()(const Key& lhs, const Key& rhs) const { return this->GetCompare()(lhs, rhs); }
+
     template <class K>
     constexpr bool operator()(const K& lhs, const MapValue& rhs) const
     {
@@ -116,6 +122,8 @@ public:
         return this->GetCompare()(std::get<0>(lhs), std::get<0>(rhs));
     }
 
+    constexpr bool operator()(const Key& lhs, const Key& rhs) const { return this->GetCompare()(lhs, rhs); }
+
     constexpr bool operator()(const Key& lhs, const MapValue& rhs) const { return this->GetCompare()(lhs, std::get<0>(rhs)); }
 
     constexpr bool operator()(const MapValue& lhs, const Key& rhs) const { return this->GetCompare()(std::get<0>(lhs), rhs); }
@@ -259,13 +267,20 @@ public:
         return emplace_hint(hint, std::forward<P>(value));
     }
 
-    // FIXME
     template <typename InputIt>
     void insert(InputIt first, InputIt last)
     {
         mybase::insert(first, last);
     }
 
+    template <typename InputIt>
+    void insert_sorted_unique(InputIt first, InputIt last)
+    {
+        mybase::insert_sorted_unique(first, last);
+    }
+
+    using mybase::adopt_sorted_storage;
+
     template <typename... Args>
     iterator emplace(Args&&... args)
     {
@@ -178,10 +178,32 @@ public:
 
     iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
 
+    // appends the range, sorts only the new part and merges it in, O(n + k log k) instead of k shifting inserts.
+    // like insert of a single value, a key that is already present (or repeated in the range) keeps its first value.
     template <typename InputIt>
     void insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first) insert(*first);
+        const size_type old_size = size();
+        storage.insert(storage.end(), first, last);
+        std::stable_sort(begin() + old_size, end(), this->GetCompare());
+        merge_appended(old_size);
+    }
+
+    // the same for a range that is already sorted (and free of duplicates unless is_multi), which skips the sort
+    template <typename InputIt>
+    void insert_sorted_unique(InputIt first, InputIt last)
+    {
+        const size_type old_size = size();
+        storage.insert(storage.end(), first, last);
+        assert(is_sorted_unique(begin() + old_size, end()));
+        merge_appended(old_size);
+    }
+
+    // takes over storage that the caller already sorted, e.g. a table built in one go or loaded from disk
+    void adopt_sorted_storage(container_type&& sorted_storage)
+    {
+        storage = std::move(sorted_storage);
+        assert(is_sorted_unique(begin(), end()));
     }
 
     void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
@@ -332,6 +354,38 @@ protected:
     container_type storage;
 
 private:
+    bool is_sorted_unique(const_iterator first, const_iterator last) const
+    {
+        auto& comp = this->GetCompare();
+        if constexpr (is_multi)
+            return std::is_sorted(first, last, comp);
+        else {
+            auto not_less = [&comp](const auto& lhs, const auto& rhs) { return !comp(lhs, rhs); };
+            return std::adjacent_find(first, last, not_less) == last;
+        }
+    }
+
+    // [begin, begin + old_size) and [begin + old_size, end) are each sorted, leaves the whole storage sorted
+    void merge_appended(size_type old_size)
+    {
+        auto& comp = this->GetCompare();
+        if constexpr (!is_multi) {
+            // drop new values whose key repeats within the new part or already exists in the old one
+            const iterator middle = begin() + old_size;
+            iterator       old    = begin();
+            iterator       out    = middle;
+            for (iterator in = middle; in != end(); ++in) {
+                if (out != middle && !comp(*std::prev(out), *in)) continue;
+                old = std::lower_bound(old, middle, *in, comp);
+                if (old != middle && !comp(*in, *old)) continue;
+                if (out != in) *out = std::move(*in);
+                ++out;
+            }
+            storage.erase(out, end());
+        }
+        std::inplace_merge(begin(), begin() + old_size, end(), comp);
+    }
+
     template <typename K>
     iterator t_find(const K& key)
     {
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace atom::detail
+{
+// fixed rather than std::hardware_destructive_interference_size, which changes with compiler flags and breaks the abi
+inline constexpr std::size_t cache_line_size = 64;
+
+inline constexpr std::size_t ring_buffer_capacity(std::size_t requested) noexcept
+{
+    std::size_t capacity = 2;
+    while (capacity < requested) capacity <<= 1;
+    return capacity;
+}
+
+// uninitialized power of two storage for the queues, slots are addressed by an ever growing index
+template <typename Slot, typename Alloc>
+class ring_buffer_storage
+{
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using traits_type    = std::allocator_traits<allocator_type>;
+
+public:
+    ring_buffer_storage(std::size_t capacity, const Alloc& alloc)
+        : m_alloc{alloc}, m_capacity{ring_buffer_capacity(capacity)}, m_mask{m_capacity - 1}
+    {
+        m_slots = traits_type::allocate(m_alloc, m_capacity);
+    }
+
+    ring_buffer_storage(const ring_buffer_storage&)            = delete;
+    ring_buffer_storage& operator=(const ring_buffer_storage&) = delete;
+
+    ~ring_buffer_storage() { traits_type::deallocate(m_alloc, m_slots, m_capacity); }
+
+    Slot&       operator[](std::size_t index) noexcept { return m_slots[index & m_mask]; }
+    const Slot& operator[](std::size_t index) const noexcept { return m_slots[index & m_mask]; }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    [[no_unique_address]] allocator_type m_alloc;
+    Slot*                                m_slots;
+    std::size_t                          m_capacity;
+    std::size_t                          m_mask;
+};
+} // namespace atom::detail
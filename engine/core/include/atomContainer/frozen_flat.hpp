@@ -0,0 +1,146 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <atomCore/config.h>
+
+namespace atom
+{
+// read-only companion of a flat_set / flat_map for tables that are built once and searched often. the keys are copied
+// into Eytzinger (breadth first) order, so a search touches the top levels of the tree in the first few cache lines,
+// walks down without branches, and prefetches the level four steps below. the flat container is kept as is, so
+// iteration and the iterators returned by searches are in key order. Compare must order keys the way the flat
+// container does, the default is the key_compare of the flat container itself.
+template <typename Flat, typename Compare = typename Flat::key_compare>
+class frozen_flat
+{
+public:
+    using flat_type      = Flat;
+    using key_type       = typename Flat::key_type;
+    using value_type     = typename Flat::value_type;
+    using size_type      = typename Flat::size_type;
+    using const_iterator = typename Flat::const_iterator;
+    using key_compare    = Compare;
+
+    frozen_flat() = default;
+
+    explicit frozen_flat(Flat flat, const Compare& comp = Compare()) : m_flat{std::move(flat)}, m_comp{comp} { build(); }
+
+    // gives the container back for modification, the frozen view is empty afterwards
+    Flat thaw() &&
+    {
+        m_keys.clear();
+        m_ranks.clear();
+        return std::move(m_flat);
+    }
+
+    const Flat& flat() const noexcept { return m_flat; }
+
+    const_iterator begin() const noexcept { return m_flat.begin(); }
+    const_iterator cbegin() const noexcept { return m_flat.cbegin(); }
+    const_iterator end() const noexcept { return m_flat.end(); }
+    const_iterator cend() const noexcept { return m_flat.cend(); }
+
+    size_type size() const noexcept { return m_flat.size(); }
+
+    bool empty() const noexcept { return m_flat.empty(); }
+
+    const_iterator lower_bound(const key_type& key) const
+    {
+        return begin() + descend([&](const key_type& node) { return m_comp(node, key); });
+    }
+
+    const_iterator upper_bound(const key_type& key) const
+    {
+        return begin() + descend([&](const key_type& node) { return !m_comp(key, node); });
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+    {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        const_iterator lb = lower_bound(key);
+        return lb != end() && !m_comp(key, key_of(*lb)) ? lb : end();
+    }
+
+    bool contains(const key_type& key) const { return find(key) != end(); }
+
+    size_type count(const key_type& key) const
+    {
+        auto [first, last] = equal_range(key);
+        return (size_type)(last - first);
+    }
+
+    key_compare key_comp() const { return m_comp; }
+
+private:
+    // keys per cache line, the node index times this is four levels further down
+    static constexpr size_type prefetch_stride = sizeof(key_type) < 64 ? 64 / sizeof(key_type) : 1;
+
+    static const key_type& key_of(const value_type& value) noexcept
+    {
+        if constexpr (requires { typename Flat::mapped_type; })
+            return value.first;
+        else
+            return value;
+    }
+
+    void build()
+    {
+        const size_type count = m_flat.size();
+        assert(count < UINT32_MAX && "frozen_flat stores 32-bit ranks");
+        if (!count) return;
+        // index 0 is unused, node k has children 2k and 2k + 1
+        m_ranks.resize(count + 1);
+        uint32_t rank = 0;
+        assign_ranks(rank, 1);
+        m_keys.reserve(count + 1);
+        m_keys.push_back(key_of(*begin()));
+        for (size_type k = 1; k <= count; k++) m_keys.push_back(key_of(begin()[m_ranks[k]]));
+    }
+
+    // in-order walk of the implicit tree hands out sorted positions
+    void assign_ranks(uint32_t& rank, size_type k)
+    {
+        if (k >= m_ranks.size()) return;
+        assign_ranks(rank, 2 * k);
+        m_ranks[k] = rank++;
+        assign_ranks(rank, 2 * k + 1);
+    }
+
+    // rank of the first key for which go_right is false, size() if there is none
+    template <typename GoRight>
+    size_type descend(GoRight&& go_right) const
+    {
+        const size_type count = m_flat.size();
+        const key_type* keys  = m_keys.data();
+        size_type       k     = 1;
+        while (k <= count) {
+            ATOM_PREFETCH(keys + k * prefetch_stride);
+            k = 2 * k + (size_type)go_right(keys[k]);
+        }
+        // the last left turn is where the answer was, strip the right turns taken after it
+        k >>= std::countr_one(k) + 1;
+        return k ? m_ranks[k] : count;
+    }
+
+    Flat                  m_flat;
+    Compare               m_comp;
+    std::vector<key_type> m_keys;
+    std::vector<uint32_t> m_ranks;
+};
+
+template <typename Flat, typename Compare = typename Flat::key_compare>
+frozen_flat<Flat, Compare> freeze(Flat flat, const Compare& comp = Compare())
+{
+    return frozen_flat<Flat, Compare>(std::move(flat), comp);
+}
+} // namespace atom
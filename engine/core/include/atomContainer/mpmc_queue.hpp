@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <iterator>
+#include <utility>
+
+#include "detail/ring_buffer.hpp"
+
+namespace atom
+{
+// bounded multi-producer multi-consumer queue after Dmitry Vyukov's design: every slot carries a sequence number that
+// tells producers and consumers whose turn it is, so a push or pop is one CAS on its own index plus a release store.
+// capacity is rounded up to a power of two. try_* never block, they fail when the queue is full or empty, including
+// when the slot in front is still being written by a producer that claimed it earlier.
+template <typename T, typename Alloc = std::allocator<T>>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "queued values are moved in and out without rollback");
+
+    struct slot {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using allocator_type = Alloc;
+
+    explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type()) : m_slots{capacity, alloc}
+    {
+        for (size_type i = 0; i < m_slots.capacity(); i++) std::construct_at(&m_slots[i].sequence, i);
+    }
+
+    mpmc_queue(const mpmc_queue&)            = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const size_type end = m_enqueue_position.load(std::memory_order_relaxed);
+            for (size_type i = m_dequeue_position.load(std::memory_order_relaxed); i != end; i++) m_slots[i].value()->~T();
+        }
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        size_type position;
+        if (!claim(m_enqueue_position, 0, 1, position)) return false;
+        publish_push(position, std::forward<Args>(args)...);
+        return true;
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    bool try_pop(T& value)
+    {
+        size_type position;
+        if (!claim(m_dequeue_position, 1, 1, position)) return false;
+        publish_pop(position, value);
+        return true;
+    }
+
+    // pushes the longest prefix of [first, first + count) that fits, with a single CAS, and returns its length
+    template <typename Iter>
+        requires std::input_iterator<Iter>
+    size_type try_push_bulk(Iter first, size_type count)
+    {
+        size_type position;
+        const size_type pushed = claim(m_enqueue_position, 0, count, position);
+        for (size_type i = 0; i < pushed; i++, ++first) publish_push(position + i, *first);
+        return pushed;
+    }
+
+    // pops up to count values into out with a single CAS and returns how many were written
+    template <typename Iter>
+        requires std::output_iterator<Iter, T>
+    size_type try_pop_bulk(Iter out, size_type count)
+    {
+        size_type position;
+        const size_type popped = claim(m_dequeue_position, 1, count, position);
+        for (size_type i = 0; i < popped; i++, ++out) publish_pop(position + i, *out);
+        return popped;
+    }
+
+    // only a hint while other threads are pushing or popping
+    size_type size_approx() const noexcept
+    {
+        const size_type enqueued = m_enqueue_position.load(std::memory_order_relaxed);
+        const size_type dequeued = m_dequeue_position.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    size_type capacity() const noexcept { return m_slots.capacity(); }
+
+private:
+    // claims up to count consecutive slots whose sequence is index + lag, i.e. free slots for producers (lag 0) and
+    // written ones for consumers (lag 1). a slot can only leave that state through the index, so checking before the
+    // CAS is enough.
+    size_type claim(std::atomic<size_type>& index, size_type lag, size_type count, size_type& position)
+    {
+        position = index.load(std::memory_order_relaxed);
+        while (count) {
+            size_type ready = 0;
+            while (ready < count) {
+                const size_type sequence = m_slots[position + ready].sequence.load(std::memory_order_acquire);
+                if (sequence != position + ready + lag) break;
+                ready++;
+            }
+            if (!ready) {
+                // a sequence behind the index means the ring is full (or empty), ahead means another thread won the
+                // slot and the index already moved on
+                const size_type sequence = m_slots[position].sequence.load(std::memory_order_acquire);
+                if ((std::make_signed_t<size_type>)(sequence - (position + lag)) < 0) return 0;
+                position = index.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) return ready;
+        }
+        return 0;
+    }
+
+    template <typename... Args>
+    void publish_push(size_type position, Args&&... args)
+    {
+        slot& target = m_slots[position];
+        ::new (static_cast<void*>(target.storage)) T(std::forward<Args>(args)...);
+        target.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    template <typename Out>
+    void publish_pop(size_type position, Out&& out)
+    {
+        slot& source = m_slots[position];
+        T*    value  = source.value();
+        out          = std::move(*value);
+        value->~T();
+        source.sequence.store(position + m_slots.capacity(), std::memory_order_release);
+    }
+
+    alignas(detail::cache_line_size) detail::ring_buffer_storage<slot, Alloc> m_slots;
+    alignas(detail::cache_line_size) std::atomic<size_type> m_enqueue_position{0};
+    alignas(detail::cache_line_size) std::atomic<size_type> m_dequeue_position{0};
+};
+} // namespace atom
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace atom
+{
+// 32-bit slot index plus 32-bit generation. generations of live slots are odd, so a value initialized handle (and
+// any handle to an erased element) never validates.
+struct slot_map_handle {
+    uint32_t index      = 0;
+    uint32_t generation = 0;
+
+    bool operator==(const slot_map_handle&) const noexcept = default;
+
+    explicit operator bool() const noexcept { return generation != 0; }
+
+    uint64_t packed() const noexcept { return (uint64_t)generation << 32 | index; }
+
+    static slot_map_handle unpack(uint64_t packed) noexcept { return {(uint32_t)packed, (uint32_t)(packed >> 32)}; }
+};
+
+// values live densely in insertion order except that erase moves the last value into the hole, so iteration walks
+// contiguous memory and insert, erase and lookup are O(1). pointers and iterators are invalidated by insert and erase,
+// handles only by erasing their own element.
+template <typename T, typename Alloc = std::allocator<T>>
+class slot_map
+{
+    using rebind_u32 = typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>;
+
+    struct slot {
+        // dense position while live, next free slot while free
+        uint32_t dense_or_next;
+        uint32_t generation;
+    };
+
+    using rebind_slot = typename std::allocator_traits<Alloc>::template rebind_alloc<slot>;
+
+    static constexpr uint32_t free_list_end = ~0u;
+
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using handle_type    = slot_map_handle;
+    using iterator       = typename std::vector<T, Alloc>::iterator;
+    using const_iterator = typename std::vector<T, Alloc>::const_iterator;
+
+    slot_map() = default;
+
+    explicit slot_map(const Alloc& alloc) : m_values(alloc), m_dense_to_slot(alloc), m_slots(alloc) {}
+
+    template <typename... Args>
+    handle_type emplace(Args&&... args)
+    {
+        uint32_t index;
+        if (m_free_head != free_list_end) {
+            index       = m_free_head;
+            m_free_head = m_slots[index].dense_or_next;
+        } else {
+            assert(m_slots.size() < free_list_end && "slot_map ran out of 32-bit indices");
+            index = (uint32_t)m_slots.size();
+            m_slots.push_back({0, 0});
+        }
+        m_values.emplace_back(std::forward<Args>(args)...);
+        m_dense_to_slot.push_back(index);
+
+        slot& target         = m_slots[index];
+        target.dense_or_next = (uint32_t)m_values.size() - 1;
+        target.generation++;
+        return {index, target.generation};
+    }
+
+    handle_type insert(const T& value) { return emplace(value); }
+
+    handle_type insert(T&& value) { return emplace(std::move(value)); }
+
+    bool erase(handle_type handle)
+    {
+        if (!contains(handle)) return false;
+        slot&          target = m_slots[handle.index];
+        const uint32_t dense  = target.dense_or_next;
+        const uint32_t last   = (uint32_t)m_values.size() - 1;
+        if (dense != last) {
+            m_values[dense]                               = std::move(m_values[last]);
+            m_dense_to_slot[dense]                        = m_dense_to_slot[last];
+            m_slots[m_dense_to_slot[dense]].dense_or_next = dense;
+        }
+        m_values.pop_back();
+        m_dense_to_slot.pop_back();
+
+        // even until reused, and slots that wrapped their generation are retired rather than risking a stale match
+        target.generation++;
+        if (target.generation != ~0u - 1) {
+            target.dense_or_next = m_free_head;
+            m_free_head          = handle.index;
+        }
+        return true;
+    }
+
+    // erases the value at a dense position, e.g. while iterating; the last value moves into it
+    iterator erase(const_iterator position)
+    {
+        const size_type dense = (size_type)(position - m_values.cbegin());
+        erase(handle_at(dense));
+        return m_values.begin() + dense;
+    }
+
+    bool contains(handle_type handle) const noexcept
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+               && (handle.generation & 1);
+    }
+
+    T* get(handle_type handle) noexcept
+    {
+        return contains(handle) ? &m_values[m_slots[handle.index].dense_or_next] : nullptr;
+    }
+
+    const T* get(handle_type handle) const noexcept
+    {
+        return contains(handle) ? &m_values[m_slots[handle.index].dense_or_next] : nullptr;
+    }
+
+    T& operator[](handle_type handle) noexcept
+    {
+        assert(contains(handle) && "stale or foreign slot_map handle");
+        return m_values[m_slots[handle.index].dense_or_next];
+    }
+
+    const T& operator[](handle_type handle) const noexcept
+    {
+        assert(contains(handle) && "stale or foreign slot_map handle");
+        return m_values[m_slots[handle.index].dense_or_next];
+    }
+
+    // the handle of the value at a dense position, to go from iteration back to handles
+    handle_type handle_at(size_type dense) const noexcept
+    {
+        const uint32_t index = m_dense_to_slot[dense];
+        return {index, m_slots[index].generation};
+    }
+
+    handle_type handle_of(const_iterator position) const noexcept
+    {
+        return handle_at((size_type)(position - m_values.cbegin()));
+    }
+
+    void reserve(size_type count)
+    {
+        m_values.reserve(count);
+        m_dense_to_slot.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    // invalidates every handle, slots keep their generations so old handles stay detectable
+    void clear() noexcept
+    {
+        for (uint32_t index : m_dense_to_slot) {
+            slot& target = m_slots[index];
+            target.generation++;
+            if (target.generation == ~0u - 1) continue;
+            target.dense_or_next = m_free_head;
+            m_free_head          = index;
+        }
+        m_values.clear();
+        m_dense_to_slot.clear();
+    }
+
+    size_type size() const noexcept { return m_values.size(); }
+
+    bool empty() const noexcept { return m_values.empty(); }
+
+    T*       data() noexcept { return m_values.data(); }
+    const T* data() const noexcept { return m_values.data(); }
+
+    iterator       begin() noexcept { return m_values.begin(); }
+    const_iterator begin() const noexcept { return m_values.begin(); }
+    const_iterator cbegin() const noexcept { return m_values.cbegin(); }
+    iterator       end() noexcept { return m_values.end(); }
+    const_iterator end() const noexcept { return m_values.end(); }
+    const_iterator cend() const noexcept { return m_values.cend(); }
+
+private:
+    std::vector<T, Alloc>             m_values;
+    std::vector<uint32_t, rebind_u32> m_dense_to_slot;
+    std::vector<slot, rebind_slot>    m_slots;
+    uint32_t                          m_free_head = free_list_end;
+};
+} // namespace atom
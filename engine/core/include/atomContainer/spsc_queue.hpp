@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <utility>
+
+#include "detail/ring_buffer.hpp"
+
+namespace atom
+{
+// bounded single-producer single-consumer ring, wait-free on both ends. each side keeps a cached copy of the other
+// side's index and only reloads it when the cache says full or empty, so the shared cache lines are touched once per
+// wrap instead of once per value. capacity is rounded up to a power of two.
+template <typename T, typename Alloc = std::allocator<T>>
+class spsc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "queued values are moved in and out without rollback");
+
+    struct slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using allocator_type = Alloc;
+
+    explicit spsc_queue(size_type capacity, const allocator_type& alloc = allocator_type()) : m_slots{capacity, alloc} {}
+
+    spsc_queue(const spsc_queue&)            = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const size_type end = m_tail.load(std::memory_order_relaxed);
+            for (size_type i = m_head.load(std::memory_order_relaxed); i != end; i++) m_slots[i].value()->~T();
+        }
+    }
+
+    // producer side
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (!writable(tail, 1)) return false;
+        ::new (static_cast<void*>(m_slots[tail].storage)) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // pushes the longest prefix of [first, first + count) that fits and publishes it with one store
+    template <typename Iter>
+        requires std::input_iterator<Iter>
+    size_type try_push_bulk(Iter first, size_type count)
+    {
+        const size_type tail   = m_tail.load(std::memory_order_relaxed);
+        const size_type pushed = writable(tail, count);
+        for (size_type i = 0; i < pushed; i++, ++first) ::new (static_cast<void*>(m_slots[tail + i].storage)) T(*first);
+        if (pushed) m_tail.store(tail + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    // consumer side
+
+    bool try_pop(T& value) { return try_pop_bulk(&value, 1) == 1; }
+
+    // pops up to count values into out and releases their slots with one store
+    template <typename Iter>
+        requires std::output_iterator<Iter, T>
+    size_type try_pop_bulk(Iter out, size_type count)
+    {
+        const size_type head   = m_head.load(std::memory_order_relaxed);
+        const size_type popped = readable(head, count);
+        for (size_type i = 0; i < popped; i++, ++out) {
+            T* value = m_slots[head + i].value();
+            *out     = std::move(*value);
+            value->~T();
+        }
+        if (popped) m_head.store(head + popped, std::memory_order_release);
+        return popped;
+    }
+
+    // exact from either end as far as that end is concerned, a hint for anyone else
+    size_type size_approx() const noexcept
+    {
+        // head first, it never passes the tail that is read after it
+        const size_type head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    size_type capacity() const noexcept { return m_slots.capacity(); }
+
+private:
+    size_type writable(size_type tail, size_type count) noexcept
+    {
+        const size_type capacity = m_slots.capacity();
+        if (tail + count - m_cached_head > capacity) m_cached_head = m_head.load(std::memory_order_acquire);
+        return std::min(count, capacity - (tail - m_cached_head));
+    }
+
+    size_type readable(size_type head, size_type count) noexcept
+    {
+        if (m_cached_tail - head < count) m_cached_tail = m_tail.load(std::memory_order_acquire);
+        return std::min(count, m_cached_tail - head);
+    }
+
+    alignas(detail::cache_line_size) detail::ring_buffer_storage<slot, Alloc> m_slots;
+    // written by the producer
+    alignas(detail::cache_line_size) std::atomic<size_type> m_tail{0};
+    size_type m_cached_head = 0;
+    // written by the consumer
+    alignas(detail::cache_line_size) std::atomic<size_type> m_head{0};
+    size_type m_cached_tail = 0;
+};
+} // namespace atom
@@ -5,4 +5,5 @@
 
 #ifdef __cplusplus
 #include "base/hash.hpp"
+#include "base/guid.hpp"
 #endif
\ No newline at end of file
@@ -6,4 +6,25 @@ typedef struct {
     uint8_t value[16];
 } atom_guid_t;
 
-ATOM_EXTERN_C ATOM_API void atom_make_guid(atom_guid_t* guid);
\ No newline at end of file
+// guids are generated from a per-thread generator that is seeded once from the os csprng,
+// so minting them never goes through a system call after the first guid on a thread.
+typedef enum eAtomGuidMode {
+    // RFC 9562 version 4, fully random
+    ATOM_GUID_MODE_RANDOM,
+    // RFC 9562 version 7, unix milliseconds in the leading bytes followed by a per-thread counter and random bits.
+    // guids compare (bytewise) in roughly creation order, so ordered containers keyed by them insert near the end.
+    ATOM_GUID_MODE_TIME_ORDERED,
+    ATOM_GUID_MODE_COUNT
+} eAtomGuidMode;
+
+// mode used by atom_make_guid / atom_make_guids, random by default
+ATOM_EXTERN_C ATOM_API void          atom_set_guid_mode(eAtomGuidMode mode);
+ATOM_EXTERN_C ATOM_API eAtomGuidMode atom_get_guid_mode();
+
+ATOM_EXTERN_C ATOM_API void atom_make_guid(atom_guid_t* guid);
+ATOM_EXTERN_C ATOM_API void atom_make_guids(atom_guid_t* guids, size_t count);
+ATOM_EXTERN_C ATOM_API void atom_make_guids_with_mode(atom_guid_t* guids, size_t count, eAtomGuidMode mode);
+
+// bytewise comparison, the order of time ordered guids follows their creation time
+ATOM_EXTERN_C ATOM_API int  atom_guid_compare(const atom_guid_t* lhs, const atom_guid_t* rhs);
+ATOM_EXTERN_C ATOM_API bool atom_guid_equal(const atom_guid_t* lhs, const atom_guid_t* rhs);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+
+#include "guid.h"
+
+inline bool operator==(const atom_guid_t& lhs, const atom_guid_t& rhs) { return atom_guid_equal(&lhs, &rhs); }
+
+inline bool operator!=(const atom_guid_t& lhs, const atom_guid_t& rhs) { return !atom_guid_equal(&lhs, &rhs); }
+
+inline bool operator<(const atom_guid_t& lhs, const atom_guid_t& rhs) { return atom_guid_compare(&lhs, &rhs) < 0; }
+
+namespace std
+{
+// the trailing bytes are random for every guid mode, while v7 guids share their leading timestamp bytes
+template <>
+struct hash<atom_guid_t> {
+    size_t operator()(const atom_guid_t& val) const
+    {
+        uint64_t tail;
+        memcpy(&tail, val.value + 8, sizeof(tail));
+        return (size_t)tail;
+    }
+};
+} // namespace std
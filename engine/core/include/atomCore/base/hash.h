@@ -2,9 +2,33 @@
 
 #include <atomCore/config.h>
 
-// #define atom_hash128_t XXH128_hash_t
+// the streaming state is exposed so that it can live on the stack
+#ifndef XXH_STATIC_LINKING_ONLY
+#define XXH_STATIC_LINKING_ONLY
+#endif
+#include <xxhash.h>
+
+typedef XXH128_hash_t atom_hash128_t;
+// incremental XXH3 state, 64 byte aligned, one state yields both the 64 and the 128 bit digest
+typedef XXH3_state_t  atom_hash_state_t;
 
 ATOM_EXTERN_C ATOM_API size_t   atom_hash(const void* input, size_t length, size_t seed);
 ATOM_EXTERN_C ATOM_API uint32_t atom_hash_32(const void* input, size_t length, uint32_t seed);
 ATOM_EXTERN_C ATOM_API uint64_t atom_hash_64_without_seed(const void* input, size_t length);
-ATOM_EXTERN_C ATOM_API uint64_t atom_hash_64(const void* input, size_t length, uint64_t seed);
\ No newline at end of file
+ATOM_EXTERN_C ATOM_API uint64_t atom_hash_64(const void* input, size_t length, uint64_t seed);
+
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128_without_seed(const void* input, size_t length);
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128(const void* input, size_t length, uint64_t seed);
+ATOM_EXTERN_C ATOM_API bool           atom_hash_128_equal(atom_hash128_t lhs, atom_hash128_t rhs);
+
+ATOM_EXTERN_C ATOM_API void           atom_hash_state_init(atom_hash_state_t* state, uint64_t seed);
+ATOM_EXTERN_C ATOM_API void           atom_hash_state_update(atom_hash_state_t* state, const void* input, size_t length);
+ATOM_EXTERN_C ATOM_API uint64_t       atom_hash_state_digest_64(const atom_hash_state_t* state);
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_state_digest_128(const atom_hash_state_t* state);
+
+// hashes count independent inputs at once, out[i] equals atom_hash_64(inputs[i], lengths[i], seed).
+// inputs up to 16 bytes (names, small keys) take an inlined xxh3 path, longer ones go through atom_hash_64
+ATOM_EXTERN_C ATOM_API void atom_hash_batch(
+    const void* const* inputs, const size_t* lengths, uint32_t count, uint64_t seed, uint64_t* out);
+// same as atom_hash_batch for null-terminated strings
+ATOM_EXTERN_C ATOM_API void atom_hash_batch_strings(const char* const* strings, uint32_t count, uint64_t seed, uint64_t* out);
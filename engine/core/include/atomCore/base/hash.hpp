@@ -2,10 +2,52 @@
 
 #include <cstddef>
 #include <functional>
+#include <type_traits>
+
+#include "hash.h"
 
 template <typename T, typename... Rest>
 void hash_combine(size_t& seed, const T& v, const Rest&... rest)
 {
     seed ^= std::hash<T>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     (hash_combine(seed, rest), ...);
-}
\ No newline at end of file
+}
+
+inline bool operator==(const atom_hash128_t& lhs, const atom_hash128_t& rhs) { return atom_hash_128_equal(lhs, rhs); }
+
+inline bool operator!=(const atom_hash128_t& lhs, const atom_hash128_t& rhs) { return !atom_hash_128_equal(lhs, rhs); }
+
+namespace std
+{
+// the digest is already uniformly distributed, so hash containers keyed by it only need to fold it
+template <>
+struct hash<atom_hash128_t> {
+    size_t operator()(const atom_hash128_t& val) const { return (size_t)(val.low64 ^ val.high64); }
+};
+} // namespace std
+
+// streaming XXH3 over the pieces of a cache key, objects are fed byte-wise so padding must be zeroed
+class AtomHasher
+{
+public:
+    explicit AtomHasher(uint64_t seed = 0) ATOM_NOEXCEPT { atom_hash_state_init(&state, seed); }
+
+    AtomHasher& update(const void* input, size_t length) ATOM_NOEXCEPT
+    {
+        atom_hash_state_update(&state, input, length);
+        return *this;
+    }
+
+    template <typename T>
+    AtomHasher& update(const T& object) ATOM_NOEXCEPT
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable objects can be hashed byte-wise!");
+        return update(&object, sizeof(T));
+    }
+
+    uint64_t       digest_64() const ATOM_NOEXCEPT { return atom_hash_state_digest_64(&state); }
+    atom_hash128_t digest_128() const ATOM_NOEXCEPT { return atom_hash_state_digest_128(&state); }
+
+private:
+    atom_hash_state_t state;
+};
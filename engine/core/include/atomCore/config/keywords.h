@@ -3,6 +3,7 @@
 // unused
 // alignas
 // assume
+// prefetch
 // enable/disable optimization
 // inline
 // forceinline
@@ -53,6 +54,19 @@
 #endif
 #endif
 
+// PREFETCH
+// a read hint only, the address does not have to be valid
+#ifndef ATOM_PREFETCH
+#if defined(__GNUC__) || defined(__clang__)
+#define ATOM_PREFETCH(ptr) __builtin_prefetch(ptr)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define ATOM_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#define ATOM_PREFETCH(ptr)
+#endif
+#endif
+
 // OPTIMIZATION
 #if defined(_MSC_VER)
 #define ATOM_DISABLE_OPTIMIZATION __pragma(optimize("", off))
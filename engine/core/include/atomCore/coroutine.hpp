@@ -0,0 +1,221 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "job.h"
+
+// coroutine tasks
+// atom::task<T> is lazy: it starts when it is awaited and resumes its awaiter through symmetric transfer once it
+// returns. tasks run on whatever thread resumed them last, co_await atom::resume_on_job_system() moves the rest of
+// the coroutine onto a job worker. the engine builds without exceptions, escaping ones terminate.
+
+namespace atom
+{
+template <typename T = void>
+class task;
+
+namespace detail
+{
+inline void resume_coroutine_job(void* address) { std::coroutine_handle<>::from_address(address).resume(); }
+
+struct task_promise_base {
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            return handle.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+};
+
+template <typename T>
+struct task_promise : task_promise_base {
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+    {
+        value.emplace(std::forward<U>(result));
+    }
+
+    std::optional<T> value;
+};
+
+template <>
+struct task_promise<void> : task_promise_base {
+    task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+};
+
+// fire and forget coroutine that frees itself when it finishes
+struct detached_task {
+    struct promise_type {
+        detached_task get_return_object() const noexcept { return {}; }
+
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+} // namespace detail
+
+template <typename T>
+class task
+{
+public:
+    using promise_type = detail::task_promise<T>;
+    using handle_type  = std::coroutine_handle<promise_type>;
+
+    task() noexcept = default;
+
+    explicit task(handle_type handle) noexcept : handle(handle) {}
+
+    task(task&& other) noexcept : handle(std::exchange(other.handle, ATOM_NULLPTR)) {}
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, ATOM_NULLPTR);
+        }
+        return *this;
+    }
+
+    task(const task&)            = delete;
+    task& operator=(const task&) = delete;
+
+    ~task()
+    {
+        if (handle) handle.destroy();
+    }
+
+    bool valid() const noexcept { return (bool)handle; }
+
+    bool done() const noexcept { return !handle || handle.done(); }
+
+    auto operator co_await() & noexcept { return awaiter<false>{handle}; }
+
+    auto operator co_await() && noexcept { return awaiter<true>{handle}; }
+
+private:
+    template <bool Move>
+    struct awaiter {
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+
+        decltype(auto) await_resume() noexcept
+        {
+            if constexpr (std::is_void_v<T>) {
+                return;
+            } else if constexpr (Move) {
+                return T(std::move(*handle.promise().value));
+            } else {
+                return static_cast<T&>(*handle.promise().value);
+            }
+        }
+
+        handle_type handle;
+    };
+
+    handle_type handle = ATOM_NULLPTR;
+};
+
+namespace detail
+{
+template <typename T>
+inline task<T> task_promise<T>::get_return_object() noexcept
+{
+    return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+    return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+template <typename T>
+inline detached_task run_detached(task<T> work, atom_job_counter_t* counter)
+{
+    co_await std::move(work);
+    if (counter) atom_job_counter_done(counter);
+}
+} // namespace detail
+
+// suspends the coroutine and resumes it from a job, affinity and pinned behave like atom_job_decl_t.
+// continues inline when the job system is not initialized.
+struct job_system_awaiter {
+    bool await_ready() const noexcept { return !atom_job_system_is_initialized(); }
+
+    void await_suspend(std::coroutine_handle<> handle) const noexcept
+    {
+        const atom_job_decl_t decl = {&detail::resume_coroutine_job, handle.address(), affinity, pinned};
+        atom_job_run(&decl, 1, ATOM_NULLPTR);
+    }
+
+    void await_resume() const noexcept {}
+
+    uint32_t affinity = ATOM_JOB_AFFINITY_ANY;
+    bool     pinned   = false;
+};
+
+inline job_system_awaiter resume_on_job_system(uint32_t affinity = ATOM_JOB_AFFINITY_ANY, bool pinned = false) noexcept
+{
+    return job_system_awaiter{affinity, pinned};
+}
+
+// starts the task right away on the calling thread and lets it run to completion on its own.
+// counter is optional and stays raised by one until the task returned.
+template <typename T>
+inline void spawn(task<T> work, atom_job_counter_t* counter = ATOM_NULLPTR)
+{
+    if (counter) atom_job_counter_add(counter, 1);
+    detail::run_detached(std::move(work), counter);
+}
+
+// runs the task and blocks until it returned, the calling thread executes other jobs in the meantime
+template <typename T>
+inline T sync_wait(task<T> work)
+{
+    atom_job_counter_t* counter = atom_create_job_counter();
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+    auto wrapper = [](task<T>& work, decltype(result)& result, atom_job_counter_t* counter) -> detail::detached_task {
+        if constexpr (std::is_void_v<T>) {
+            co_await work;
+        } else {
+            result.emplace(co_await std::move(work));
+        }
+        atom_job_counter_done(counter);
+    };
+    atom_job_counter_add(counter, 1);
+    wrapper(work, result, counter);
+    atom_job_wait(counter);
+    atom_free_job_counter(counter);
+    if constexpr (!std::is_void_v<T>) return std::move(*result);
+}
+} // namespace atom
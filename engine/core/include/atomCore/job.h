@@ -0,0 +1,83 @@
+#pragma once
+
+#include "config.h"
+
+// job system
+// a fixed set of worker threads runs small jobs. every worker owns a Chase-Lev deque: it pushes and pops the jobs it
+// spawns at the bottom, while idle workers steal from the top of the others. jobs submitted from threads that are not
+// workers go through a shared queue. the thread calling atom_job_system_initialize() becomes worker 0 and only runs
+// jobs while it waits in atom_job_wait(). when the system is not initialized, jobs run inline on the submitting thread.
+
+#define ATOM_JOB_AFFINITY_ANY UINT32_MAX
+
+typedef void (*atom_job_func_t)(void* user_data);
+typedef void (*atom_job_range_func_t)(uint32_t begin, uint32_t end, void* user_data);
+
+typedef struct atom_job_system_desc_t {
+    // worker threads besides the calling thread, 0 picks one per remaining hardware thread
+    uint32_t worker_count;
+    // bind worker thread i to logical core i, leaving core 0 to the calling thread
+    bool     pin_threads;
+} atom_job_system_desc_t;
+
+typedef struct atom_job_decl_t {
+    atom_job_func_t function;
+    void*           user_data;
+    // worker index the job should run on, ATOM_JOB_AFFINITY_ANY lets it run anywhere
+    uint32_t        affinity;
+    // by default affinity is a hint and idle workers still take the job as a last resort,
+    // pinned jobs only ever run on their affinity worker (e.g. 0 for main thread work)
+    bool            pinned;
+} atom_job_decl_t;
+
+// counts unfinished jobs, jobs submitted with a counter increment it and decrement it once they returned.
+// counters must outlive every job that references them and are not to be freed while someone waits on them.
+typedef struct atom_job_counter_t atom_job_counter_t;
+
+ATOM_EXTERN_C ATOM_API bool     atom_job_system_initialize(const atom_job_system_desc_t* desc);
+// waits for the workers to finish their current job, jobs still queued are dropped
+ATOM_EXTERN_C ATOM_API void     atom_job_system_finalize();
+ATOM_EXTERN_C ATOM_API bool     atom_job_system_is_initialized();
+// includes the initializing thread, 1 when the system is not initialized
+ATOM_EXTERN_C ATOM_API uint32_t atom_job_worker_count();
+// index of the calling worker, ATOM_JOB_AFFINITY_ANY for threads that are not workers
+ATOM_EXTERN_C ATOM_API uint32_t atom_job_current_worker();
+
+ATOM_EXTERN_C ATOM_API atom_job_counter_t* atom_create_job_counter();
+ATOM_EXTERN_C ATOM_API void                atom_free_job_counter(atom_job_counter_t* counter);
+ATOM_EXTERN_C ATOM_API uint32_t            atom_job_counter_value(const atom_job_counter_t* counter);
+// accounts work that does not run as a job (e.g. a coroutine or gpu work), every add has to be matched by done calls
+ATOM_EXTERN_C ATOM_API void                atom_job_counter_add(atom_job_counter_t* counter, uint32_t count);
+ATOM_EXTERN_C ATOM_API void                atom_job_counter_done(atom_job_counter_t* counter);
+
+// counter is optional
+ATOM_EXTERN_C ATOM_API void atom_job_run(const atom_job_decl_t* jobs, uint32_t count, atom_job_counter_t* counter);
+// the jobs are held back until dependency drops to zero, counter is incremented right away
+ATOM_EXTERN_C ATOM_API void atom_job_run_after(atom_job_counter_t*    dependency,
+                                               const atom_job_decl_t* jobs,
+                                               uint32_t               count,
+                                               atom_job_counter_t*    counter);
+// runs other jobs on the calling thread until the counter drops to zero
+ATOM_EXTERN_C ATOM_API void atom_job_wait(atom_job_counter_t* counter);
+
+// splits [0, count) into ranges of batch_size (0 picks one from the worker count) and waits for all of them
+ATOM_EXTERN_C ATOM_API void atom_job_parallel_for(uint32_t              count,
+                                                  uint32_t              batch_size,
+                                                  atom_job_range_func_t function,
+                                                  void*                 user_data);
+
+#ifdef __cplusplus
+#include <type_traits>
+
+// body is invoked as body(begin, end) for every range
+template <typename F>
+void atom_parallel_for(uint32_t count, uint32_t batch_size, F&& body)
+{
+    using Body = std::remove_reference_t<F>;
+    atom_job_parallel_for(
+        count,
+        batch_size,
+        [](uint32_t begin, uint32_t end, void* user_data) { (*static_cast<Body*>(user_data))(begin, end); },
+        const_cast<void*>(static_cast<const void*>(&body)));
+}
+#endif
@@ -6,10 +6,60 @@
 #include "log/manager.hpp"
 #endif
 
+// statements below this level are removed by the preprocessor, values follow eLogLevel (6 strips everything)
+#ifndef ATOM_LOG_ACTIVE_LEVEL
+#define ATOM_LOG_ACTIVE_LEVEL 0
+#endif
+
+// category used by ATOM_trace ... ATOM_fatal, defined per target or before including this header
+#ifndef ATOM_LOG_CATEGORY
+#define ATOM_LOG_CATEGORY ATOM_LOG_CATEGORY_CORE
+#endif
+
+#define ATOM_LOG_SITE(category, level, ...)                                                             \
+    do {                                                                                                \
+        static atom_log_site_t atom_log_site_ = {(level), (category), __LINE__, __FILE__, __func__, 0}; \
+        atom_log_log_site(&atom_log_site_, __VA_ARGS__);                                                \
+    } while (0)
+#define ATOM_LOG_STRIPPED() \
+    do {                    \
+    } while (0)
+
+#if ATOM_LOG_ACTIVE_LEVEL <= 0
+#define ATOM_trace_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define ATOM_trace_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+#if ATOM_LOG_ACTIVE_LEVEL <= 1
+#define ATOM_debug_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define ATOM_debug_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+#if ATOM_LOG_ACTIVE_LEVEL <= 2
+#define ATOM_info_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define ATOM_info_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+#if ATOM_LOG_ACTIVE_LEVEL <= 3
+#define ATOM_warn_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define ATOM_warn_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+#if ATOM_LOG_ACTIVE_LEVEL <= 4
+#define ATOM_error_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define ATOM_error_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+#if ATOM_LOG_ACTIVE_LEVEL <= 5
+#define ATOM_fatal_in(category, ...) ATOM_LOG_SITE(category, ATOM_LOG_LEVEL_FATAL, __VA_ARGS__)
+#else
+#define ATOM_fatal_in(category, ...) ATOM_LOG_STRIPPED()
+#endif
+
 // #define ATOM_backtrace(...) atom_log_backtrace(__VA_ARGS__)
-#define ATOM_trace(...) atom_log_log(ATOM_LOG_LEVEL_TRACE, __VA_ARGS__)
-#define ATOM_debug(...) atom_log_log(ATOM_LOG_LEVEL_DEBUG, __VA_ARGS__)
-#define ATOM_info(...)  atom_log_log(ATOM_LOG_LEVEL_INFO, __VA_ARGS__)
-#define ATOM_warn(...)  atom_log_log(ATOM_LOG_LEVEL_WARN, __VA_ARGS__)
-#define ATOM_error(...) atom_log_log(ATOM_LOG_LEVEL_ERROR, __VA_ARGS__)
-#define ATOM_fatal(...) atom_log_log(ATOM_LOG_LEVEL_FATAL, __VA_ARGS__)
\ No newline at end of file
+#define ATOM_trace(...) ATOM_trace_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
+#define ATOM_debug(...) ATOM_debug_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
+#define ATOM_info(...)  ATOM_info_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
+#define ATOM_warn(...)  ATOM_warn_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
+#define ATOM_error(...) ATOM_error_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
+#define ATOM_fatal(...) ATOM_fatal_in(ATOM_LOG_CATEGORY, __VA_ARGS__)
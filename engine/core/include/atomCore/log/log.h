@@ -8,9 +8,56 @@ enum eLogLevel {
     ATOM_LOG_LEVEL_INFO,
     ATOM_LOG_LEVEL_WARN,
     ATOM_LOG_LEVEL_ERROR,
-    ATOM_LOG_LEVEL_FATAL
+    ATOM_LOG_LEVEL_FATAL,
+    ATOM_LOG_LEVEL_OFF
 };
 
-ATOM_EXTERN_C ATOM_API void atom_log_set_level(enum eLogLevel level);
-ATOM_EXTERN_C ATOM_API void atom_log_flush();
-ATOM_EXTERN_C ATOM_API void atom_log_log(int level, ...);
\ No newline at end of file
+// every category has its own runtime threshold, checked before anything else on a log call
+enum eLogCategory {
+    ATOM_LOG_CATEGORY_CORE,
+    ATOM_LOG_CATEGORY_MEMORY,
+    ATOM_LOG_CATEGORY_GRAPHICS,
+    // messages reported by the vulkan validation layers
+    ATOM_LOG_CATEGORY_VULKAN_VALIDATION,
+    ATOM_LOG_CATEGORY_COUNT
+};
+
+enum eLogMode {
+    // format on the calling thread and hand the message to spdlog
+    ATOM_LOG_MODE_IMMEDIATE,
+    // the calling thread copies the site id and raw arguments into a per-thread ring,
+    // a background thread formats them and feeds the spdlog sinks
+    ATOM_LOG_MODE_DEFERRED,
+    // like deferred, but the background thread appends the raw records to a binary file
+    // which can be expanded later with atom_log_decode_binary()
+    ATOM_LOG_MODE_BINARY_FILE
+};
+
+// static per call site data, created by the ATOM_* log macros. the format must be a string literal,
+// it is parsed once when the site is first hit and referenced by id afterwards.
+typedef struct atom_log_site_t {
+    int         level;
+    int         category;
+    int         line;
+    const char* file;
+    const char* function;
+    // assigned on first use, 0 means unregistered
+    uint32_t    id;
+} atom_log_site_t;
+
+// sets the threshold of every category
+ATOM_EXTERN_C ATOM_API void           atom_log_set_level(enum eLogLevel level);
+ATOM_EXTERN_C ATOM_API void           atom_log_set_category_level(enum eLogCategory category, enum eLogLevel level);
+ATOM_EXTERN_C ATOM_API enum eLogLevel atom_log_get_category_level(enum eLogCategory category);
+ATOM_EXTERN_C ATOM_API const char*    atom_log_category_name(enum eLogCategory category);
+ATOM_EXTERN_C ATOM_API void           atom_log_flush();
+ATOM_EXTERN_C ATOM_API void           atom_log_log(int level, ...);
+ATOM_EXTERN_C ATOM_API void           atom_log_log_site(atom_log_site_t* site, ...);
+
+// binary_path is only used by ATOM_LOG_MODE_BINARY_FILE, returns false if the file cannot be opened
+ATOM_EXTERN_C ATOM_API bool          atom_log_set_mode(enum eLogMode mode, const char* binary_path);
+ATOM_EXTERN_C ATOM_API enum eLogMode atom_log_get_mode();
+// records dropped because a thread's ring was full
+ATOM_EXTERN_C ATOM_API uint64_t      atom_log_dropped_count();
+// expands a file written in ATOM_LOG_MODE_BINARY_FILE into text, one line per record
+ATOM_EXTERN_C ATOM_API bool          atom_log_decode_binary(const char* binary_path, const char* text_path);
@@ -1,34 +1,142 @@
 #pragma once
 
-#include <crtdbg.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "config.h"
 
-// TODO: try to make this cross-platform
+// allocator backend
+// all atom_* allocation macros dispatch through the active backend, which is resolved once on the first allocation:
+// either selected explicitly by atom_initialize_allocator() before any allocation happens, or picked from the
+// ATOM_ALLOCATOR environment variable ("system" / "thread_cached"), falling back to the system backend.
+// memory must always be released through the same backend that allocated it, so the backend cannot change afterwards.
 
-ATOM_FORCEINLINE static void* _aligned_calloc(size_t nelem, size_t elsize, size_t alignment)
-{
-    void* memory = _aligned_malloc(nelem * elsize, alignment);
-    if (memory != NULL) memset(memory, 0, nelem * elsize);
-    return memory;
-}
+typedef enum eAtomAllocatorBackend {
+    // CRT heap, _aligned_* on windows and posix_memalign elsewhere
+    ATOM_ALLOCATOR_BACKEND_SYSTEM,
+    // size-class spans with per-thread free-list caches, large blocks fall back to the system heap
+    ATOM_ALLOCATOR_BACKEND_THREAD_CACHED,
+    // user supplied atom_allocator_t
+    ATOM_ALLOCATOR_BACKEND_CUSTOM,
+    ATOM_ALLOCATOR_BACKEND_COUNT
+} eAtomAllocatorBackend;
+
+typedef struct atom_allocator_t {
+    const char* name;
+    void* (*malloc_fn)(size_t size);
+    void* (*calloc_fn)(size_t count, size_t size);
+    void* (*realloc_fn)(void* ptr, size_t size);
+    void (*free_fn)(void* ptr);
+    void* (*malloc_aligned_fn)(size_t size, size_t alignment);
+    void* (*calloc_aligned_fn)(size_t count, size_t size, size_t alignment);
+    void* (*realloc_aligned_fn)(void* ptr, size_t size, size_t alignment);
+    void (*free_aligned_fn)(void* ptr);
+} atom_allocator_t;
+
+// select a builtin backend, or a custom one when backend == ATOM_ALLOCATOR_BACKEND_CUSTOM
+// returns false if an allocation already went through another backend
+ATOM_EXTERN_C ATOM_API bool atom_initialize_allocator(eAtomAllocatorBackend backend, const atom_allocator_t* custom);
+ATOM_EXTERN_C ATOM_API const atom_allocator_t* atom_get_allocator();
+ATOM_EXTERN_C ATOM_API eAtomAllocatorBackend   atom_get_allocator_backend();
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_impl(size_t size);
+ATOM_EXTERN_C ATOM_API void* atom_calloc_impl(size_t count, size_t size);
+ATOM_EXTERN_C ATOM_API void* atom_realloc_impl(void* ptr, size_t size);
+ATOM_EXTERN_C ATOM_API void  atom_free_impl(void* ptr);
+ATOM_EXTERN_C ATOM_API void* atom_malloc_aligned_impl(size_t size, size_t alignment);
+ATOM_EXTERN_C ATOM_API void* atom_calloc_aligned_impl(size_t count, size_t size, size_t alignment);
+ATOM_EXTERN_C ATOM_API void* atom_realloc_aligned_impl(void* ptr, size_t size, size_t alignment);
+ATOM_EXTERN_C ATOM_API void  atom_free_aligned_impl(void* ptr);
+
+// tagged allocation
+// the *N variants take a static tag string (e.g. "AGPU::vk_pso") and account the block to it.
+// tagged blocks carry a small header and must be released with atom_freeN / atom_free_alignedN.
+typedef struct atom_memory_tag_stats_t {
+    const char* name;
+    int64_t     live_bytes;
+    // highest live_bytes seen, each thread's batched bytes are measured against the flushed total of the tag
+    int64_t     peak_bytes;
+    uint64_t    total_bytes;
+    uint64_t    allocation_count;
+    uint64_t    live_allocation_count;
+} atom_memory_tag_stats_t;
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_tagged(size_t size, const char* tag);
+ATOM_EXTERN_C ATOM_API void* atom_calloc_tagged(size_t count, size_t size, const char* tag);
+ATOM_EXTERN_C ATOM_API void* atom_realloc_tagged(void* ptr, size_t size, const char* tag);
+ATOM_EXTERN_C ATOM_API void* atom_malloc_aligned_tagged(size_t size, size_t alignment, const char* tag);
+ATOM_EXTERN_C ATOM_API void* atom_calloc_aligned_tagged(size_t count, size_t size, size_t alignment, const char* tag);
+ATOM_EXTERN_C ATOM_API void* atom_realloc_aligned_tagged(void* ptr, size_t size, size_t alignment, const char* tag);
+ATOM_EXTERN_C ATOM_API void  atom_free_tagged(void* ptr);
+
+// account memory that is not allocated through atom_* (e.g. driver internal allocations)
+ATOM_EXTERN_C ATOM_API void atom_memory_tag_add(const char* tag, size_t size);
+ATOM_EXTERN_C ATOM_API void atom_memory_tag_remove(const char* tag, size_t size);
+
+// counters are kept in per-thread shards, so queries are a consistent-enough snapshot rather than exact
+ATOM_EXTERN_C ATOM_API uint32_t atom_memory_tag_count();
+ATOM_EXTERN_C ATOM_API bool     atom_memory_query_tag(const char* tag, atom_memory_tag_stats_t* stats);
+ATOM_EXTERN_C ATOM_API uint32_t atom_memory_query_tags(atom_memory_tag_stats_t* stats, uint32_t capacity);
+// writes a human readable table into buffer, returns the length of the full report like snprintf
+ATOM_EXTERN_C ATOM_API size_t   atom_memory_report_tags(char* buffer, size_t capacity);
+ATOM_EXTERN_C ATOM_API void     atom_memory_dump_tags();
+
+// frame arena
+// bump allocator for transient data, every thread owns one arena per frame in flight.
+// atom_frame_arena_begin_frame() advances the global frame index, agpu does so on every present (see
+// agpu_device_begin_frame); when a thread touches a slot again, the slot is rewound only if the frame it served last
+// has been reported complete by atom_frame_arena_retire() (e.g. on fence completion). frames are expected to retire in
+// order; every frame below atom_frame_arena_retired_frames() is done.
+// call-scoped scratch can be handed back early with mark/rewind.
+#define ATOM_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT 4
+
+typedef struct atom_frame_arena_marker_t {
+    uint64_t frame;
+    void*    chunk;
+    size_t   offset;
+} atom_frame_arena_marker_t;
+
+ATOM_EXTERN_C ATOM_API void                      atom_frame_arena_set_frames_in_flight(uint32_t count);
+ATOM_EXTERN_C ATOM_API uint32_t                  atom_frame_arena_get_frames_in_flight();
+ATOM_EXTERN_C ATOM_API uint64_t                  atom_frame_arena_begin_frame();
+ATOM_EXTERN_C ATOM_API uint64_t                  atom_frame_arena_current_frame();
+ATOM_EXTERN_C ATOM_API void                      atom_frame_arena_retire(uint64_t frame);
+ATOM_EXTERN_C ATOM_API uint64_t                  atom_frame_arena_retired_frames();
+ATOM_EXTERN_C ATOM_API void*                     atom_frame_alloc(size_t size, size_t alignment);
+ATOM_EXTERN_C ATOM_API void*                     atom_frame_calloc(size_t count, size_t size, size_t alignment);
+ATOM_EXTERN_C ATOM_API atom_frame_arena_marker_t atom_frame_arena_mark();
+ATOM_EXTERN_C ATOM_API void                      atom_frame_arena_rewind(atom_frame_arena_marker_t marker);
+
+// object pool
+// fixed-size slab allocator for objects that are created and destroyed at a high rate. slots are padded to whole cache
+// lines, recycled through a free list and never returned to the heap before the pool itself is released.
+typedef struct atom_object_pool_t atom_object_pool_t;
+
+ATOM_EXTERN_C ATOM_API atom_object_pool_t* atom_create_object_pool(size_t object_size, size_t alignment, const char* tag);
+ATOM_EXTERN_C ATOM_API void                atom_free_object_pool(atom_object_pool_t* pool);
+// returns a zeroed slot
+ATOM_EXTERN_C ATOM_API void*               atom_object_pool_alloc(atom_object_pool_t* pool);
+ATOM_EXTERN_C ATOM_API void                atom_object_pool_free(atom_object_pool_t* pool, void* ptr);
+ATOM_EXTERN_C ATOM_API size_t              atom_object_pool_slot_size(const atom_object_pool_t* pool);
+ATOM_EXTERN_C ATOM_API uint32_t            atom_object_pool_live_count(atom_object_pool_t* pool);
 
-#define atom_malloc                                      malloc
-#define atom_malloc_aligned                              _aligned_malloc
-#define atom_malloc_alignedN(size, alignment, ...)       _aligned_malloc(size, alignment)
-#define atom_calloc                                      calloc
-#define atom_callocN(count, size, ...)                   calloc((count), (size))
-#define atom_calloc_aligned                              _aligned_calloc
-#define atom_realloc                                     realloc
-#define atom_realloc_aligned                             _aligned_realloc
-#define atom_realloc_alignedN(ptr, size, alignment, ...) _aligned_realloc((ptr), (size), (alignment))
-#define atom_memalign                                    _aligned_malloc
-#define atom_free                                        free
-#define atom_freeN(ptr, ...)                             free(ptr)
-#define atom_free_aligned                                _aligned_free
-#define atom_free_alignedN(ptr, alignment, ...)          _aligned_free((ptr), (alignment))
+#define atom_malloc                                       atom_malloc_impl
+#define atom_mallocN(size, ...)                           atom_malloc_tagged((size), __VA_ARGS__)
+#define atom_malloc_aligned                               atom_malloc_aligned_impl
+#define atom_malloc_alignedN(size, alignment, ...)        atom_malloc_aligned_tagged((size), (alignment), __VA_ARGS__)
+#define atom_calloc                                       atom_calloc_impl
+#define atom_callocN(count, size, ...)                    atom_calloc_tagged((count), (size), __VA_ARGS__)
+#define atom_calloc_aligned                               atom_calloc_aligned_impl
+#define atom_calloc_alignedN(count, size, alignment, ...) atom_calloc_aligned_tagged((count), (size), (alignment), __VA_ARGS__)
+#define atom_realloc                                      atom_realloc_impl
+#define atom_reallocN(ptr, size, ...)                     atom_realloc_tagged((ptr), (size), __VA_ARGS__)
+#define atom_realloc_aligned                              atom_realloc_aligned_impl
+#define atom_realloc_alignedN(ptr, size, alignment, ...)  atom_realloc_aligned_tagged((ptr), (size), (alignment), __VA_ARGS__)
+#define atom_memalign                                     atom_malloc_aligned_impl
+#define atom_free                                         atom_free_impl
+#define atom_freeN(ptr, ...)                              atom_free_tagged(ptr)
+#define atom_free_aligned                                 atom_free_aligned_impl
+#define atom_free_alignedN(ptr, alignment, ...)           atom_free_tagged(ptr)
 
 #ifdef __cplusplus
 #include <utility>
@@ -72,4 +180,4 @@ ATOM_FORCEINLINE T make_zeroed(Args&&... args)
     auto res = new (&storage) T(std::forward<Args>(args)...);
     return *res;
 }
-#endif
\ No newline at end of file
+#endif
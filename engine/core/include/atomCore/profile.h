@@ -0,0 +1,102 @@
+#pragma once
+
+#include "config.h"
+
+// cpu profiler
+// zones stamp their begin and end with the cycle counter and append one event per zone into a buffer owned by the
+// calling thread, without locks. nested zones show up as a hierarchy per thread once exported to chrome trace json
+// (chrome://tracing, ui.perfetto.dev). zones are only recorded during a capture, outside of one a zone costs a call and
+// a relaxed load. build with ATOM_PROFILE_ENABLED=0 to compile the zone macros out.
+
+#ifndef ATOM_PROFILE_ENABLED
+#define ATOM_PROFILE_ENABLED 1
+#endif
+
+// static per zone data, created by the ATOM_PROFILE_* macros, name must outlive the capture
+typedef struct atom_profile_site_t {
+    const char* name;
+    const char* file;
+    int         line;
+} atom_profile_site_t;
+
+typedef struct atom_profile_zone_t {
+    // null when the zone began outside of a capture
+    const atom_profile_site_t* site;
+    int64_t                    begin;
+} atom_profile_zone_t;
+
+ATOM_EXTERN_C ATOM_API atom_profile_zone_t atom_profile_zone_begin(const atom_profile_site_t* site);
+ATOM_EXTERN_C ATOM_API void                atom_profile_zone_end(const atom_profile_zone_t* zone);
+// shows up as the thread name in the exported trace
+ATOM_EXTERN_C ATOM_API void                atom_profile_set_thread_name(const char* name);
+
+// starting a capture drops the events of the previous one
+ATOM_EXTERN_C ATOM_API void     atom_profile_begin_capture();
+ATOM_EXTERN_C ATOM_API void     atom_profile_end_capture();
+ATOM_EXTERN_C ATOM_API bool     atom_profile_is_capturing();
+ATOM_EXTERN_C ATOM_API uint64_t atom_profile_event_count();
+// writes the events of the last capture, call after atom_profile_end_capture(). returns false if path cannot be opened
+ATOM_EXTERN_C ATOM_API bool     atom_profile_export_chrome_trace(const char* path);
+
+// tracks hold events timed by something else than the calling thread, the gpu for instance. they show up next to the
+// threads in the exported trace. one thread at a time may emit into a track.
+typedef struct atom_profile_track_t atom_profile_track_t;
+
+ATOM_EXTERN_C ATOM_API atom_profile_track_t* atom_profile_create_track(const char* name);
+// events already emitted stay part of the last capture
+ATOM_EXTERN_C ATOM_API void                  atom_profile_free_track(atom_profile_track_t* track);
+// begin_ns and end_ns are on the atom_profile_time_ns() clock, dropped when no capture is running
+ATOM_EXTERN_C ATOM_API void                  atom_profile_track_emit(atom_profile_track_t*      track,
+                                                                     const atom_profile_site_t* site,
+                                                                     int64_t                    begin_ns,
+                                                                     int64_t                    end_ns);
+// clock the trace timeline is based on, used to line up foreign timestamps with the zones
+ATOM_EXTERN_C ATOM_API int64_t               atom_profile_time_ns();
+
+#define ATOM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ATOM_PROFILE_CONCAT(a, b)      ATOM_PROFILE_CONCAT_IMPL(a, b)
+
+#if ATOM_PROFILE_ENABLED
+// explicit pair for code paths a scope cannot express, var names the zone
+#define ATOM_PROFILE_ZONE_BEGIN(var, name)                                       \
+    static const atom_profile_site_t var##_site_ = {(name), __FILE__, __LINE__}; \
+    const atom_profile_zone_t        var         = atom_profile_zone_begin(&var##_site_)
+#define ATOM_PROFILE_ZONE_END(var) atom_profile_zone_end(&(var))
+
+#if defined(__cplusplus)
+struct AtomProfileScope {
+    explicit AtomProfileScope(const atom_profile_site_t* site) ATOM_NOEXCEPT : zone(atom_profile_zone_begin(site)) {}
+
+    ~AtomProfileScope() ATOM_NOEXCEPT { atom_profile_zone_end(&zone); }
+
+    AtomProfileScope(const AtomProfileScope&)            = delete;
+    AtomProfileScope& operator=(const AtomProfileScope&) = delete;
+
+    const atom_profile_zone_t zone;
+};
+
+#define ATOM_PROFILE_ZONE(name)                                                                \
+    static const atom_profile_site_t ATOM_PROFILE_CONCAT(atom_profile_site_, __LINE__) = {      \
+        (name), __FILE__, __LINE__};                                                           \
+    const AtomProfileScope ATOM_PROFILE_CONCAT(atom_profile_scope_, __LINE__)(                 \
+        &ATOM_PROFILE_CONCAT(atom_profile_site_, __LINE__))
+#elif defined(__GNUC__) || defined(__clang__)
+static inline void atom_profile_zone_cleanup(const atom_profile_zone_t* zone) { atom_profile_zone_end(zone); }
+
+#define ATOM_PROFILE_ZONE(name)                                                                \
+    static const atom_profile_site_t ATOM_PROFILE_CONCAT(atom_profile_site_, __LINE__) = {      \
+        (name), __FILE__, __LINE__};                                                           \
+    __attribute__((cleanup(atom_profile_zone_cleanup))) const atom_profile_zone_t              \
+        ATOM_PROFILE_CONCAT(atom_profile_zone_, __LINE__) =                                    \
+            atom_profile_zone_begin(&ATOM_PROFILE_CONCAT(atom_profile_site_, __LINE__))
+#else
+// c compilers without the cleanup attribute cannot close a zone at scope exit, use the BEGIN/END pair there
+#define ATOM_PROFILE_ZONE(name) ((void)0)
+#endif
+#else
+#define ATOM_PROFILE_ZONE_BEGIN(var, name) ((void)0)
+#define ATOM_PROFILE_ZONE_END(var)         ((void)0)
+#define ATOM_PROFILE_ZONE(name)            ((void)0)
+#endif
+
+#define ATOM_PROFILE_FUNCTION() ATOM_PROFILE_ZONE(__func__)
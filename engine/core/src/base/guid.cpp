@@ -1,13 +1,135 @@
-#define UUID_SYSTEM_GENERATOR
-#include <uuid.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include <atomCore/base/guid.h>
 
-// for __imp_CoCreateGuid not found problem
-#ifdef ATOM_PLAT_WINDOWS
-#pragma comment(lib, "Ole32.lib")
+// xoshiro256** seeded with 256 bits from the os csprng (std::random_device is backed by RtlGenRandom on windows and
+// getrandom or /dev/urandom elsewhere). guids only need to be unique, not unpredictable, so one seed per thread is
+// enough and the per-guid cost stays at a few shifts and multiplies.
+class GuidGenerator
+{
+public:
+    GuidGenerator() ATOM_NOEXCEPT { seed(); }
+
+    void seed() ATOM_NOEXCEPT
+    {
+        std::random_device device;
+        do {
+            for (auto& word : state) word = ((uint64_t)device() << 32) | (uint64_t)device();
+        } while ((state[0] | state[1] | state[2] | state[3]) == 0);
+    }
+
+    uint64_t next() ATOM_NOEXCEPT
+    {
+        const uint64_t result  = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t       = state[1] << 17;
+        state[2]              ^= state[0];
+        state[3]              ^= state[1];
+        state[1]              ^= state[2];
+        state[0]              ^= state[3];
+        state[2]              ^= t;
+        state[3]               = rotl(state[3], 45);
+        return result;
+    }
+
+    // v7 layout: 48 bit unix milliseconds | version | 12 bit counter | variant | 62 random bits.
+    // the counter (RFC 9562 method 1) restarts from a random value below 2^11 every millisecond and keeps guids of the
+    // same thread strictly increasing; when it runs out, the timestamp is advanced ahead of the clock instead.
+    void next_time_ordered(uint64_t now_ms, uint64_t& high, uint64_t& low) ATOM_NOEXCEPT
+    {
+        if (now_ms > last_ms) {
+            last_ms = now_ms;
+            counter = (uint32_t)(next() & 0x7FF);
+        } else if (++counter > 0xFFF) {
+            last_ms++;
+            counter = (uint32_t)(next() & 0x7FF);
+        }
+        high = (last_ms << 16) | 0x7000 | counter;
+        low  = (next() & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+    }
+
+private:
+    static ATOM_FORCEINLINE uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t state[4];
+    uint64_t last_ms = 0;
+    uint32_t counter = 0;
+};
+
+static thread_local GuidGenerator t_guid_generator;
+static std::atomic<int>           g_guid_mode{ATOM_GUID_MODE_RANDOM};
+
+#ifndef _WIN32
+// a forked child inherits the forking thread's generator state and would repeat the parent's guids, so that thread
+// (the only one alive in the child) reseeds before fork() returns
+[[maybe_unused]] static const int g_guid_atfork = pthread_atfork(nullptr, nullptr, [] { t_guid_generator.seed(); });
 #endif
 
-using namespace uuids;
+// guid bytes are stored big endian like the RFC text representation
+static ATOM_FORCEINLINE void store_guid(atom_guid_t* guid, uint64_t high, uint64_t low)
+{
+    for (int i = 0; i < 8; i++) {
+        guid->value[i]     = (uint8_t)(high >> (56 - 8 * i));
+        guid->value[8 + i] = (uint8_t)(low >> (56 - 8 * i));
+    }
+}
+
+static uint64_t unix_milliseconds()
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now).count() & 0xFFFFFFFFFFFFULL;
+}
+
+ATOM_EXTERN_C ATOM_API void atom_set_guid_mode(eAtomGuidMode mode)
+{
+    atom_assert(mode < ATOM_GUID_MODE_COUNT);
+    g_guid_mode.store(mode, std::memory_order_relaxed);
+}
+
+ATOM_EXTERN_C ATOM_API eAtomGuidMode atom_get_guid_mode()
+{
+    return static_cast<eAtomGuidMode>(g_guid_mode.load(std::memory_order_relaxed));
+}
+
+ATOM_EXTERN_C ATOM_API void atom_make_guids_with_mode(atom_guid_t* guids, size_t count, eAtomGuidMode mode)
+{
+    auto& generator = t_guid_generator;
+    if (mode == ATOM_GUID_MODE_TIME_ORDERED) {
+        // the clock is read once per batch, the counter keeps the batch ordered
+        const uint64_t now_ms = unix_milliseconds();
+        for (size_t i = 0; i < count; i++) {
+            uint64_t high, low;
+            generator.next_time_ordered(now_ms, high, low);
+            store_guid(guids + i, high, low);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            const uint64_t high = (generator.next() & 0xFFFFFFFFFFFF0FFFULL) | 0x4000;
+            const uint64_t low  = (generator.next() & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+            store_guid(guids + i, high, low);
+        }
+    }
+}
+
+ATOM_EXTERN_C ATOM_API void atom_make_guids(atom_guid_t* guids, size_t count)
+{
+    atom_make_guids_with_mode(guids, count, atom_get_guid_mode());
+}
+
+ATOM_EXTERN_C ATOM_API void atom_make_guid(atom_guid_t* guid) { atom_make_guids_with_mode(guid, 1, atom_get_guid_mode()); }
+
+ATOM_EXTERN_C ATOM_API int atom_guid_compare(const atom_guid_t* lhs, const atom_guid_t* rhs)
+{
+    return memcmp(lhs->value, rhs->value, sizeof(lhs->value));
+}
 
-ATOM_EXTERN_C ATOM_API void atom_make_guid(atom_guid_t* guid) { *((uuid*)guid) = uuid_system_generator{}(); }
\ No newline at end of file
+ATOM_EXTERN_C ATOM_API bool atom_guid_equal(const atom_guid_t* lhs, const atom_guid_t* rhs)
+{
+    return memcmp(lhs->value, rhs->value, sizeof(lhs->value)) == 0;
+}
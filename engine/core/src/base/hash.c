@@ -1,4 +1,3 @@
-#include <xxhash.h>
 
 #include <atomCore/base/hash.h>
 
@@ -28,9 +27,35 @@ ATOM_EXTERN_C ATOM_API uint64_t atom_hash_64(const void* input, size_t length, u
     return (uint64_t)XXH3_64bits_withSeed(input, length, (XXH64_hash_t)seed);
 }
 
-// ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128(const void* input, size_t length) { XXH3_128bits(input, length); }
-//
-// ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128(const void* input, size_t length, uint64_t seed)
-//{
-//     XXH3_128bits_withSeed(input, length, (XXH64_hash_t)seed);
-// }
\ No newline at end of file
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128_without_seed(const void* input, size_t length)
+{
+    return XXH3_128bits(input, length);
+}
+
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_128(const void* input, size_t length, uint64_t seed)
+{
+    return XXH3_128bits_withSeed(input, length, (XXH64_hash_t)seed);
+}
+
+ATOM_EXTERN_C ATOM_API bool atom_hash_128_equal(atom_hash128_t lhs, atom_hash128_t rhs) { return XXH128_isEqual(lhs, rhs); }
+
+ATOM_EXTERN_C ATOM_API void atom_hash_state_init(atom_hash_state_t* state, uint64_t seed)
+{
+    // 64 and 128 bit resets are identical, so either digest can be taken from the same state
+    XXH3_128bits_reset_withSeed(state, (XXH64_hash_t)seed);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_hash_state_update(atom_hash_state_t* state, const void* input, size_t length)
+{
+    XXH3_128bits_update(state, input, length);
+}
+
+ATOM_EXTERN_C ATOM_API uint64_t atom_hash_state_digest_64(const atom_hash_state_t* state)
+{
+    return (uint64_t)XXH3_64bits_digest(state);
+}
+
+ATOM_EXTERN_C ATOM_API atom_hash128_t atom_hash_state_digest_128(const atom_hash_state_t* state)
+{
+    return XXH3_128bits_digest(state);
+}
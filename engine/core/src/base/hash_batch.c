@@ -0,0 +1,148 @@
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
+#include <atomCore/base/hash.h>
+
+// XXH3 (0.8) short input paths with the default secret folded into their bitflip constants,
+// so that every batched result equals atom_hash_64() of the same input.
+// keys stay scalar: avx2/neon have no 64x64 multiply, and emulating xxh3's multiplies from 32-bit lanes measured slower.
+#define XXH3_BITFLIP_1TO3    0x87275a9bULL
+#define XXH3_BITFLIP_4TO8    0xc73ab174c5ecd5a2ULL
+#define XXH3_BITFLIP_9TO16_A 0x6782737bea4239b9ULL
+#define XXH3_BITFLIP_9TO16_B 0xaf56bc3b0996523aULL
+#define XXH_PRIME64_2        0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3        0x165667B19E3779F9ULL
+#define XXH_PRIME_MX1        0x165667919E3779F9ULL
+#define XXH_PRIME_MX2        0x9FB21C651E98DF25ULL
+
+// atom_hash_batch_strings measures the strings in blocks of this many inputs
+#define HASH_BATCH_BLOCK_SIZE 64
+
+// inputs are read in native byte order, which is little endian on every supported target
+static ATOM_FORCEINLINE uint64_t hash_read64(const uint8_t* ptr)
+{
+    uint64_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static ATOM_FORCEINLINE uint32_t hash_read32(const uint8_t* ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static ATOM_FORCEINLINE uint64_t hash_swap64(uint64_t value)
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+static ATOM_FORCEINLINE uint32_t hash_swap32(uint32_t value)
+{
+#if defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#else
+    return __builtin_bswap32(value);
+#endif
+}
+
+static ATOM_FORCEINLINE uint64_t hash_mul128_fold64(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = (__uint128_t)lhs * rhs;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_M_X64)
+    uint64_t high;
+    const uint64_t low = _umul128(lhs, rhs, &high);
+    return low ^ high;
+#else
+    const uint64_t lo_lo = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+    const uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+    const uint64_t lo_hi = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+    const uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+    const uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    const uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFFULL);
+    return lower ^ upper;
+#endif
+}
+
+static ATOM_FORCEINLINE uint64_t hash_lane_1to3(const uint8_t* input, size_t length)
+{
+    return ((uint32_t)input[0] << 16) | ((uint32_t)input[length >> 1] << 24) | (uint32_t)input[length - 1]
+           | ((uint32_t)length << 8);
+}
+
+static ATOM_FORCEINLINE uint64_t hash_lane_4to8(const uint8_t* input, size_t length)
+{
+    return hash_read32(input + length - 4) + ((uint64_t)hash_read32(input) << 32);
+}
+
+static ATOM_FORCEINLINE uint64_t hash_seed_4to8(uint64_t seed) { return seed ^ ((uint64_t)hash_swap32((uint32_t)seed) << 32); }
+
+static ATOM_FORCEINLINE uint64_t hash_finalize_1to3(uint64_t combined, uint64_t seed)
+{
+    uint64_t h  = combined ^ (XXH3_BITFLIP_1TO3 + seed);
+    h          ^= h >> 33;
+    h          *= XXH_PRIME64_2;
+    h          ^= h >> 29;
+    h          *= XXH_PRIME64_3;
+    return h ^ (h >> 32);
+}
+
+static ATOM_FORCEINLINE uint64_t hash_finalize_4to8(uint64_t input64, uint64_t length, uint64_t seed4to8)
+{
+    uint64_t h  = input64 ^ (XXH3_BITFLIP_4TO8 - seed4to8);
+    h          ^= ((h << 49) | (h >> 15)) ^ ((h << 24) | (h >> 40));
+    h          *= XXH_PRIME_MX2;
+    h          ^= (h >> 35) + length;
+    h          *= XXH_PRIME_MX2;
+    return h ^ (h >> 28);
+}
+
+static ATOM_FORCEINLINE uint64_t hash_finalize_9to16(uint64_t lo, uint64_t hi, uint64_t length, uint64_t seed)
+{
+    lo           ^= XXH3_BITFLIP_9TO16_A + seed;
+    hi           ^= XXH3_BITFLIP_9TO16_B - seed;
+    uint64_t acc  = length + hash_swap64(lo) + hi + hash_mul128_fold64(lo, hi);
+    acc          ^= acc >> 37;
+    acc          *= XXH_PRIME_MX1;
+    return acc ^ (acc >> 32);
+}
+
+static ATOM_FORCEINLINE uint64_t hash_one(const void* input, size_t length, uint64_t seed)
+{
+    const uint8_t* bytes = (const uint8_t*)input;
+    if (length > 16 || length == 0) return atom_hash_64(input, length, seed);
+    if (length > 8) return hash_finalize_9to16(hash_read64(bytes), hash_read64(bytes + length - 8), length, seed);
+    if (length >= 4) return hash_finalize_4to8(hash_lane_4to8(bytes, length), length, hash_seed_4to8(seed));
+    return hash_finalize_1to3(hash_lane_1to3(bytes, length), seed);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_hash_batch(
+    const void* const* inputs, const size_t* lengths, uint32_t count, uint64_t seed, uint64_t* out)
+{
+    for (uint32_t i = 0; i < count; i++) out[i] = hash_one(inputs[i], lengths[i], seed);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_hash_batch_strings(const char* const* strings, uint32_t count, uint64_t seed, uint64_t* out)
+{
+    const void* inputs[HASH_BATCH_BLOCK_SIZE];
+    size_t      lengths[HASH_BATCH_BLOCK_SIZE];
+    for (uint32_t base = 0; base < count; base += HASH_BATCH_BLOCK_SIZE) {
+        const uint32_t block = count - base < HASH_BATCH_BLOCK_SIZE ? count - base : HASH_BATCH_BLOCK_SIZE;
+        for (uint32_t i = 0; i < block; i++) {
+            inputs[i]  = strings[base + i];
+            lengths[i] = strlen(strings[base + i]);
+        }
+        atom_hash_batch(inputs, lengths, block, seed, out + base);
+    }
+}
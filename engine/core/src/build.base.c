@@ -1 +1,2 @@
-#include "base/hash.c"
\ No newline at end of file
+#include "base/hash.c"
+#include "base/hash_batch.c"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "job/scheduler.cpp"
\ No newline at end of file
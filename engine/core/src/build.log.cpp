@@ -1,2 +1,3 @@
 #include "log/manager.cpp"
+#include "log/deferred.cpp"
 #include "log/log.cpp"
\ No newline at end of file
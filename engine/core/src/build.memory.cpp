@@ -0,0 +1,6 @@
+#define ATOM_LOG_CATEGORY ATOM_LOG_CATEGORY_MEMORY
+
+#include "memory/allocator.cpp"
+#include "memory/tracking.cpp"
+#include "memory/arena.cpp"
+#include "memory/pool.cpp"
\ No newline at end of file
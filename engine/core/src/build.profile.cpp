@@ -0,0 +1 @@
+#include "profile/profiler.cpp"
\ No newline at end of file
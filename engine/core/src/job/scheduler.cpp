@@ -0,0 +1,678 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <atomCore/job.h>
+#include <atomCore/memory.h>
+#include <atomCore/log.h>
+#include <atomCore/profile.h>
+
+static const char* kJobMemoryTag = "atom::job";
+
+static constexpr uint32_t kJobsPerBlock     = 256;
+static constexpr int64_t  kJobDequeCapacity = 4096;
+// idle workers poll this many times before they go to sleep, waiters back off to yielding and then to short sleeps
+static constexpr uint32_t kIdleSpinCount    = 256;
+static constexpr uint32_t kWaitSpinCount    = 64;
+static constexpr uint32_t kWaitYieldCount   = 256;
+
+struct JobCache;
+
+struct Job {
+    Job*                  next;
+    JobCache*             owner;
+    atom_job_func_t       function;
+    atom_job_range_func_t range_function;
+    void*                 user_data;
+    atom_job_counter_t*   counter;
+    uint32_t              begin;
+    uint32_t              end;
+    uint32_t              affinity;
+    bool                  pinned;
+};
+
+struct JobBlock {
+    JobBlock* next;
+    Job       jobs[kJobsPerBlock];
+};
+
+// jobs are recycled into the cache of the thread that allocated them: the owner pops its local list without any
+// synchronization, other threads hand finished jobs back through a lock-free stack that the owner takes as a whole.
+struct JobCache {
+    Job*              free_list = ATOM_NULLPTR;
+    std::atomic<Job*> returned{ATOM_NULLPTR};
+    JobBlock*         blocks     = ATOM_NULLPTR;
+    JobCache*         next_cache = ATOM_NULLPTR;
+};
+
+struct atom_job_counter_t {
+    std::atomic<uint32_t> value{0};
+    // guards the deferred list and the final decrement, see finish_counter()
+    std::atomic_flag      lock     = ATOMIC_FLAG_INIT;
+    Job*                  deferred = ATOM_NULLPTR;
+
+    void acquire()
+    {
+        while (lock.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    void release() { lock.clear(std::memory_order_release); }
+};
+
+// Chase-Lev work-stealing deque with the C11 memory orderings of Le et al. (PPoPP 2013).
+// the owner pushes and pops at the bottom, any thread may steal from the top. the capacity is fixed, callers route
+// jobs that do not fit into the shared queue instead.
+class JobDeque
+{
+public:
+    bool push(Job* job)
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= kJobDequeCapacity) return false;
+        buffer[b & (kJobDequeCapacity - 1)].store(job, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* pop()
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return ATOM_NULLPTR;
+        }
+        Job* job = buffer[b & (kJobDequeCapacity - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last job, race the thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = ATOM_NULLPTR;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* steal()
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return ATOM_NULLPTR;
+        Job* job = buffer[t & (kJobDequeCapacity - 1)].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return ATOM_NULLPTR;
+        }
+        return job;
+    }
+
+    bool empty() const
+    {
+        return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<Job*> buffer[kJobDequeCapacity];
+};
+
+struct Worker {
+    JobDeque              deque;
+    // jobs submitted with an affinity for this worker, pinned ones are never taken by others
+    std::mutex            inbox_mutex;
+    std::deque<Job*>      preferred;
+    std::deque<Job*>      pinned;
+    std::atomic<uint32_t> inbox_size{0};
+    std::atomic<uint32_t> preferred_size{0};
+    // sleeping workers wait for the signal to change, wakers flip sleeping back first so that one wake is enough
+    std::atomic<uint32_t> signal{0};
+    std::atomic<bool>     sleeping{false};
+    std::thread           thread;
+    uint32_t              index;
+};
+
+static std::atomic<bool>     g_job_system_initialized{false};
+static std::atomic<bool>     g_job_system_running{false};
+static Worker**              g_workers      = ATOM_NULLPTR;
+static uint32_t              g_worker_count = 1;
+static std::atomic<uint32_t> g_wake_cursor{0};
+// bumped by every finalize, caches of an older generation are gone
+static std::atomic<uint32_t> g_job_generation{1};
+static std::mutex            g_job_cache_mutex;
+static JobCache*             g_job_caches = ATOM_NULLPTR;
+// jobs submitted from threads that are not workers, or that did not fit into a deque
+static std::mutex            g_global_mutex;
+static std::deque<Job*>      g_global_queue;
+static std::atomic<uint32_t> g_global_size{0};
+
+struct ThreadJobState {
+    JobCache* cache            = ATOM_NULLPTR;
+    uint32_t  cache_generation = 0;
+    uint32_t  worker_index     = ATOM_JOB_AFFINITY_ANY;
+    uint32_t  random           = 0x9E3779B9u;
+};
+
+static thread_local ThreadJobState t_job_state;
+
+static ATOM_FORCEINLINE void cpu_relax()
+{
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+static ATOM_FORCEINLINE Worker* current_worker()
+{
+    const uint32_t index = t_job_state.worker_index;
+    return index < g_worker_count ? g_workers[index] : ATOM_NULLPTR;
+}
+
+static JobCache* thread_job_cache()
+{
+    ThreadJobState& state      = t_job_state;
+    const uint32_t  generation = g_job_generation.load(std::memory_order_acquire);
+    if (state.cache && state.cache_generation == generation) return state.cache;
+    JobCache* cache = atom_new<JobCache>();
+    {
+        std::lock_guard<std::mutex> lock(g_job_cache_mutex);
+        cache->next_cache = g_job_caches;
+        g_job_caches      = cache;
+    }
+    state.cache            = cache;
+    state.cache_generation = generation;
+    return cache;
+}
+
+static Job* alloc_job()
+{
+    JobCache* cache = thread_job_cache();
+    Job*      job   = cache->free_list;
+    if (job == ATOM_NULLPTR) job = cache->returned.exchange(ATOM_NULLPTR, std::memory_order_acquire);
+    if (job == ATOM_NULLPTR) {
+        JobBlock* block = (JobBlock*)atom_mallocN(sizeof(JobBlock), kJobMemoryTag);
+        block->next     = cache->blocks;
+        cache->blocks   = block;
+        for (uint32_t i = 0; i < kJobsPerBlock; i++) {
+            block->jobs[i].owner = cache;
+            block->jobs[i].next  = i + 1 < kJobsPerBlock ? &block->jobs[i + 1] : ATOM_NULLPTR;
+        }
+        job = block->jobs;
+    }
+    cache->free_list = job->next;
+    job->next        = ATOM_NULLPTR;
+    return job;
+}
+
+static void free_job(Job* job)
+{
+    JobCache* cache = job->owner;
+    if (cache == t_job_state.cache) {
+        job->next        = cache->free_list;
+        cache->free_list = job;
+    } else {
+        job->next = cache->returned.load(std::memory_order_relaxed);
+        while (!cache->returned.compare_exchange_weak(job->next, job, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+}
+
+static void free_job_caches()
+{
+    std::lock_guard<std::mutex> lock(g_job_cache_mutex);
+    for (JobCache* cache = g_job_caches; cache;) {
+        for (JobBlock* block = cache->blocks; block;) {
+            JobBlock* next = block->next;
+            atom_freeN(block, kJobMemoryTag);
+            block = next;
+        }
+        JobCache* next = cache->next_cache;
+        atom_delete(cache);
+        cache = next;
+    }
+    g_job_caches = ATOM_NULLPTR;
+}
+
+static Job* make_job(const atom_job_decl_t& decl, atom_job_counter_t* counter)
+{
+    Job* job            = alloc_job();
+    job->function       = decl.function;
+    job->range_function = ATOM_NULLPTR;
+    job->user_data      = decl.user_data;
+    job->counter        = counter;
+    job->affinity       = decl.affinity < g_worker_count ? decl.affinity : ATOM_JOB_AFFINITY_ANY;
+    job->pinned         = decl.pinned && job->affinity != ATOM_JOB_AFFINITY_ANY;
+    return job;
+}
+
+static bool wake_worker(Worker* worker)
+{
+    if (!worker->sleeping.load(std::memory_order_relaxed) || !worker->sleeping.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+    worker->signal.fetch_add(1, std::memory_order_release);
+    worker->signal.notify_one();
+    return true;
+}
+
+// worker 0 is the initializing thread, it never sleeps in the worker loop
+static void wake_workers(uint32_t count)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint32_t threads = g_worker_count - 1;
+    if (threads == 0) return;
+    const uint32_t start = g_wake_cursor.fetch_add(1, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < threads && count; i++) {
+        if (wake_worker(g_workers[1 + (start + i) % threads])) count--;
+    }
+}
+
+static void execute_job(Job* job);
+
+// queues the job without waking anyone, returns the worker that has to be woken for it if any
+static Worker* enqueue_job(Job* job)
+{
+    if (job->affinity != ATOM_JOB_AFFINITY_ANY) {
+        Worker* target = g_workers[job->affinity];
+        {
+            std::lock_guard<std::mutex> lock(target->inbox_mutex);
+            if (job->pinned) {
+                target->pinned.push_back(job);
+            } else {
+                target->preferred.push_back(job);
+                target->preferred_size.fetch_add(1, std::memory_order_relaxed);
+            }
+            target->inbox_size.fetch_add(1, std::memory_order_release);
+        }
+        return target;
+    }
+    Worker* self = current_worker();
+    if (self == ATOM_NULLPTR || !self->deque.push(job)) {
+        std::lock_guard<std::mutex> lock(g_global_mutex);
+        g_global_queue.push_back(job);
+        g_global_size.fetch_add(1, std::memory_order_release);
+    }
+    return ATOM_NULLPTR;
+}
+
+// submits a list linked through Job::next, jobs run inline while the system is not initialized
+static void submit_jobs(Job* jobs)
+{
+    if (!g_job_system_running.load(std::memory_order_acquire)) {
+        while (jobs) {
+            Job* next = jobs->next;
+            execute_job(jobs);
+            jobs = next;
+        }
+        return;
+    }
+    uint32_t any_count = 0;
+    while (jobs) {
+        Job* next = jobs->next;
+        if (Worker* target = enqueue_job(jobs)) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wake_worker(target);
+        } else {
+            any_count++;
+        }
+        jobs = next;
+    }
+    if (any_count) wake_workers(any_count);
+}
+
+static void finish_counter(atom_job_counter_t* counter)
+{
+    uint32_t value = counter->value.load(std::memory_order_relaxed);
+    while (value > 1) {
+        if (counter->value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+    // the final decrement happens under the lock, so atom_job_wait() can make sure nobody touches the counter anymore
+    // by taking the lock once after it observed zero
+    counter->acquire();
+    Job* deferred = ATOM_NULLPTR;
+    if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        deferred          = counter->deferred;
+        counter->deferred = ATOM_NULLPTR;
+    }
+    counter->release();
+    if (deferred) submit_jobs(deferred);
+}
+
+static void execute_job(Job* job)
+{
+    if (job->range_function) {
+        job->range_function(job->begin, job->end, job->user_data);
+    } else {
+        job->function(job->user_data);
+    }
+    atom_job_counter_t* counter = job->counter;
+    free_job(job);
+    if (counter) finish_counter(counter);
+}
+
+static Job* pop_inbox(Worker* worker, bool include_pinned)
+{
+    std::lock_guard<std::mutex> lock(worker->inbox_mutex);
+    Job*                        job = ATOM_NULLPTR;
+    if (include_pinned && !worker->pinned.empty()) {
+        job = worker->pinned.front();
+        worker->pinned.pop_front();
+    } else if (!worker->preferred.empty()) {
+        job = worker->preferred.front();
+        worker->preferred.pop_front();
+        worker->preferred_size.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        return ATOM_NULLPTR;
+    }
+    worker->inbox_size.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+static Job* take_job(Worker* self)
+{
+    if (self) {
+        if (self->inbox_size.load(std::memory_order_acquire)) {
+            if (Job* job = pop_inbox(self, true)) return job;
+        }
+        if (Job* job = self->deque.pop()) return job;
+    }
+    if (g_global_size.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(g_global_mutex);
+        if (!g_global_queue.empty()) {
+            Job* job = g_global_queue.front();
+            g_global_queue.pop_front();
+            g_global_size.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    // steal from a random victim first so that thieves spread over the workers
+    uint32_t& random  = t_job_state.random;
+    random           ^= random << 13;
+    random           ^= random >> 17;
+    random           ^= random << 5;
+    const uint32_t start = random % g_worker_count;
+    for (uint32_t i = 0; i < g_worker_count; i++) {
+        Worker* victim = g_workers[(start + i) % g_worker_count];
+        if (victim == self) continue;
+        if (Job* job = victim->deque.steal()) return job;
+    }
+    // affinity of unpinned jobs is only a hint, take them once there is nothing else to do
+    for (uint32_t i = 0; i < g_worker_count; i++) {
+        Worker* victim = g_workers[(start + i) % g_worker_count];
+        if (victim == self || !victim->preferred_size.load(std::memory_order_acquire)) continue;
+        if (Job* job = pop_inbox(victim, false)) return job;
+    }
+    return ATOM_NULLPTR;
+}
+
+static bool has_work(Worker* self)
+{
+    if (self->inbox_size.load(std::memory_order_acquire) || g_global_size.load(std::memory_order_acquire)) return true;
+    for (uint32_t i = 0; i < g_worker_count; i++) {
+        Worker* worker = g_workers[i];
+        if (!worker->deque.empty() || (worker != self && worker->preferred_size.load(std::memory_order_acquire))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void idle_worker(Worker* self)
+{
+    for (uint32_t i = 0; i < kIdleSpinCount; i++) {
+        if (has_work(self) || !g_job_system_running.load(std::memory_order_relaxed)) return;
+        cpu_relax();
+    }
+    const uint32_t signal = self->signal.load(std::memory_order_acquire);
+    self->sleeping.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_work(self) || !g_job_system_running.load(std::memory_order_acquire)) {
+        self->sleeping.store(false, std::memory_order_relaxed);
+        return;
+    }
+    self->signal.wait(signal, std::memory_order_acquire);
+    self->sleeping.store(false, std::memory_order_relaxed);
+}
+
+static void worker_main(Worker* self)
+{
+    t_job_state.worker_index = self->index;
+    char name[32];
+    snprintf(name, sizeof(name), "atom::job_worker %u", self->index);
+    atom_profile_set_thread_name(name);
+    while (g_job_system_running.load(std::memory_order_acquire)) {
+        if (Job* job = take_job(self)) {
+            execute_job(job);
+        } else {
+            idle_worker(self);
+        }
+    }
+}
+
+static void pin_thread(std::thread& thread, uint32_t core)
+{
+#if defined(_WIN32)
+    if (!SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << (core % (sizeof(DWORD_PTR) * 8)))) {
+        ATOM_warn(u8"job system: failed to pin a worker to core %u", core);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % CPU_SETSIZE, &set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0) {
+        ATOM_warn(u8"job system: failed to pin a worker to core %u", core);
+    }
+#else
+    (void)thread;
+    (void)core;
+#endif
+}
+
+bool atom_job_system_initialize(const atom_job_system_desc_t* desc)
+{
+    bool expected = false;
+    if (!g_job_system_initialized.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        ATOM_error(u8"job system: already initialized");
+        return false;
+    }
+    const uint32_t hardware_threads = atom_max(std::thread::hardware_concurrency(), 1U);
+    uint32_t       thread_count     = desc ? desc->worker_count : 0;
+    if (thread_count == 0) thread_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+
+    g_worker_count = thread_count + 1;
+    g_workers      = (Worker**)atom_callocN(g_worker_count, sizeof(Worker*), kJobMemoryTag);
+    for (uint32_t i = 0; i < g_worker_count; i++) {
+        g_workers[i]        = atom_new<Worker>();
+        g_workers[i]->index = i;
+    }
+    t_job_state.worker_index = 0;
+    g_job_system_running.store(true, std::memory_order_release);
+    for (uint32_t i = 1; i < g_worker_count; i++) {
+        g_workers[i]->thread = std::thread(worker_main, g_workers[i]);
+        if (desc && desc->pin_threads) pin_thread(g_workers[i]->thread, i % hardware_threads);
+    }
+    ATOM_info(u8"job system: %u workers on %u hardware threads", g_worker_count, hardware_threads);
+    return true;
+}
+
+void atom_job_system_finalize()
+{
+    if (!g_job_system_initialized.load(std::memory_order_acquire)) return;
+    g_job_system_running.store(false, std::memory_order_seq_cst);
+    for (uint32_t i = 1; i < g_worker_count; i++) {
+        g_workers[i]->signal.fetch_add(1, std::memory_order_release);
+        g_workers[i]->signal.notify_one();
+    }
+    for (uint32_t i = 1; i < g_worker_count; i++) g_workers[i]->thread.join();
+    for (uint32_t i = 0; i < g_worker_count; i++) atom_delete(g_workers[i]);
+    atom_freeN(g_workers, kJobMemoryTag);
+    g_workers      = ATOM_NULLPTR;
+    g_worker_count = 1;
+    {
+        std::lock_guard<std::mutex> lock(g_global_mutex);
+        g_global_queue.clear();
+        g_global_size.store(0, std::memory_order_relaxed);
+    }
+    g_job_generation.fetch_add(1, std::memory_order_acq_rel);
+    free_job_caches();
+    t_job_state.worker_index = ATOM_JOB_AFFINITY_ANY;
+    g_job_system_initialized.store(false, std::memory_order_release);
+}
+
+bool atom_job_system_is_initialized() { return g_job_system_initialized.load(std::memory_order_acquire); }
+
+uint32_t atom_job_worker_count() { return g_worker_count; }
+
+uint32_t atom_job_current_worker() { return t_job_state.worker_index; }
+
+static atom_object_pool_t* job_counter_pool()
+{
+    static atom_object_pool_t* pool =
+        atom_create_object_pool(sizeof(atom_job_counter_t), alignof(atom_job_counter_t), kJobMemoryTag);
+    return pool;
+}
+
+atom_job_counter_t* atom_create_job_counter()
+{
+    return atom_new_placed<atom_job_counter_t>(atom_object_pool_alloc(job_counter_pool()));
+}
+
+void atom_free_job_counter(atom_job_counter_t* counter)
+{
+    if (counter == ATOM_NULLPTR) return;
+    atom_assert(counter->value.load(std::memory_order_acquire) == 0 && "job system: freeing a counter that is in use!");
+    atom_delete_placed(counter);
+    atom_object_pool_free(job_counter_pool(), counter);
+}
+
+uint32_t atom_job_counter_value(const atom_job_counter_t* counter) { return counter->value.load(std::memory_order_acquire); }
+
+void atom_job_counter_add(atom_job_counter_t* counter, uint32_t count)
+{
+    counter->value.fetch_add(count, std::memory_order_acq_rel);
+}
+
+void atom_job_counter_done(atom_job_counter_t* counter)
+{
+    atom_assert(counter->value.load(std::memory_order_relaxed) > 0 && "job system: counter dropped below zero!");
+    finish_counter(counter);
+}
+
+static Job* make_job_list(const atom_job_decl_t* jobs, uint32_t count, atom_job_counter_t* counter)
+{
+    Job* head = ATOM_NULLPTR;
+    for (uint32_t i = count; i > 0; i--) {
+        Job* job  = make_job(jobs[i - 1], counter);
+        job->next = head;
+        head      = job;
+    }
+    return head;
+}
+
+void atom_job_run(const atom_job_decl_t* jobs, uint32_t count, atom_job_counter_t* counter)
+{
+    if (count == 0) return;
+    if (counter) counter->value.fetch_add(count, std::memory_order_acq_rel);
+    submit_jobs(make_job_list(jobs, count, counter));
+}
+
+void atom_job_run_after(atom_job_counter_t*    dependency,
+                        const atom_job_decl_t* jobs,
+                        uint32_t               count,
+                        atom_job_counter_t*    counter)
+{
+    if (count == 0) return;
+    if (counter) counter->value.fetch_add(count, std::memory_order_acq_rel);
+    Job* list = make_job_list(jobs, count, counter);
+    if (dependency) {
+        dependency->acquire();
+        if (dependency->value.load(std::memory_order_acquire) != 0) {
+            Job* tail = list;
+            while (tail->next) tail = tail->next;
+            tail->next           = dependency->deferred;
+            dependency->deferred = list;
+            dependency->release();
+            return;
+        }
+        dependency->release();
+    }
+    submit_jobs(list);
+}
+
+void atom_job_wait(atom_job_counter_t* counter)
+{
+    Worker*  self = current_worker();
+    uint32_t idle = 0;
+    while (counter->value.load(std::memory_order_acquire) != 0) {
+        if (g_job_system_running.load(std::memory_order_relaxed)) {
+            if (Job* job = take_job(self)) {
+                execute_job(job);
+                idle = 0;
+                continue;
+            }
+        }
+        if (idle < kWaitSpinCount) {
+            cpu_relax();
+        } else if (idle < kWaitSpinCount + kWaitYieldCount) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        idle++;
+    }
+    // the thread that dropped the counter to zero may still hold its lock
+    counter->acquire();
+    counter->release();
+}
+
+void atom_job_parallel_for(uint32_t count, uint32_t batch_size, atom_job_range_func_t function, void* user_data)
+{
+    if (count == 0) return;
+    if (batch_size == 0) batch_size = atom_max(count / (g_worker_count * 4), 1U);
+    if (!g_job_system_running.load(std::memory_order_acquire) || count <= batch_size) {
+        function(0, count, user_data);
+        return;
+    }
+    // the calling thread takes the first range itself
+    const uint32_t     range_count = (count + batch_size - 1) / batch_size;
+    atom_job_counter_t counter;
+    counter.value.store(range_count - 1, std::memory_order_relaxed);
+    Job* head = ATOM_NULLPTR;
+    for (uint32_t i = range_count - 1; i > 0; i--) {
+        Job* job            = alloc_job();
+        job->function       = ATOM_NULLPTR;
+        job->range_function = function;
+        job->user_data      = user_data;
+        job->counter        = &counter;
+        job->begin          = i * batch_size;
+        job->end            = atom_min(job->begin + batch_size, count);
+        job->affinity       = ATOM_JOB_AFFINITY_ANY;
+        job->pinned         = false;
+        job->next           = head;
+        head                = job;
+    }
+    submit_jobs(head);
+    function(0, batch_size, user_data);
+    atom_job_wait(&counter);
+}
@@ -0,0 +1,804 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <spdlog/sinks/sink.h>
+
+#include <atomCore/log/log.h>
+#include <atomCore/log/manager.hpp>
+#include <atomCore/memory.h>
+
+static constexpr uint32_t kMaxLogSites       = 8192;
+static constexpr uint32_t kMaxLogArgs        = 16;
+static constexpr size_t   kLogRingSize       = 256 * 1024;
+static constexpr size_t   kMaxLogRecordSize  = 1024;
+static constexpr size_t   kMaxLogStringSize  = 256;
+static constexpr size_t   kMaxLogMessageSize = 4096;
+// sites that cannot be deferred (positional arguments, %n, too many arguments, full registry)
+static constexpr uint32_t kLogSiteImmediate  = UINT32_MAX;
+// site id of the padding record written when a record does not fit before the end of the ring
+static constexpr uint32_t kLogRecordWrap     = UINT32_MAX;
+static const char*        kLogRingMemoryPoolName = "atom::log_ring";
+
+static std::atomic<int>      g_log_mode    = ATOM_LOG_MODE_IMMEDIATE;
+static std::atomic<uint64_t> g_log_dropped = 0;
+
+// format parsing
+enum eLogArgType : uint8_t {
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_INTMAX,
+    LOG_ARG_SIZE,
+    LOG_ARG_PTRDIFF,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_LDOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER
+};
+
+struct LogSiteInfo {
+    const char* format;
+    const char* file;
+    const char* function;
+    int32_t     level;
+    int32_t     line;
+    uint8_t     arg_count;
+    uint8_t     arg_types[kMaxLogArgs];
+};
+
+static ATOM_FORCEINLINE bool is_log_digit(char c) { return c >= '0' && c <= '9'; }
+
+// collects the argument types of a printf format, returns false for formats that can only be formatted immediately
+static bool parse_log_format(const char* format, uint8_t* types, uint8_t* count)
+{
+    uint8_t n = 0;
+    for (const char* p = format; *p; ++p) {
+        if (*p != '%') continue;
+        if (*++p == '%') continue;
+        while (*p && strchr("-+ #0'", *p)) ++p;
+        if (*p == '*') {
+            if (n == kMaxLogArgs) return false;
+            types[n++] = LOG_ARG_INT;
+            ++p;
+        } else {
+            while (is_log_digit(*p)) ++p;
+            if (*p == '$') return false;
+        }
+        if (*p == '.') {
+            if (*++p == '*') {
+                if (n == kMaxLogArgs) return false;
+                types[n++] = LOG_ARG_INT;
+                ++p;
+            } else {
+                while (is_log_digit(*p)) ++p;
+            }
+        }
+        uint8_t int_type    = LOG_ARG_INT;
+        bool    long_double = false;
+        switch (*p) {
+            case 'h':
+                if (*++p == 'h') ++p;
+                break;
+            case 'l':
+                if (*++p == 'l') {
+                    int_type = LOG_ARG_LLONG;
+                    ++p;
+                } else {
+                    int_type = LOG_ARG_LONG;
+                }
+                break;
+            case 'j': int_type = LOG_ARG_INTMAX, ++p; break;
+            case 'z': int_type = LOG_ARG_SIZE, ++p; break;
+            case 't': int_type = LOG_ARG_PTRDIFF, ++p; break;
+            case 'L': long_double = true, ++p; break;
+            default:  break;
+        }
+        if (n == kMaxLogArgs) return false;
+        switch (*p) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X': types[n++] = int_type; break;
+            case 'c':
+                // wide characters are not supported
+                if (int_type != LOG_ARG_INT) return false;
+                types[n++] = LOG_ARG_INT;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': types[n++] = long_double ? LOG_ARG_LDOUBLE : LOG_ARG_DOUBLE; break;
+            case 's':
+                if (int_type != LOG_ARG_INT) return false;
+                types[n++] = LOG_ARG_STRING;
+                break;
+            case 'p': types[n++] = LOG_ARG_POINTER; break;
+            default:  return false;
+        }
+    }
+    *count = n;
+    return true;
+}
+
+// record payload, arguments are packed without padding:
+// ints as 4 bytes, other integers/floats/pointers as 8 bytes, strings as a 2 byte length followed by the bytes
+struct LogPayloadWriter {
+    uint8_t* cursor;
+    uint8_t* end;
+
+    template <typename T>
+    ATOM_FORCEINLINE void write(T value)
+    {
+        if (cursor + sizeof(T) > end) return;
+        memcpy(cursor, &value, sizeof(T));
+        cursor += sizeof(T);
+    }
+
+    void write_string(const char* str)
+    {
+        if (str == ATOM_NULLPTR) str = "(null)";
+        if (cursor + sizeof(uint16_t) > end) return;
+        size_t length = strnlen(str, kMaxLogStringSize);
+        if (length > (size_t)(end - cursor) - sizeof(uint16_t)) length = (size_t)(end - cursor) - sizeof(uint16_t);
+        write((uint16_t)length);
+        memcpy(cursor, str, length);
+        cursor += length;
+    }
+};
+
+struct LogPayloadReader {
+    const uint8_t* cursor;
+    const uint8_t* end;
+
+    template <typename T>
+    ATOM_FORCEINLINE bool read(T& value)
+    {
+        if (cursor + sizeof(T) > end) return false;
+        memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    bool read_string(char* out, size_t capacity)
+    {
+        uint16_t length = 0;
+        if (!read(length) || cursor + length > end || length >= capacity) return false;
+        memcpy(out, cursor, length);
+        out[length] = '\0';
+        cursor     += length;
+        return true;
+    }
+};
+
+static void encode_log_args(const LogSiteInfo& site, va_list args, LogPayloadWriter& writer)
+{
+    for (uint8_t i = 0; i < site.arg_count; i++) {
+        switch (site.arg_types[i]) {
+            case LOG_ARG_INT:     writer.write((int32_t)va_arg(args, int)); break;
+            case LOG_ARG_LONG:    writer.write((int64_t)va_arg(args, long)); break;
+            case LOG_ARG_LLONG:   writer.write((int64_t)va_arg(args, long long)); break;
+            case LOG_ARG_INTMAX:  writer.write((int64_t)va_arg(args, intmax_t)); break;
+            case LOG_ARG_SIZE:    writer.write((uint64_t)va_arg(args, size_t)); break;
+            case LOG_ARG_PTRDIFF: writer.write((int64_t)va_arg(args, ptrdiff_t)); break;
+            case LOG_ARG_DOUBLE:  writer.write(va_arg(args, double)); break;
+            case LOG_ARG_LDOUBLE: writer.write((double)va_arg(args, long double)); break;
+            case LOG_ARG_STRING:  writer.write_string(va_arg(args, const char*)); break;
+            case LOG_ARG_POINTER: writer.write((uint64_t)(uintptr_t)va_arg(args, void*)); break;
+            default:              break;
+        }
+    }
+}
+
+// replays the format with the packed arguments, returns the message length (truncated to capacity - 1)
+static size_t format_log_record(const char*    format,
+                                const uint8_t* types,
+                                uint8_t        count,
+                                const uint8_t* payload,
+                                size_t         payload_size,
+                                char*          out,
+                                size_t         capacity)
+{
+    LogPayloadReader reader = {payload, payload + payload_size};
+    size_t           length = 0;
+    uint8_t          arg    = 0;
+    const auto       append = [&](int written) {
+        if (written > 0) length += (size_t)written;
+        if (length >= capacity) length = capacity - 1;
+    };
+    for (const char* p = format; *p && length + 1 < capacity;) {
+        if (*p != '%') {
+            out[length++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[length++]  = '%';
+            p             += 2;
+            continue;
+        }
+        // rebuild the conversion spec with '*' replaced by the recorded width/precision
+        char   spec[64];
+        size_t spec_length = 0;
+        spec[spec_length++] = *p++;
+        while (*p && !strchr("diouxXcfFeEgGaAsp", *p) && spec_length + 12 < sizeof(spec)) {
+            if (*p == '*') {
+                int32_t value = 0;
+                if (arg >= count || !reader.read(value)) goto truncated;
+                arg++;
+                spec_length += (size_t)snprintf(spec + spec_length, sizeof(spec) - spec_length, "%d", (int)value);
+            } else {
+                spec[spec_length++] = *p;
+            }
+            ++p;
+        }
+        if (!*p || arg >= count) goto truncated;
+        spec[spec_length++] = *p++;
+        spec[spec_length]   = '\0';
+
+        char*        dst       = out + length;
+        const size_t remaining = capacity - length;
+        switch (types[arg++]) {
+            case LOG_ARG_INT: {
+                int32_t value;
+                if (!reader.read(value)) goto truncated;
+                append(snprintf(dst, remaining, spec, (int)value));
+            } break;
+            case LOG_ARG_LONG:
+            case LOG_ARG_LLONG:
+            case LOG_ARG_INTMAX:
+            case LOG_ARG_SIZE:
+            case LOG_ARG_PTRDIFF: {
+                int64_t value;
+                if (!reader.read(value)) goto truncated;
+                switch (types[arg - 1]) {
+                    case LOG_ARG_LONG:   append(snprintf(dst, remaining, spec, (long)value)); break;
+                    case LOG_ARG_LLONG:  append(snprintf(dst, remaining, spec, (long long)value)); break;
+                    case LOG_ARG_INTMAX: append(snprintf(dst, remaining, spec, (intmax_t)value)); break;
+                    case LOG_ARG_SIZE:   append(snprintf(dst, remaining, spec, (size_t)value)); break;
+                    default:             append(snprintf(dst, remaining, spec, (ptrdiff_t)value)); break;
+                }
+            } break;
+            case LOG_ARG_DOUBLE: {
+                double value;
+                if (!reader.read(value)) goto truncated;
+                append(snprintf(dst, remaining, spec, value));
+            } break;
+            case LOG_ARG_LDOUBLE: {
+                double value;
+                if (!reader.read(value)) goto truncated;
+                append(snprintf(dst, remaining, spec, (long double)value));
+            } break;
+            case LOG_ARG_STRING: {
+                char value[kMaxLogStringSize + 1];
+                if (!reader.read_string(value, sizeof(value))) goto truncated;
+                append(snprintf(dst, remaining, spec, value));
+            } break;
+            case LOG_ARG_POINTER: {
+                uint64_t value;
+                if (!reader.read(value)) goto truncated;
+                append(snprintf(dst, remaining, spec, (void*)(uintptr_t)value));
+            } break;
+            default: goto truncated;
+        }
+    }
+    out[length] = '\0';
+    return length;
+
+truncated:
+    append(snprintf(out + length, capacity - length, "<truncated>"));
+    out[length] = '\0';
+    return length;
+}
+
+// site registry
+// g_log_sites[0] is unused so that a zero id means unregistered
+static LogSiteInfo           g_log_sites[kMaxLogSites];
+static std::atomic<uint32_t> g_log_site_count = 1;
+static std::mutex            g_log_site_mutex;
+
+static uint32_t register_log_site(atom_log_site_t* site, const char* format)
+{
+    std::lock_guard<std::mutex> lock(g_log_site_mutex);
+    std::atomic_ref<uint32_t>   site_id(site->id);
+    if (const uint32_t id = site_id.load(std::memory_order_relaxed)) return id;
+
+    uint32_t       id    = kLogSiteImmediate;
+    const uint32_t index = g_log_site_count.load(std::memory_order_relaxed);
+    if (index < kMaxLogSites) {
+        LogSiteInfo& info = g_log_sites[index];
+        if (parse_log_format(format, info.arg_types, &info.arg_count)) {
+            info.format   = format;
+            info.file     = site->file;
+            info.function = site->function;
+            info.level    = site->level;
+            info.line     = site->line;
+            g_log_site_count.store(index + 1, std::memory_order_release);
+            id = index;
+        }
+    }
+    site_id.store(id, std::memory_order_release);
+    return id;
+}
+
+// per-thread rings
+struct LogRecordHeader {
+    // total size including the header, multiple of 8
+    uint32_t size;
+    uint32_t site;
+    // nanoseconds since the system clock epoch
+    int64_t  time;
+};
+
+// single producer (owning thread) / single consumer (whoever holds the drain mutex)
+struct LogRing {
+    alignas(64) std::atomic<uint64_t> head = 0;
+    uint64_t cached_tail                   = 0;
+    alignas(64) std::atomic<uint64_t> tail = 0;
+    uint8_t*               buffer          = ATOM_NULLPTR;
+    uint64_t               thread_id       = 0;
+    std::atomic<bool>      retired         = false;
+    LogRing*               next            = ATOM_NULLPTR;
+
+    bool push(const void* record, uint32_t size)
+    {
+        const uint64_t h          = head.load(std::memory_order_relaxed);
+        const size_t   pos        = (size_t)(h & (kLogRingSize - 1));
+        const size_t   contiguous = kLogRingSize - pos;
+        const size_t   total      = size + (contiguous < size ? contiguous : 0);
+        if (h + total - cached_tail > kLogRingSize) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h + total - cached_tail > kLogRingSize) return false;
+        }
+        size_t write_pos = pos;
+        if (contiguous < size) {
+            // the remainder is at least 8 bytes since every record is, size + site is all the consumer reads
+            const uint32_t wrap[2] = {(uint32_t)contiguous, kLogRecordWrap};
+            memcpy(buffer + pos, wrap, sizeof(wrap));
+            write_pos = 0;
+        }
+        memcpy(buffer + write_pos, record, size);
+        head.store(h + total, std::memory_order_release);
+        return true;
+    }
+
+    template <typename F>
+    uint32_t drain(F&& consume)
+    {
+        uint32_t       count = 0;
+        uint64_t       t     = tail.load(std::memory_order_relaxed);
+        const uint64_t h     = head.load(std::memory_order_acquire);
+        while (t != h) {
+            const uint8_t* record = buffer + (t & (kLogRingSize - 1));
+            uint32_t       size, site;
+            memcpy(&size, record, sizeof(size));
+            memcpy(&site, record + sizeof(size), sizeof(site));
+            if (site != kLogRecordWrap) {
+                consume(*this, record, size);
+                count++;
+            }
+            t += size;
+            tail.store(t, std::memory_order_release);
+        }
+        return count;
+    }
+};
+
+static std::atomic<LogRing*> g_log_rings = ATOM_NULLPTR;
+
+// the consumer frees retired rings, so once the thread's ring is retired its later logs (from other thread_local
+// destructors or atexit handlers) are formatted immediately instead
+struct ThreadLogRing {
+    LogRing* ring    = ATOM_NULLPTR;
+    bool     retired = false;
+
+    ~ThreadLogRing()
+    {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+        ring    = ATOM_NULLPTR;
+        retired = true;
+    }
+
+    LogRing* get()
+    {
+        if (retired) return ATOM_NULLPTR;
+        if (ring == ATOM_NULLPTR) {
+            ring            = atom_new<LogRing>();
+            ring->buffer    = (uint8_t*)atom_malloc_alignedN(kLogRingSize, 64, kLogRingMemoryPoolName);
+            ring->thread_id = (uint64_t)spdlog::details::os::thread_id();
+            ring->next      = g_log_rings.load(std::memory_order_relaxed);
+            while (!g_log_rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+        return ring;
+    }
+};
+
+static thread_local ThreadLogRing t_log_ring;
+
+static ATOM_FORCEINLINE int64_t system_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// reading the system clock costs about as much as the rest of a deferred call, so producers stamp records with the
+// cycle counter where there is one and the consumer converts it to system time
+#if defined(__x86_64__) || defined(_M_X64)
+static ATOM_FORCEINLINE int64_t log_timestamp() { return (int64_t)__rdtsc(); }
+
+struct LogClock {
+    int64_t tick_base;
+    int64_t time_base;
+    double  ns_per_tick = 1.0;
+
+    void calibrate()
+    {
+        tick_base = log_timestamp();
+        time_base = system_time_ns();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        refine();
+    }
+
+    // the longer the interval since calibrate(), the more precise the ratio
+    void refine()
+    {
+        const int64_t ticks = log_timestamp() - tick_base;
+        const int64_t time  = system_time_ns() - time_base;
+        if (ticks > 0 && time > 0) ns_per_tick = (double)time / (double)ticks;
+    }
+
+    int64_t to_ns(int64_t ticks) const { return time_base + (int64_t)((double)(ticks - tick_base) * ns_per_tick); }
+};
+#else
+static ATOM_FORCEINLINE int64_t log_timestamp() { return system_time_ns(); }
+
+struct LogClock {
+    void    calibrate() {}
+    void    refine() {}
+    int64_t to_ns(int64_t time) const { return time; }
+};
+#endif
+
+// hot path, returns false without touching args if the site has to be formatted immediately
+static bool log_deferred(atom_log_site_t* site, const char* format, va_list args)
+{
+    uint32_t id = std::atomic_ref<uint32_t>(site->id).load(std::memory_order_acquire);
+    if (id == 0) id = register_log_site(site, format);
+    if (id == kLogSiteImmediate) return false;
+    LogRing* ring = t_log_ring.get();
+    if (ring == ATOM_NULLPTR) return false;
+
+    alignas(8) uint8_t record[kMaxLogRecordSize];
+    LogPayloadWriter   writer = {record + sizeof(LogRecordHeader), record + sizeof(record)};
+    encode_log_args(g_log_sites[id], args, writer);
+
+    LogRecordHeader header;
+    header.size = (uint32_t)(((size_t)(writer.cursor - record) + 7) & ~(size_t)7);
+    header.site = id;
+    header.time = log_timestamp();
+    memcpy(record, &header, sizeof(header));
+    if (!ring->push(record, header.size)) g_log_dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// background consumer
+static const char     kLogBinaryMagic[8]    = {'A', 'T', 'O', 'M', 'L', 'O', 'G', '\0'};
+static const uint32_t kLogBinaryVersion     = 1;
+static const uint32_t kLogBinaryChunkSite   = 1;
+static const uint32_t kLogBinaryChunkRecord = 2;
+
+struct DeferredLogBackend {
+    std::mutex              control_mutex;
+    std::mutex              drain_mutex;
+    std::condition_variable wake;
+    std::thread             worker;
+    bool                    running     = false;
+    FILE*                   binary_file = ATOM_NULLPTR;
+    LogClock                clock;
+    std::vector<bool>       written_sites;
+
+    DeferredLogBackend()
+    {
+        // make sure the spdlog registry outlives the backend, pending records are drained on destruction
+        spdlog::details::registry::instance();
+    }
+
+    ~DeferredLogBackend() { stop(); }
+
+    static DeferredLogBackend& instance()
+    {
+        static DeferredLogBackend backend;
+        return backend;
+    }
+
+    void write_site(uint32_t id)
+    {
+        const LogSiteInfo& info          = g_log_sites[id];
+        const uint32_t     file_length   = info.file ? (uint32_t)strlen(info.file) : 0;
+        const uint32_t     func_length   = info.function ? (uint32_t)strlen(info.function) : 0;
+        const uint32_t     format_length = (uint32_t)strlen(info.format);
+        const uint32_t     chunk[8]      = {kLogBinaryChunkSite,
+                                            (uint32_t)(6 * sizeof(uint32_t)) + file_length + func_length + format_length,
+                                            id,
+                                            (uint32_t)info.level,
+                                            (uint32_t)info.line,
+                                            file_length,
+                                            func_length,
+                                            format_length};
+        fwrite(chunk, sizeof(chunk), 1, binary_file);
+        if (file_length) fwrite(info.file, 1, file_length, binary_file);
+        if (func_length) fwrite(info.function, 1, func_length, binary_file);
+        fwrite(info.format, 1, format_length, binary_file);
+    }
+
+    void consume(const LogRing& ring, const uint8_t* record, uint32_t size)
+    {
+        LogRecordHeader header;
+        memcpy(&header, record, sizeof(header));
+        header.time = clock.to_ns(header.time);
+        if (binary_file) {
+            if (!written_sites[header.site]) {
+                write_site(header.site);
+                written_sites[header.site] = true;
+            }
+            const uint32_t chunk[2] = {kLogBinaryChunkRecord, (uint32_t)sizeof(uint64_t) + size};
+            fwrite(chunk, sizeof(chunk), 1, binary_file);
+            fwrite(&ring.thread_id, sizeof(ring.thread_id), 1, binary_file);
+            fwrite(&header, sizeof(header), 1, binary_file);
+            fwrite(record + sizeof(header), size - sizeof(header), 1, binary_file);
+            return;
+        }
+
+        const LogSiteInfo& site   = g_log_sites[header.site];
+        auto*              logger = spdlog::default_logger_raw();
+        const auto         level  = static_cast<spdlog::level::level_enum>(site.level);
+        if (!logger->should_log(level)) return;
+
+        char         message[kMaxLogMessageSize];
+        const size_t length = format_log_record(site.format,
+                                                site.arg_types,
+                                                site.arg_count,
+                                                record + sizeof(LogRecordHeader),
+                                                size - sizeof(LogRecordHeader),
+                                                message,
+                                                sizeof(message));
+        spdlog::details::log_msg msg(
+            spdlog::log_clock::time_point(
+                std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(header.time))),
+            spdlog::source_loc{site.file, site.line, site.function},
+            logger->name(),
+            level,
+            spdlog::string_view_t(message, length));
+        msg.thread_id = (size_t)ring.thread_id;
+        // already on a background thread, so skip the async logger queue and feed its sinks directly
+        for (auto& sink : logger->sinks()) {
+            if (sink->should_log(level)) sink->log(msg);
+        }
+    }
+
+    uint32_t drain_all()
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex);
+        return drain_all_locked();
+    }
+
+    // drain_mutex held
+    uint32_t drain_all_locked()
+    {
+        uint32_t count = 0;
+        clock.refine();
+        LogRing* prev = ATOM_NULLPTR;
+        for (LogRing* ring = g_log_rings.load(std::memory_order_acquire); ring;) {
+            const bool retired = ring->retired.load(std::memory_order_acquire);
+            count += ring->drain(
+                [this](const LogRing& owner, const uint8_t* record, uint32_t size) { consume(owner, record, size); });
+            LogRing* next = ring->next;
+            if (retired && unlink(prev, ring)) {
+                atom_free_alignedN(ring->buffer, 64, kLogRingMemoryPoolName);
+                atom_delete(ring);
+            } else {
+                prev = ring;
+            }
+            ring = next;
+        }
+        return count;
+    }
+
+    // only the head can race with threads registering new rings
+    static bool unlink(LogRing* prev, LogRing* ring)
+    {
+        if (prev) {
+            prev->next = ring->next;
+            return true;
+        }
+        LogRing* expected = ring;
+        if (g_log_rings.compare_exchange_strong(expected, ring->next, std::memory_order_acq_rel)) return true;
+        for (LogRing* node = expected; node; node = node->next) {
+            if (node->next == ring) {
+                node->next = ring->next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(control_mutex);
+        while (running) {
+            lock.unlock();
+            const uint32_t count = drain_all();
+            lock.lock();
+            if (!count) wake.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+
+    bool start(eLogMode mode, const char* binary_path)
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if (mode == ATOM_LOG_MODE_BINARY_FILE) {
+            binary_file = binary_path ? fopen(binary_path, "wb") : ATOM_NULLPTR;
+            if (binary_file == ATOM_NULLPTR) return false;
+            const uint32_t version[2] = {kLogBinaryVersion, 0};
+            fwrite(kLogBinaryMagic, sizeof(kLogBinaryMagic), 1, binary_file);
+            fwrite(version, sizeof(version), 1, binary_file);
+            written_sites.assign(kMaxLogSites, false);
+        }
+        clock.calibrate();
+        running = true;
+        worker  = std::thread([this] { run(); });
+        return true;
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(control_mutex);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_all();
+        worker.join();
+        // a concurrent flush may still be draining into the file
+        std::lock_guard<std::mutex> lock(drain_mutex);
+        drain_all_locked();
+        if (binary_file) {
+            fclose(binary_file);
+            binary_file = ATOM_NULLPTR;
+        }
+    }
+
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex);
+        drain_all_locked();
+        if (binary_file) fflush(binary_file);
+    }
+};
+
+ATOM_EXTERN_C ATOM_API bool atom_log_set_mode(eLogMode mode, const char* binary_path)
+{
+    auto& backend = DeferredLogBackend::instance();
+    // producers keep writing into their rings, the final drain in stop() picks those records up
+    g_log_mode.store(ATOM_LOG_MODE_IMMEDIATE, std::memory_order_relaxed);
+    backend.stop();
+    if (mode == ATOM_LOG_MODE_IMMEDIATE) return true;
+    if (!backend.start(mode, binary_path)) return false;
+    g_log_mode.store(mode, std::memory_order_release);
+    return true;
+}
+
+ATOM_EXTERN_C ATOM_API eLogMode atom_log_get_mode()
+{
+    return static_cast<eLogMode>(g_log_mode.load(std::memory_order_relaxed));
+}
+
+ATOM_EXTERN_C ATOM_API uint64_t atom_log_dropped_count() { return g_log_dropped.load(std::memory_order_relaxed); }
+
+// offline decoder
+ATOM_EXTERN_C ATOM_API bool atom_log_decode_binary(const char* binary_path, const char* text_path)
+{
+    static const char* kLevelNames[] = {"trace", "debug", "info", "warning", "error", "critical"};
+
+    struct DecodedSite {
+        LogSiteInfo info;
+        std::string file;
+        std::string function;
+        std::string format;
+        bool        valid = false;
+    };
+
+    FILE* in = fopen(binary_path, "rb");
+    if (in == ATOM_NULLPTR) return false;
+    char     magic[sizeof(kLogBinaryMagic)];
+    uint32_t version[2];
+    if (fread(magic, sizeof(magic), 1, in) != 1 || memcmp(magic, kLogBinaryMagic, sizeof(magic))
+        || fread(version, sizeof(version), 1, in) != 1 || version[0] != kLogBinaryVersion) {
+        fclose(in);
+        return false;
+    }
+    FILE* out = fopen(text_path, "w");
+    if (out == ATOM_NULLPTR) {
+        fclose(in);
+        return false;
+    }
+
+    std::vector<DecodedSite> sites;
+    std::vector<uint8_t>     chunk;
+    char                     message[kMaxLogMessageSize];
+    uint32_t                 chunk_header[2];
+    bool                     ok = true;
+    while (fread(chunk_header, sizeof(chunk_header), 1, in) == 1) {
+        chunk.resize(chunk_header[1]);
+        if (chunk_header[1] && fread(chunk.data(), chunk_header[1], 1, in) != 1) {
+            ok = false;
+            break;
+        }
+        if (chunk_header[0] == kLogBinaryChunkSite && chunk.size() >= 6 * sizeof(uint32_t)) {
+            uint32_t fields[6];
+            memcpy(fields, chunk.data(), sizeof(fields));
+            const size_t strings = (size_t)fields[3] + fields[4] + fields[5];
+            if (fields[0] >= kMaxLogSites || sizeof(fields) + strings > chunk.size()) continue;
+            if (sites.size() <= fields[0]) sites.resize(fields[0] + 1);
+            DecodedSite& site = sites[fields[0]];
+            const char*  str  = (const char*)chunk.data() + sizeof(fields);
+            site.file.assign(str, fields[3]);
+            site.function.assign(str + fields[3], fields[4]);
+            site.format.assign(str + fields[3] + fields[4], fields[5]);
+            site.info.level = (int32_t)fields[1];
+            site.info.line  = (int32_t)fields[2];
+            site.valid      = parse_log_format(site.format.c_str(), site.info.arg_types, &site.info.arg_count);
+        } else if (chunk_header[0] == kLogBinaryChunkRecord && chunk.size() >= sizeof(uint64_t) + sizeof(LogRecordHeader)) {
+            uint64_t        thread_id;
+            LogRecordHeader header;
+            memcpy(&thread_id, chunk.data(), sizeof(thread_id));
+            memcpy(&header, chunk.data() + sizeof(thread_id), sizeof(header));
+            if (header.site >= sites.size() || !sites[header.site].valid) continue;
+            const DecodedSite& site    = sites[header.site];
+            const size_t       payload = chunk.size() - sizeof(thread_id) - sizeof(header);
+            format_log_record(site.format.c_str(),
+                              site.info.arg_types,
+                              site.info.arg_count,
+                              chunk.data() + sizeof(thread_id) + sizeof(header),
+                              payload,
+                              message,
+                              sizeof(message));
+
+            const time_t seconds = (time_t)(header.time / 1000000000);
+            char         time_text[32];
+            strftime(time_text, sizeof(time_text), "%Y-%m-%d %H:%M:%S", localtime(&seconds));
+            const int level = site.info.level >= 0 && site.info.level < 6 ? site.info.level : 5;
+            fprintf(out,
+                    "[%s.%03d][tid:%llu] %s: %s\n [In %s At %s:%d]\n",
+                    time_text,
+                    (int)((header.time / 1000000) % 1000),
+                    (unsigned long long)thread_id,
+                    kLevelNames[level],
+                    message,
+                    site.function.c_str(),
+                    site.file.c_str(),
+                    site.info.line);
+        }
+    }
+    fclose(out);
+    fclose(in);
+    return ok;
+}
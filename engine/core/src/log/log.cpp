@@ -1,28 +1,102 @@
-#include <source_location>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
 
 #include <atomCore/log/log.h>
 #include <atomCore/log/manager.hpp>
 
-ATOM_EXTERN_C ATOM_API void atom_log_set_level(eLogLevel level)
+static void log_immediate(int level, const char* file, int line, const char* function, const char* format, va_list args)
 {
-    spdlog::set_level(static_cast<spdlog::level::level_enum>(level));
+    // most messages fit into the stack buffer, longer ones are formatted again into a heap string
+    char    buffer[1024];
+    va_list copy;
+    va_copy(copy, args);
+    const int length = vsnprintf(buffer, sizeof(buffer), format, copy);
+    va_end(copy);
+    if (length < 0) return;
+
+    const spdlog::source_loc location{file, line, function};
+    const auto               lvl = static_cast<spdlog::level::level_enum>(level);
+    if ((size_t)length < sizeof(buffer)) {
+        spdlog::default_logger_raw()->log(location, lvl, spdlog::string_view_t(buffer, (size_t)length));
+    } else {
+        std::string message((size_t)length, '\0');
+        vsnprintf(message.data(), message.size() + 1, format, args);
+        spdlog::default_logger_raw()->log(location, lvl, spdlog::string_view_t(message));
+    }
+}
+
+static const char* kLogCategoryNames[] = {"core", "memory", "graphics", "vulkan-validation"};
+static_assert(sizeof(kLogCategoryNames) / sizeof(kLogCategoryNames[0]) == ATOM_LOG_CATEGORY_COUNT);
+
+// the per category thresholds decide what gets logged, the spdlog level only follows the lowest of them
+static std::atomic<int> g_log_category_levels[ATOM_LOG_CATEGORY_COUNT] = {ATOM_LOG_LEVEL_INFO,
+                                                                          ATOM_LOG_LEVEL_INFO,
+                                                                          ATOM_LOG_LEVEL_INFO,
+                                                                          ATOM_LOG_LEVEL_INFO};
+static std::mutex       g_log_category_mutex;
+
+static ATOM_FORCEINLINE bool should_log(int category, int level)
+{
+    return level >= g_log_category_levels[category].load(std::memory_order_relaxed) && level < ATOM_LOG_LEVEL_OFF;
 }
 
+static void update_category_levels(int first, int last, eLogLevel level)
+{
+    std::lock_guard<std::mutex> lock(g_log_category_mutex);
+    for (int i = first; i < last; i++) g_log_category_levels[i].store(level, std::memory_order_relaxed);
+    int lowest = ATOM_LOG_LEVEL_OFF;
+    for (const auto& threshold : g_log_category_levels) {
+        const int value = threshold.load(std::memory_order_relaxed);
+        if (value < lowest) lowest = value;
+    }
+    spdlog::set_level(static_cast<spdlog::level::level_enum>(lowest));
+}
+
+ATOM_EXTERN_C ATOM_API void atom_log_set_level(eLogLevel level) { update_category_levels(0, ATOM_LOG_CATEGORY_COUNT, level); }
+
+ATOM_EXTERN_C ATOM_API void atom_log_set_category_level(eLogCategory category, eLogLevel level)
+{
+    atom_assert(category < ATOM_LOG_CATEGORY_COUNT);
+    update_category_levels(category, category + 1, level);
+}
+
+ATOM_EXTERN_C ATOM_API eLogLevel atom_log_get_category_level(eLogCategory category)
+{
+    return static_cast<eLogLevel>(g_log_category_levels[category].load(std::memory_order_relaxed));
+}
+
+ATOM_EXTERN_C ATOM_API const char* atom_log_category_name(eLogCategory category) { return kLogCategoryNames[category]; }
+
 ATOM_EXTERN_C ATOM_API void atom_log_flush()
 {
+    // pending deferred records are handed to the sinks first so that flushing the loggers covers them
+    DeferredLogBackend::instance().flush();
     spdlog::apply_all([](std::shared_ptr<Logger> logger) -> void { logger->flush(); });
 }
 
+// call sites compiled against the old macros carry no source location and log as core
 ATOM_EXTERN_C ATOM_API void atom_log_log(int level, ...)
 {
-    if (level < static_cast<int>(spdlog::get_level()) || level >= static_cast<int>(SPDLOG_LEVEL_OFF)) return;
+    if (!should_log(ATOM_LOG_CATEGORY_CORE, level)) return;
 
     va_list va_args;
     va_start(va_args, level);
-    spdlog::log(spdlog::source_loc{std::source_location::current().file_name(),
-                                   static_cast<int>(std::source_location::current().line()),
-                                   std::source_location::current().function_name()},
-                static_cast<spdlog::level::level_enum>(level),
-                va_args);
+    const char* format = va_arg(va_args, const char*);
+    log_immediate(level, ATOM_NULLPTR, 0, ATOM_NULLPTR, format, va_args);
+    va_end(va_args);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_log_log_site(atom_log_site_t* site, ...)
+{
+    if (!should_log(site->category, site->level)) return;
+
+    va_list va_args;
+    va_start(va_args, site);
+    const char* format = va_arg(va_args, const char*);
+    if (atom_log_get_mode() == ATOM_LOG_MODE_IMMEDIATE || !log_deferred(site, format, va_args)) {
+        log_immediate(site->level, site->file, site->line, site->function, format, va_args);
+    }
     va_end(va_args);
 }
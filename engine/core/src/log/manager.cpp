@@ -1,6 +1,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/daily_file_sink.h>
 
+#include <atomCore/log/log.h>
 #include <atomCore/log/manager.hpp>
 
 enum class eConsoleColor : uint8_t { black, red, green, yellow, blue, magenta, cyan, white };
@@ -205,6 +206,8 @@ LogManager::LogManager() ATOM_NOEXCEPT {}
 
 LogManager::~LogManager() ATOM_NOEXCEPT
 {
+    // drain deferred records while the sinks are still alive
+    atom_log_set_mode(ATOM_LOG_MODE_IMMEDIATE, ATOM_NULLPTR);
     spdlog::drop_all();
     spdlog::shutdown();
 }
@@ -0,0 +1,490 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <atomCore/memory.h>
+
+// system backend
+static void* system_malloc(size_t size) { return ::malloc(size); }
+
+static void* system_calloc(size_t count, size_t size) { return ::calloc(count, size); }
+
+static void* system_realloc(void* ptr, size_t size) { return ::realloc(ptr, size); }
+
+static void system_free(void* ptr) { ::free(ptr); }
+
+static size_t system_usable_size(void* ptr)
+{
+#if defined(_WIN32)
+    return ::_msize(ptr);
+#elif defined(__APPLE__)
+    return ::malloc_size(ptr);
+#else
+    return ::malloc_usable_size(ptr);
+#endif
+}
+
+static void* system_malloc_aligned(size_t size, size_t alignment)
+{
+#if defined(_WIN32)
+    return ::_aligned_malloc(size, alignment);
+#else
+    // posix_memalign requires a power of two multiple of sizeof(void*)
+    void* memory = ATOM_NULLPTR;
+    if (::posix_memalign(&memory, atom_max(alignment, sizeof(void*)), size ? size : 1) != 0) return ATOM_NULLPTR;
+    return memory;
+#endif
+}
+
+static void* system_calloc_aligned(size_t count, size_t size, size_t alignment)
+{
+    if (size && count > SIZE_MAX / size) return ATOM_NULLPTR;
+    void* memory = system_malloc_aligned(count * size, alignment);
+    if (memory != ATOM_NULLPTR) ::memset(memory, 0, count * size);
+    return memory;
+}
+
+static void* system_realloc_aligned(void* ptr, size_t size, size_t alignment)
+{
+#if defined(_WIN32)
+    return ::_aligned_realloc(ptr, size, alignment);
+#else
+    if (ptr == ATOM_NULLPTR) return system_malloc_aligned(size, alignment);
+    if (size == 0) {
+        ::free(ptr);
+        return ATOM_NULLPTR;
+    }
+    // realloc already guarantees fundamental alignment
+    if (alignment <= alignof(std::max_align_t)) return ::realloc(ptr, size);
+
+    const size_t old_size = system_usable_size(ptr);
+    if (old_size >= size && ((uintptr_t)ptr & (alignment - 1)) == 0) return ptr;
+    void* memory = system_malloc_aligned(size, alignment);
+    if (memory != ATOM_NULLPTR) {
+        ::memcpy(memory, ptr, atom_min(old_size, size));
+        ::free(ptr);
+    }
+    return memory;
+#endif
+}
+
+static void system_free_aligned(void* ptr)
+{
+#if defined(_WIN32)
+    ::_aligned_free(ptr);
+#else
+    ::free(ptr);
+#endif
+}
+
+static const atom_allocator_t kSystemAllocator = {.name               = "system",
+                                                  .malloc_fn          = &system_malloc,
+                                                  .calloc_fn          = &system_calloc,
+                                                  .realloc_fn         = &system_realloc,
+                                                  .free_fn            = &system_free,
+                                                  .malloc_aligned_fn  = &system_malloc_aligned,
+                                                  .calloc_aligned_fn  = &system_calloc_aligned,
+                                                  .realloc_aligned_fn = &system_realloc_aligned,
+                                                  .free_aligned_fn    = &system_free_aligned};
+
+// thread cached backend
+// every block lives inside a span aligned to kSpanSize, so the owning span header is found by masking the pointer.
+// small blocks are carved out of spans dedicated to one size class; large blocks get a span of their own.
+// freed small blocks go to the calling thread's cache first and spill half of it to the central list when full.
+static constexpr size_t   kSpanSize           = 64 * 1024;
+static constexpr size_t   kSpanHeaderSize     = 128;
+static constexpr uint32_t kSizeClassCount     = 32;
+static constexpr size_t   kMaxSmallSize       = 8192;
+static constexpr uint32_t kLargeClass         = UINT32_MAX;
+static constexpr size_t   kThreadCacheBytes   = 64 * 1024;
+static constexpr uint32_t kThreadCacheMinimum = 16;
+static constexpr uint32_t kThreadCacheMaximum = 512;
+
+struct SpanHeader {
+    uint32_t size_class;
+    // user pointer offset of large blocks
+    uint32_t offset;
+    // block size for small spans, requested size for large spans
+    size_t   size;
+};
+
+atom_static_assert(sizeof(SpanHeader) <= kSpanHeaderSize, "span header overflows its reserved bytes");
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// 16 - 128 in steps of 16, then four classes per power of two up to kMaxSmallSize
+static constexpr size_t size_class_to_size(uint32_t size_class)
+{
+    if (size_class < 8) return (size_class + 1) * 16;
+    const uint32_t group = (size_class - 8) / 4;
+    return ((size_t)128 << group) + ((size_class - 8) % 4 + 1) * ((size_t)32 << group);
+}
+
+atom_static_assert(size_class_to_size(kSizeClassCount - 1) == kMaxSmallSize, "size class table mismatch");
+
+static inline uint32_t size_to_size_class(size_t size)
+{
+    if (size <= 128) return size ? (uint32_t)((size + 15) / 16 - 1) : 0;
+    uint32_t shift = 0;
+    for (size_t v = size - 1; v > 1; v >>= 1) ++shift;
+    return 8 + (shift - 7) * 4 + (uint32_t)(((size - 1) - ((size_t)1 << shift)) >> (shift - 2));
+}
+
+static inline uint32_t thread_cache_limit(uint32_t size_class)
+{
+    const size_t limit = kThreadCacheBytes / size_class_to_size(size_class);
+    return (uint32_t)atom_min(atom_max(limit, (size_t)kThreadCacheMinimum), (size_t)kThreadCacheMaximum);
+}
+
+static inline SpanHeader* span_of(void* ptr) { return (SpanHeader*)((uintptr_t)ptr & ~(uintptr_t)(kSpanSize - 1)); }
+
+struct alignas(64) CentralFreeList {
+    std::atomic_flag lock  = ATOMIC_FLAG_INIT;
+    FreeBlock*       head  = ATOM_NULLPTR;
+    uint32_t         count = 0;
+
+    void acquire()
+    {
+        while (lock.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    void release() { lock.clear(std::memory_order_release); }
+};
+
+static CentralFreeList g_central_lists[kSizeClassCount];
+
+static void central_push(uint32_t size_class, FreeBlock* first, FreeBlock* last, uint32_t count)
+{
+    CentralFreeList& central = g_central_lists[size_class];
+    central.acquire();
+    last->next     = central.head;
+    central.head   = first;
+    central.count += count;
+    central.release();
+}
+
+// carves a fresh span, returns the first block and pushes the remainder to `out_list`
+static FreeBlock* carve_span(uint32_t size_class, FreeBlock** out_list, uint32_t* out_count)
+{
+    SpanHeader* span = (SpanHeader*)system_malloc_aligned(kSpanSize, kSpanSize);
+    if (span == ATOM_NULLPTR) return ATOM_NULLPTR;
+    const size_t block_size = size_class_to_size(size_class);
+    span->size_class        = size_class;
+    span->offset            = (uint32_t)kSpanHeaderSize;
+    span->size              = block_size;
+
+    uint8_t*       base        = (uint8_t*)span + kSpanHeaderSize;
+    const uint32_t block_count = (uint32_t)((kSpanSize - kSpanHeaderSize) / block_size);
+    FreeBlock*     head        = ATOM_NULLPTR;
+    for (uint32_t i = block_count - 1; i > 0; --i) {
+        FreeBlock* block = (FreeBlock*)(base + i * block_size);
+        block->next      = head;
+        head             = block;
+    }
+    *out_list  = head;
+    *out_count = block_count - 1;
+    return (FreeBlock*)base;
+}
+
+struct ThreadCache {
+    FreeBlock* lists[kSizeClassCount]  = {};
+    uint32_t   counts[kSizeClassCount] = {};
+    bool       destroyed               = false;
+
+    ~ThreadCache()
+    {
+        for (uint32_t c = 0; c < kSizeClassCount; ++c) {
+            if (lists[c] == ATOM_NULLPTR) continue;
+            FreeBlock* last = lists[c];
+            while (last->next) last = last->next;
+            central_push(c, lists[c], last, counts[c]);
+            lists[c]  = ATOM_NULLPTR;
+            counts[c] = 0;
+        }
+        // late frees from other thread_local destructors go straight to the central lists
+        destroyed = true;
+    }
+
+    void* allocate(uint32_t size_class)
+    {
+        if (FreeBlock* block = lists[size_class]) {
+            lists[size_class] = block->next;
+            --counts[size_class];
+            return block;
+        }
+        return refill(size_class);
+    }
+
+    void* refill(uint32_t size_class)
+    {
+        const uint32_t   limit   = thread_cache_limit(size_class);
+        CentralFreeList& central = g_central_lists[size_class];
+        central.acquire();
+        if (central.head != ATOM_NULLPTR) {
+            // take a batch of up to half the cache limit
+            FreeBlock* first = central.head;
+            FreeBlock* last  = first;
+            uint32_t   taken = 1;
+            while (taken < limit / 2 && last->next) {
+                last = last->next;
+                ++taken;
+            }
+            central.head   = last->next;
+            central.count -= taken;
+            central.release();
+            last->next = ATOM_NULLPTR;
+            if (!destroyed) {
+                lists[size_class]   = first->next;
+                counts[size_class] += taken - 1;
+            } else if (first->next) {
+                central_push(size_class, first->next, last, taken - 1);
+            }
+            return first;
+        }
+        central.release();
+
+        FreeBlock* rest       = ATOM_NULLPTR;
+        uint32_t   rest_count = 0;
+        FreeBlock* block      = carve_span(size_class, &rest, &rest_count);
+        if (block == ATOM_NULLPTR || rest == ATOM_NULLPTR) return block;
+        // keep up to the cache limit locally, the rest is shared with other threads
+        uint32_t   kept = destroyed ? 0 : atom_min(rest_count, limit);
+        FreeBlock* tail = rest;
+        if (kept) {
+            for (uint32_t i = 1; i < kept; ++i) tail = tail->next;
+            FreeBlock* spill    = tail->next;
+            tail->next          = lists[size_class];
+            lists[size_class]   = rest;
+            counts[size_class] += kept;
+            rest                = spill;
+        }
+        if (rest != ATOM_NULLPTR) {
+            FreeBlock* last = rest;
+            while (last->next) last = last->next;
+            central_push(size_class, rest, last, rest_count - kept);
+        }
+        return block;
+    }
+
+    void deallocate(uint32_t size_class, void* ptr)
+    {
+        FreeBlock* block = (FreeBlock*)ptr;
+        if (destroyed) {
+            block->next = ATOM_NULLPTR;
+            central_push(size_class, block, block, 1);
+            return;
+        }
+        block->next       = lists[size_class];
+        lists[size_class] = block;
+        if (++counts[size_class] < thread_cache_limit(size_class)) return;
+
+        // spill the older half of the cache
+        const uint32_t keep = counts[size_class] / 2;
+        FreeBlock*     last = lists[size_class];
+        for (uint32_t i = 1; i < keep; ++i) last = last->next;
+        FreeBlock* spill = last->next;
+        last->next       = ATOM_NULLPTR;
+        FreeBlock* tail  = spill;
+        while (tail->next) tail = tail->next;
+        central_push(size_class, spill, tail, counts[size_class] - keep);
+        counts[size_class] = keep;
+    }
+};
+
+static thread_local ThreadCache t_thread_cache;
+
+static void* cached_malloc_large(size_t size, size_t alignment)
+{
+    atom_assert(alignment < kSpanSize && "thread cached allocator: alignment must be smaller than a span!");
+    const size_t offset = atom_max(kSpanHeaderSize, alignment);
+    if (size > SIZE_MAX - offset) return ATOM_NULLPTR;
+    SpanHeader* span = (SpanHeader*)system_malloc_aligned(offset + size, kSpanSize);
+    if (span == ATOM_NULLPTR) return ATOM_NULLPTR;
+    span->size_class = kLargeClass;
+    span->offset     = (uint32_t)offset;
+    span->size       = size;
+    return (uint8_t*)span + offset;
+}
+
+// returns kLargeClass if no size class satisfies both size and alignment
+static inline uint32_t aligned_size_class(size_t size, size_t alignment)
+{
+    if (alignment > kSpanHeaderSize) return kLargeClass;
+    size = atom_round_up(atom_max(size, (size_t)1), alignment);
+    if (size > kMaxSmallSize) return kLargeClass;
+    for (uint32_t c = size_to_size_class(size); c < kSizeClassCount; ++c) {
+        if (size_class_to_size(c) % alignment == 0) return c;
+    }
+    return kLargeClass;
+}
+
+static void* cached_malloc_aligned(size_t size, size_t alignment)
+{
+    const uint32_t size_class = aligned_size_class(size, alignment ? alignment : 1);
+    if (size_class == kLargeClass) return cached_malloc_large(size, alignment);
+    return t_thread_cache.allocate(size_class);
+}
+
+static void* cached_malloc(size_t size) { return cached_malloc_aligned(size, alignof(std::max_align_t)); }
+
+static void* cached_calloc_aligned(size_t count, size_t size, size_t alignment)
+{
+    if (size && count > SIZE_MAX / size) return ATOM_NULLPTR;
+    void* memory = cached_malloc_aligned(count * size, alignment);
+    if (memory != ATOM_NULLPTR) ::memset(memory, 0, count * size);
+    return memory;
+}
+
+static void* cached_calloc(size_t count, size_t size)
+{
+    return cached_calloc_aligned(count, size, alignof(std::max_align_t));
+}
+
+static void cached_free(void* ptr)
+{
+    if (ptr == ATOM_NULLPTR) return;
+    SpanHeader* span = span_of(ptr);
+    if (span->size_class == kLargeClass) {
+        system_free_aligned(span);
+    } else {
+        t_thread_cache.deallocate(span->size_class, ptr);
+    }
+}
+
+static void* cached_realloc_aligned(void* ptr, size_t size, size_t alignment)
+{
+    if (ptr == ATOM_NULLPTR) return cached_malloc_aligned(size, alignment);
+    if (size == 0) {
+        cached_free(ptr);
+        return ATOM_NULLPTR;
+    }
+    SpanHeader*  span     = span_of(ptr);
+    const size_t old_size = span->size;
+    if (size <= old_size && ((uintptr_t)ptr & (alignment - 1)) == 0) {
+        // shrink large blocks in place by forgetting the tail, small blocks keep their class
+        if (span->size_class == kLargeClass) span->size = size;
+        return ptr;
+    }
+    void* memory = cached_malloc_aligned(size, alignment);
+    if (memory != ATOM_NULLPTR) {
+        ::memcpy(memory, ptr, atom_min(old_size, size));
+        cached_free(ptr);
+    }
+    return memory;
+}
+
+static void* cached_realloc(void* ptr, size_t size)
+{
+    return cached_realloc_aligned(ptr, size, alignof(std::max_align_t));
+}
+
+static const atom_allocator_t kThreadCachedAllocator = {.name               = "thread_cached",
+                                                        .malloc_fn          = &cached_malloc,
+                                                        .calloc_fn          = &cached_calloc,
+                                                        .realloc_fn         = &cached_realloc,
+                                                        .free_fn            = &cached_free,
+                                                        .malloc_aligned_fn  = &cached_malloc_aligned,
+                                                        .calloc_aligned_fn  = &cached_calloc_aligned,
+                                                        .realloc_aligned_fn = &cached_realloc_aligned,
+                                                        .free_aligned_fn    = &cached_free};
+
+// dispatch
+static std::atomic<const atom_allocator_t*> g_allocator = ATOM_NULLPTR;
+static eAtomAllocatorBackend                 g_backend   = ATOM_ALLOCATOR_BACKEND_SYSTEM;
+
+static const atom_allocator_t* builtin_allocator(eAtomAllocatorBackend backend)
+{
+    switch (backend) {
+        case ATOM_ALLOCATOR_BACKEND_SYSTEM:        return &kSystemAllocator;
+        case ATOM_ALLOCATOR_BACKEND_THREAD_CACHED: return &kThreadCachedAllocator;
+        default:                                   return ATOM_NULLPTR;
+    }
+}
+
+static bool try_install_allocator(eAtomAllocatorBackend backend, const atom_allocator_t* allocator)
+{
+    const atom_allocator_t* expected = ATOM_NULLPTR;
+    if (g_allocator.compare_exchange_strong(expected, allocator, std::memory_order_acq_rel)) {
+        g_backend = backend;
+        return true;
+    }
+    return expected == allocator;
+}
+
+static const atom_allocator_t* resolve_allocator_slow()
+{
+    eAtomAllocatorBackend backend = ATOM_ALLOCATOR_BACKEND_SYSTEM;
+    if (const char* env = ::getenv("ATOM_ALLOCATOR")) {
+        if (::strcmp(env, "thread_cached") == 0) backend = ATOM_ALLOCATOR_BACKEND_THREAD_CACHED;
+    }
+    try_install_allocator(backend, builtin_allocator(backend));
+    return g_allocator.load(std::memory_order_acquire);
+}
+
+static inline const atom_allocator_t* resolve_allocator()
+{
+    const atom_allocator_t* allocator = g_allocator.load(std::memory_order_acquire);
+    return allocator ? allocator : resolve_allocator_slow();
+}
+
+ATOM_EXTERN_C ATOM_API bool atom_initialize_allocator(eAtomAllocatorBackend backend, const atom_allocator_t* custom)
+{
+    const atom_allocator_t* allocator = backend == ATOM_ALLOCATOR_BACKEND_CUSTOM ? custom : builtin_allocator(backend);
+    atom_assert(allocator && "fatal: unknown allocator backend!");
+    if (allocator == ATOM_NULLPTR) return false;
+    atom_assert(allocator->malloc_fn && allocator->calloc_fn && allocator->realloc_fn && allocator->free_fn
+                && "fatal: custom allocator misses basic procs!");
+    atom_assert(allocator->malloc_aligned_fn && allocator->calloc_aligned_fn && allocator->realloc_aligned_fn
+                && allocator->free_aligned_fn && "fatal: custom allocator misses aligned procs!");
+    return try_install_allocator(backend, allocator);
+}
+
+ATOM_EXTERN_C ATOM_API const atom_allocator_t* atom_get_allocator() { return resolve_allocator(); }
+
+ATOM_EXTERN_C ATOM_API eAtomAllocatorBackend atom_get_allocator_backend()
+{
+    resolve_allocator();
+    return g_backend;
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_impl(size_t size) { return resolve_allocator()->malloc_fn(size); }
+
+ATOM_EXTERN_C ATOM_API void* atom_calloc_impl(size_t count, size_t size)
+{
+    return resolve_allocator()->calloc_fn(count, size);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_realloc_impl(void* ptr, size_t size)
+{
+    return resolve_allocator()->realloc_fn(ptr, size);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_free_impl(void* ptr) { resolve_allocator()->free_fn(ptr); }
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_aligned_impl(size_t size, size_t alignment)
+{
+    return resolve_allocator()->malloc_aligned_fn(size, alignment);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_calloc_aligned_impl(size_t count, size_t size, size_t alignment)
+{
+    return resolve_allocator()->calloc_aligned_fn(count, size, alignment);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_realloc_aligned_impl(void* ptr, size_t size, size_t alignment)
+{
+    return resolve_allocator()->realloc_aligned_fn(ptr, size, alignment);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_free_aligned_impl(void* ptr) { resolve_allocator()->free_aligned_fn(ptr); }
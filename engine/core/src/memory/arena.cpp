@@ -0,0 +1,180 @@
+#include <atomic>
+
+#include <atomCore/memory.h>
+#include <atomCore/log.h>
+
+static constexpr size_t kFrameArenaChunkSize      = 64 * 1024;
+static constexpr size_t kFrameArenaChunkAlignment = 64;
+static const char*      kFrameArenaMemoryPoolName = "atom::frame_arena";
+
+struct alignas(kFrameArenaChunkAlignment) FrameArenaChunk {
+    FrameArenaChunk* next;
+    size_t           capacity;
+    size_t           used;
+};
+
+static ATOM_FORCEINLINE uint8_t* chunk_data(FrameArenaChunk* chunk) { return (uint8_t*)(chunk + 1); }
+
+// chunks are kept on rewind/reset and reused in order, so a steady workload stops allocating after warming up
+struct FrameArena {
+    FrameArenaChunk* head    = ATOM_NULLPTR;
+    FrameArenaChunk* current = ATOM_NULLPTR;
+
+    void* alloc(size_t size, size_t alignment)
+    {
+        for (FrameArenaChunk* chunk = current ? current : head; chunk; chunk = chunk->next) {
+            const uintptr_t base    = (uintptr_t)chunk_data(chunk);
+            const uintptr_t aligned = (base + chunk->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            if (aligned + size <= base + chunk->capacity) {
+                chunk->used = aligned + size - base;
+                current     = chunk;
+                return (void*)aligned;
+            }
+            // skipped chunks stay empty until the next rewind
+            if (chunk->next) chunk->next->used = 0;
+        }
+        return grow(size, alignment);
+    }
+
+    void* grow(size_t size, size_t alignment)
+    {
+        const size_t     needed   = size + (alignment > kFrameArenaChunkAlignment ? alignment : 0);
+        const size_t     capacity = needed > kFrameArenaChunkSize ? needed : kFrameArenaChunkSize;
+        FrameArenaChunk* chunk    = (FrameArenaChunk*)atom_malloc_alignedN(
+            sizeof(FrameArenaChunk) + capacity, kFrameArenaChunkAlignment, kFrameArenaMemoryPoolName);
+        chunk->next     = ATOM_NULLPTR;
+        chunk->capacity = capacity;
+        chunk->used     = 0;
+        if (!head) {
+            head = chunk;
+        } else {
+            FrameArenaChunk* tail = current ? current : head;
+            while (tail->next) tail = tail->next;
+            tail->next = chunk;
+        }
+        current                 = chunk;
+        const uintptr_t base    = (uintptr_t)chunk_data(chunk);
+        const uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        chunk->used             = aligned + size - base;
+        return (void*)aligned;
+    }
+
+    void reset()
+    {
+        if (head) head->used = 0;
+        current = head;
+    }
+
+    void release()
+    {
+        for (FrameArenaChunk* chunk = head; chunk;) {
+            FrameArenaChunk* next = chunk->next;
+            atom_free_alignedN(chunk, kFrameArenaChunkAlignment, kFrameArenaMemoryPoolName);
+            chunk = next;
+        }
+        head = current = ATOM_NULLPTR;
+    }
+};
+
+// frame bookkeeping
+// g_retired_frames holds (last retired frame + 1) so that 0 means nothing has retired yet
+static std::atomic<uint64_t> g_current_frame    = 0;
+static std::atomic<uint64_t> g_retired_frames   = 0;
+static std::atomic<uint32_t> g_frames_in_flight = 2;
+
+struct ThreadFrameArenas {
+    FrameArena arenas[ATOM_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT];
+    uint64_t   frames[ATOM_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT] = {};
+    bool       warned                                        = false;
+
+    ~ThreadFrameArenas()
+    {
+        for (auto& arena : arenas) arena.release();
+    }
+
+    // returns the arena of the current frame, rewinding it if the frame it served last has completed
+    FrameArena& acquire(uint64_t frame, uint32_t slot)
+    {
+        FrameArena& arena = arenas[slot];
+        if (frames[slot] != frame) {
+            if (frames[slot] < g_retired_frames.load(std::memory_order_acquire)) {
+                arena.reset();
+            } else if (arena.head && !warned) {
+                // keep appending, the memory is reclaimed once a later frame of this slot retires
+                ATOM_warn(u8"frame arena: frame %llu reuses slot %u before frame %llu retired",
+                          (unsigned long long)frame,
+                          slot,
+                          (unsigned long long)frames[slot]);
+                warned = true;
+            }
+            frames[slot] = frame;
+        }
+        return arena;
+    }
+};
+
+static thread_local ThreadFrameArenas t_frame_arenas;
+
+static ATOM_FORCEINLINE uint32_t frame_slot(uint64_t frame)
+{
+    return (uint32_t)(frame % g_frames_in_flight.load(std::memory_order_relaxed));
+}
+
+void atom_frame_arena_set_frames_in_flight(uint32_t count)
+{
+    atom_assert(count > 0 && count <= ATOM_FRAME_ARENA_MAX_FRAMES_IN_FLIGHT);
+    g_frames_in_flight.store(count, std::memory_order_relaxed);
+}
+
+uint32_t atom_frame_arena_get_frames_in_flight() { return g_frames_in_flight.load(std::memory_order_relaxed); }
+
+uint64_t atom_frame_arena_begin_frame() { return g_current_frame.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+uint64_t atom_frame_arena_current_frame() { return g_current_frame.load(std::memory_order_acquire); }
+
+void atom_frame_arena_retire(uint64_t frame)
+{
+    const uint64_t retire  = frame + 1;
+    uint64_t       retired = g_retired_frames.load(std::memory_order_relaxed);
+    while (retire > retired
+           && !g_retired_frames.compare_exchange_weak(retired, retire, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+uint64_t atom_frame_arena_retired_frames() { return g_retired_frames.load(std::memory_order_acquire); }
+
+void* atom_frame_alloc(size_t size, size_t alignment)
+{
+    atom_assert(alignment && !(alignment & (alignment - 1)) && "frame arena: alignment must be a power of two!");
+    if (!size) size = 1;
+    const uint64_t frame = atom_frame_arena_current_frame();
+    return t_frame_arenas.acquire(frame, frame_slot(frame)).alloc(size, alignment);
+}
+
+void* atom_frame_calloc(size_t count, size_t size, size_t alignment)
+{
+    void* ptr = atom_frame_alloc(count * size, alignment);
+    memset(ptr, 0, count * size);
+    return ptr;
+}
+
+atom_frame_arena_marker_t atom_frame_arena_mark()
+{
+    const uint64_t            frame  = atom_frame_arena_current_frame();
+    FrameArena&               arena  = t_frame_arenas.acquire(frame, frame_slot(frame));
+    atom_frame_arena_marker_t marker = {frame, arena.current, arena.current ? arena.current->used : 0};
+    return marker;
+}
+
+void atom_frame_arena_rewind(atom_frame_arena_marker_t marker)
+{
+    // a frame boundary in between means the scratch now belongs to an older frame, which gets reset on its own
+    if (marker.frame != atom_frame_arena_current_frame()) return;
+    FrameArena& arena = t_frame_arenas.arenas[frame_slot(marker.frame)];
+    if (marker.chunk) {
+        FrameArenaChunk* chunk = (FrameArenaChunk*)marker.chunk;
+        chunk->used            = marker.offset;
+        arena.current          = chunk;
+    } else {
+        arena.reset();
+    }
+}
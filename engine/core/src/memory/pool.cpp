@@ -0,0 +1,114 @@
+#include <atomic>
+
+#include <atomCore/memory.h>
+#include <atomCore/log.h>
+
+static constexpr size_t kObjectPoolSlotAlignment = 64;
+static constexpr size_t kObjectPoolSlabSize      = 64 * 1024;
+// slab header is padded to a full cache line so that every slot behind it stays aligned
+static constexpr size_t kObjectPoolSlabHeaderSize = kObjectPoolSlotAlignment;
+
+struct ObjectPoolSlab {
+    ObjectPoolSlab* next;
+};
+
+struct ObjectPoolSlot {
+    ObjectPoolSlot* next;
+};
+
+struct atom_object_pool_t {
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    const char*      tag;
+    size_t           slot_size;
+    uint32_t         slots_per_slab;
+    // free list of recycled slots, refilled lazily from the tail of the newest slab
+    ObjectPoolSlot*  free_list    = ATOM_NULLPTR;
+    ObjectPoolSlab*  slabs        = ATOM_NULLPTR;
+    uint8_t*         carve_cursor = ATOM_NULLPTR;
+    uint32_t         carve_remain = 0;
+    uint32_t         slab_count   = 0;
+    uint32_t         live_count   = 0;
+
+    void acquire()
+    {
+        while (lock.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    void release() { lock.clear(std::memory_order_release); }
+};
+
+atom_object_pool_t* atom_create_object_pool(size_t object_size, size_t alignment, const char* tag)
+{
+    atom_assert(alignment <= kObjectPoolSlotAlignment && "object pool: alignment exceeds a cache line!");
+    atom_object_pool_t* pool = atom_new<atom_object_pool_t>();
+    pool->tag                = tag;
+    pool->slot_size          = (object_size + kObjectPoolSlotAlignment - 1) & ~(kObjectPoolSlotAlignment - 1);
+    const size_t slab_size   = pool->slot_size * 16 > kObjectPoolSlabSize ? pool->slot_size * 16 : kObjectPoolSlabSize;
+    pool->slots_per_slab     = (uint32_t)((slab_size - kObjectPoolSlabHeaderSize) / pool->slot_size);
+    return pool;
+}
+
+void atom_free_object_pool(atom_object_pool_t* pool)
+{
+    if (pool->live_count) {
+        ATOM_warn(u8"object pool %s: releasing %u objects that are still alive", pool->tag, pool->live_count);
+    }
+    for (ObjectPoolSlab* slab = pool->slabs; slab;) {
+        ObjectPoolSlab* next = slab->next;
+        atom_free_alignedN(slab, kObjectPoolSlotAlignment, pool->tag);
+        slab = next;
+    }
+    atom_delete(pool);
+}
+
+void* atom_object_pool_alloc(atom_object_pool_t* pool)
+{
+    void* ptr = ATOM_NULLPTR;
+    pool->acquire();
+    if (pool->free_list) {
+        ptr             = pool->free_list;
+        pool->free_list = pool->free_list->next;
+    } else {
+        if (!pool->carve_remain) {
+            ObjectPoolSlab* slab = (ObjectPoolSlab*)atom_malloc_alignedN(
+                kObjectPoolSlabHeaderSize + pool->slots_per_slab * pool->slot_size, kObjectPoolSlotAlignment, pool->tag);
+            if (slab == ATOM_NULLPTR) {
+                pool->release();
+                return ATOM_NULLPTR;
+            }
+            slab->next         = pool->slabs;
+            pool->slabs        = slab;
+            pool->carve_cursor = (uint8_t*)slab + kObjectPoolSlabHeaderSize;
+            pool->carve_remain = pool->slots_per_slab;
+            pool->slab_count++;
+        }
+        ptr                 = pool->carve_cursor;
+        pool->carve_cursor += pool->slot_size;
+        pool->carve_remain--;
+    }
+    pool->live_count++;
+    pool->release();
+    memset(ptr, 0, pool->slot_size);
+    return ptr;
+}
+
+void atom_object_pool_free(atom_object_pool_t* pool, void* ptr)
+{
+    if (ptr == ATOM_NULLPTR) return;
+    ObjectPoolSlot* slot = (ObjectPoolSlot*)ptr;
+    pool->acquire();
+    slot->next      = pool->free_list;
+    pool->free_list = slot;
+    pool->live_count--;
+    pool->release();
+}
+
+size_t atom_object_pool_slot_size(const atom_object_pool_t* pool) { return pool->slot_size; }
+
+uint32_t atom_object_pool_live_count(atom_object_pool_t* pool)
+{
+    pool->acquire();
+    const uint32_t count = pool->live_count;
+    pool->release();
+    return count;
+}
@@ -0,0 +1,379 @@
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <atomCore/memory.h>
+#include <atomCore/log.h>
+
+// tag 0 collects untagged blocks and tags registered after the table is full
+static constexpr uint32_t kMaxMemoryTags          = 256;
+static constexpr uint32_t kTagCacheSize           = 64;
+static constexpr int64_t  kTagShardFlushThreshold = 64 * 1024;
+static constexpr size_t   kTaggedMinAlignment     = 16;
+
+struct TaggedHeader {
+    uint64_t size;
+    uint32_t tag;
+    uint32_t offset;
+};
+
+atom_static_assert(sizeof(TaggedHeader) == kTaggedMinAlignment, "tagged header must keep the minimal alignment");
+
+// registry
+static const char*           g_tag_names[kMaxMemoryTags] = {"<untagged>"};
+static std::atomic<uint32_t> g_tag_count                 = 1;
+static std::mutex            g_tag_mutex;
+
+struct alignas(64) TagCounters {
+    // bytes flushed from thread shards
+    std::atomic<int64_t>  live_bytes;
+    std::atomic<int64_t>  peak_bytes;
+    // counters folded in from exited threads
+    std::atomic<uint64_t> total_bytes;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> frees;
+};
+
+static TagCounters g_tag_counters[kMaxMemoryTags];
+
+// per-thread shards, only the owning thread writes to them so plain relaxed load/store pairs are enough
+struct TagShard {
+    std::atomic<int64_t>  pending_bytes[kMaxMemoryTags];
+    // high-water mark of pending_bytes since the last flush, so spikes inside a batch still reach peak_bytes
+    std::atomic<int64_t>  pending_peak[kMaxMemoryTags];
+    std::atomic<uint64_t> total_bytes[kMaxMemoryTags];
+    std::atomic<uint64_t> allocations[kMaxMemoryTags];
+    std::atomic<uint64_t> frees[kMaxMemoryTags];
+    std::atomic<bool>     in_use;
+    TagShard*             next;
+};
+
+// shards are recycled but never released, so readers can walk the list without locking
+static std::atomic<TagShard*> g_tag_shards = ATOM_NULLPTR;
+
+template <typename T>
+static ATOM_FORCEINLINE void shard_bump(std::atomic<T>& counter, T delta)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+static void raise_peak_bytes(TagCounters& counters, int64_t live)
+{
+    int64_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+// high is the largest running sum the batch reached before it was flushed (at least max(delta, 0))
+static void flush_live_bytes(uint32_t tag, int64_t delta, int64_t high)
+{
+    TagCounters&  counters = g_tag_counters[tag];
+    const int64_t before   = counters.live_bytes.fetch_add(delta, std::memory_order_relaxed);
+    raise_peak_bytes(counters, before + high);
+}
+
+static TagShard* acquire_shard()
+{
+    for (TagShard* shard = g_tag_shards.load(std::memory_order_acquire); shard; shard = shard->next) {
+        bool expected = false;
+        if (!shard->in_use.load(std::memory_order_relaxed)
+            && shard->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return shard;
+        }
+    }
+    TagShard* shard = new TagShard{};
+    shard->in_use.store(true, std::memory_order_relaxed);
+    shard->next = g_tag_shards.load(std::memory_order_relaxed);
+    while (!g_tag_shards.compare_exchange_weak(shard->next, shard, std::memory_order_release, std::memory_order_relaxed)) {}
+    return shard;
+}
+
+static void retire_shard(TagShard* shard)
+{
+    const uint32_t tag_count = g_tag_count.load(std::memory_order_acquire);
+    for (uint32_t tag = 0; tag < tag_count; ++tag) {
+        TagCounters& counters = g_tag_counters[tag];
+        const int64_t high = shard->pending_peak[tag].exchange(0, std::memory_order_relaxed);
+        flush_live_bytes(tag, shard->pending_bytes[tag].exchange(0, std::memory_order_relaxed), high);
+        counters.total_bytes.fetch_add(shard->total_bytes[tag].exchange(0, std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+        counters.allocations.fetch_add(shard->allocations[tag].exchange(0, std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+        counters.frees.fetch_add(shard->frees[tag].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    shard->in_use.store(false, std::memory_order_release);
+}
+
+struct ThreadTagState {
+    TagShard*   shard                       = ATOM_NULLPTR;
+    const char* cache_keys[kTagCacheSize]   = {};
+    uint32_t    cache_values[kTagCacheSize] = {};
+    bool        destroyed                   = false;
+
+    ~ThreadTagState()
+    {
+        if (shard) retire_shard(shard);
+        shard     = ATOM_NULLPTR;
+        destroyed = true;
+    }
+};
+
+static thread_local ThreadTagState t_tag_state;
+
+static uint32_t register_tag(const char* tag)
+{
+    uint32_t count = g_tag_count.load(std::memory_order_acquire);
+    for (uint32_t i = 1; i < count; ++i) {
+        if (g_tag_names[i] == tag || ::strcmp(g_tag_names[i], tag) == 0) return i;
+    }
+    std::lock_guard<std::mutex> lock(g_tag_mutex);
+    for (uint32_t i = count; i < g_tag_count.load(std::memory_order_relaxed); ++i) {
+        if (::strcmp(g_tag_names[i], tag) == 0) return i;
+    }
+    count = g_tag_count.load(std::memory_order_relaxed);
+    if (count == kMaxMemoryTags) {
+        ATOM_warn(u8"memory: tag table is full, \"%s\" is accounted as untagged!", tag);
+        return 0;
+    }
+    g_tag_names[count] = tag;
+    g_tag_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+static uint32_t find_tag(const char* tag)
+{
+    if (tag == ATOM_NULLPTR) return 0;
+    ThreadTagState& state = t_tag_state;
+    const uint32_t  slot  = (uint32_t)(((uintptr_t)tag >> 3) % kTagCacheSize);
+    if (state.cache_keys[slot] == tag) return state.cache_values[slot];
+    const uint32_t index = register_tag(tag);
+    if (!state.destroyed) {
+        state.cache_keys[slot]   = tag;
+        state.cache_values[slot] = index;
+    }
+    return index;
+}
+
+static void record(uint32_t tag, int64_t bytes, int32_t allocations)
+{
+    ThreadTagState& state = t_tag_state;
+    if (state.destroyed) {
+        TagCounters& counters = g_tag_counters[tag];
+        flush_live_bytes(tag, bytes, atom_max(bytes, (int64_t)0));
+        if (bytes > 0) counters.total_bytes.fetch_add((uint64_t)bytes, std::memory_order_relaxed);
+        if (allocations > 0) counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        if (allocations < 0) counters.frees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (state.shard == ATOM_NULLPTR) state.shard = acquire_shard();
+    TagShard* shard = state.shard;
+
+    if (bytes > 0) shard_bump(shard->total_bytes[tag], (uint64_t)bytes);
+    if (allocations > 0) shard_bump(shard->allocations[tag], (uint64_t)1);
+    if (allocations < 0) shard_bump(shard->frees[tag], (uint64_t)1);
+    int64_t pending = shard->pending_bytes[tag].load(std::memory_order_relaxed) + bytes;
+    int64_t high    = shard->pending_peak[tag].load(std::memory_order_relaxed);
+    if (pending > high) {
+        high = pending;
+        shard->pending_peak[tag].store(high, std::memory_order_relaxed);
+    }
+    if (pending >= kTagShardFlushThreshold || pending <= -kTagShardFlushThreshold) {
+        flush_live_bytes(tag, pending, high);
+        shard->pending_peak[tag].store(0, std::memory_order_relaxed);
+        pending = 0;
+    }
+    shard->pending_bytes[tag].store(pending, std::memory_order_relaxed);
+}
+
+static ATOM_FORCEINLINE TaggedHeader* header_of(void* ptr) { return (TaggedHeader*)ptr - 1; }
+
+static void* tagged_allocate(size_t size, size_t alignment, const char* tag, bool zeroed)
+{
+    alignment           = atom_max(alignment, kTaggedMinAlignment);
+    const size_t offset = atom_max(sizeof(TaggedHeader), alignment);
+    if (size > SIZE_MAX - offset) return ATOM_NULLPTR;
+    uint8_t* base = (uint8_t*)(zeroed ? atom_calloc_aligned_impl(1, offset + size, alignment)
+                                      : atom_malloc_aligned_impl(offset + size, alignment));
+    if (base == ATOM_NULLPTR) return ATOM_NULLPTR;
+
+    TaggedHeader* header = header_of(base + offset);
+    header->size         = size;
+    header->tag          = find_tag(tag);
+    header->offset       = (uint32_t)offset;
+    record(header->tag, (int64_t)size, 1);
+    return base + offset;
+}
+
+static void* tagged_reallocate(void* ptr, size_t size, size_t alignment, const char* tag)
+{
+    if (ptr == ATOM_NULLPTR) return tagged_allocate(size, alignment, tag, false);
+    if (size == 0) {
+        atom_free_tagged(ptr);
+        return ATOM_NULLPTR;
+    }
+    alignment                 = atom_max(alignment, kTaggedMinAlignment);
+    const size_t   offset     = atom_max(sizeof(TaggedHeader), alignment);
+    TaggedHeader*  header     = header_of(ptr);
+    const size_t   old_size   = header->size;
+    const size_t   old_offset = header->offset;
+    const uint32_t old_tag    = header->tag;
+    const uint32_t new_tag    = find_tag(tag);
+    uint8_t*       base       = ATOM_NULLPTR;
+    if (offset == old_offset) {
+        if (size > SIZE_MAX - offset) return ATOM_NULLPTR;
+        base = (uint8_t*)atom_realloc_aligned_impl((uint8_t*)ptr - old_offset, offset + size, alignment);
+        if (base == ATOM_NULLPTR) return ATOM_NULLPTR;
+    } else {
+        // alignment changed, the header has to move
+        void* memory = tagged_allocate(size, alignment, tag, false);
+        if (memory == ATOM_NULLPTR) return ATOM_NULLPTR;
+        ::memcpy(memory, ptr, atom_min(old_size, size));
+        atom_free_tagged(ptr);
+        return memory;
+    }
+    header         = header_of(base + offset);
+    header->size   = size;
+    header->tag    = new_tag;
+    header->offset = (uint32_t)offset;
+    if (old_tag == new_tag) {
+        record(new_tag, (int64_t)size - (int64_t)old_size, 0);
+    } else {
+        record(old_tag, -(int64_t)old_size, -1);
+        record(new_tag, (int64_t)size, 1);
+    }
+    return base + offset;
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_tagged(size_t size, const char* tag)
+{
+    return tagged_allocate(size, kTaggedMinAlignment, tag, false);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_calloc_tagged(size_t count, size_t size, const char* tag)
+{
+    if (size && count > SIZE_MAX / size) return ATOM_NULLPTR;
+    return tagged_allocate(count * size, kTaggedMinAlignment, tag, true);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_realloc_tagged(void* ptr, size_t size, const char* tag)
+{
+    return tagged_reallocate(ptr, size, kTaggedMinAlignment, tag);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_malloc_aligned_tagged(size_t size, size_t alignment, const char* tag)
+{
+    return tagged_allocate(size, alignment, tag, false);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_calloc_aligned_tagged(size_t count, size_t size, size_t alignment, const char* tag)
+{
+    if (size && count > SIZE_MAX / size) return ATOM_NULLPTR;
+    return tagged_allocate(count * size, alignment, tag, true);
+}
+
+ATOM_EXTERN_C ATOM_API void* atom_realloc_aligned_tagged(void* ptr, size_t size, size_t alignment, const char* tag)
+{
+    return tagged_reallocate(ptr, size, alignment, tag);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_free_tagged(void* ptr)
+{
+    if (ptr == ATOM_NULLPTR) return;
+    TaggedHeader* header = header_of(ptr);
+    record(header->tag, -(int64_t)header->size, -1);
+    atom_free_aligned_impl((uint8_t*)ptr - header->offset);
+}
+
+ATOM_EXTERN_C ATOM_API void atom_memory_tag_add(const char* tag, size_t size) { record(find_tag(tag), (int64_t)size, 1); }
+
+ATOM_EXTERN_C ATOM_API void atom_memory_tag_remove(const char* tag, size_t size)
+{
+    record(find_tag(tag), -(int64_t)size, -1);
+}
+
+// queries
+static void collect_tag_stats(uint32_t tag, atom_memory_tag_stats_t* stats)
+{
+    const TagCounters& counters    = g_tag_counters[tag];
+    const int64_t      flushed     = counters.live_bytes.load(std::memory_order_relaxed);
+    int64_t            live        = flushed;
+    int64_t            peak        = counters.peak_bytes.load(std::memory_order_relaxed);
+    uint64_t           total       = counters.total_bytes.load(std::memory_order_relaxed);
+    uint64_t           allocations = counters.allocations.load(std::memory_order_relaxed);
+    uint64_t           frees       = counters.frees.load(std::memory_order_relaxed);
+    for (TagShard* shard = g_tag_shards.load(std::memory_order_acquire); shard; shard = shard->next) {
+        // spikes of batches that have not been flushed yet
+        peak         = atom_max(peak, flushed + shard->pending_peak[tag].load(std::memory_order_relaxed));
+        live        += shard->pending_bytes[tag].load(std::memory_order_relaxed);
+        total       += shard->total_bytes[tag].load(std::memory_order_relaxed);
+        allocations += shard->allocations[tag].load(std::memory_order_relaxed);
+        frees       += shard->frees[tag].load(std::memory_order_relaxed);
+    }
+    stats->name                  = g_tag_names[tag];
+    stats->live_bytes            = live;
+    stats->peak_bytes            = atom_max(peak, live);
+    stats->total_bytes           = total;
+    stats->allocation_count      = allocations;
+    stats->live_allocation_count = allocations > frees ? allocations - frees : 0;
+}
+
+ATOM_EXTERN_C ATOM_API uint32_t atom_memory_tag_count() { return g_tag_count.load(std::memory_order_acquire); }
+
+ATOM_EXTERN_C ATOM_API bool atom_memory_query_tag(const char* tag, atom_memory_tag_stats_t* stats)
+{
+    atom_assert(stats && "fatal: query memory tag with NULL stats!");
+    const uint32_t count = g_tag_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (tag == ATOM_NULLPTR ? i == 0 : (g_tag_names[i] == tag || ::strcmp(g_tag_names[i], tag) == 0)) {
+            collect_tag_stats(i, stats);
+            return true;
+        }
+    }
+    return false;
+}
+
+ATOM_EXTERN_C ATOM_API uint32_t atom_memory_query_tags(atom_memory_tag_stats_t* stats, uint32_t capacity)
+{
+    const uint32_t count = g_tag_count.load(std::memory_order_acquire);
+    if (stats == ATOM_NULLPTR) return count;
+    const uint32_t written = atom_min(count, capacity);
+    for (uint32_t i = 0; i < written; ++i) collect_tag_stats(i, stats + i);
+    return written;
+}
+
+static const char* kTagReportFormat = "%-32s %16s %16s %16s %12s %12s\n";
+static const char* kTagRowFormat    = "%-32s %16lld %16lld %16llu %12llu %12llu\n";
+
+ATOM_EXTERN_C ATOM_API size_t atom_memory_report_tags(char* buffer, size_t capacity)
+{
+    size_t length  = 0;
+    auto   cursor  = [&]() { return buffer && length < capacity ? buffer + length : ATOM_NULLPTR; };
+    auto   remains = [&]() { return buffer && length < capacity ? capacity - length : (size_t)0; };
+    auto   append  = [&](int written) { length += written > 0 ? (size_t)written : 0; };
+
+    append(::snprintf(cursor(), remains(), kTagReportFormat, "tag", "live", "peak", "total", "allocs", "live allocs"));
+    const uint32_t count = g_tag_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        atom_memory_tag_stats_t stats;
+        collect_tag_stats(i, &stats);
+        append(::snprintf(cursor(),
+                          remains(),
+                          kTagRowFormat,
+                          stats.name,
+                          (long long)stats.live_bytes,
+                          (long long)stats.peak_bytes,
+                          (unsigned long long)stats.total_bytes,
+                          (unsigned long long)stats.allocation_count,
+                          (unsigned long long)stats.live_allocation_count));
+    }
+    return length;
+}
+
+ATOM_EXTERN_C ATOM_API void atom_memory_dump_tags()
+{
+    const size_t length = atom_memory_report_tags(ATOM_NULLPTR, 0);
+    char*        report = (char*)atom_malloc(length + 1);
+    atom_memory_report_tags(report, length + 1);
+    ATOM_info(u8"memory tags:\n%s", report);
+    atom_free(report);
+}
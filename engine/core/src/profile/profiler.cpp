@@ -0,0 +1,321 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <atomCore/profile.h>
+#include <atomCore/memory.h>
+#include <atomCore/log.h>
+
+static const char* kProfileMemoryTag = "atom::profile";
+
+static constexpr uint32_t kProfileEventsPerChunk = 4096;
+static constexpr size_t   kProfileThreadNameSize = 64;
+
+static ATOM_FORCEINLINE int64_t steady_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// zones are stamped with the cycle counter where there is one, the ratio to nanoseconds is measured over the capture
+#if defined(__x86_64__) || defined(_M_X64)
+static ATOM_FORCEINLINE int64_t profile_timestamp() { return (int64_t)__rdtsc(); }
+#else
+static ATOM_FORCEINLINE int64_t profile_timestamp() { return steady_time_ns(); }
+#endif
+
+struct ProfileEvent {
+    const atom_profile_site_t* site;
+    int64_t                    begin;
+    int64_t                    end;
+};
+
+struct ProfileChunk {
+    ProfileChunk*         next = ATOM_NULLPTR;
+    // published with release by the owning thread, the exporter only reads events below it
+    std::atomic<uint32_t> count{0};
+    ProfileEvent          events[kProfileEventsPerChunk];
+};
+
+// one per thread that ever recorded a zone, kept until exit so that events of finished threads can still be exported
+struct ProfileThread {
+    ProfileThread*             next = ATOM_NULLPTR;
+    uint32_t                   id   = 0;
+    // tracks record steady clock nanoseconds instead of ticks
+    bool                       foreign_clock = false;
+    std::atomic<bool>          retired{false};
+    // capture the chunks belong to, the owner starts over once it sees a newer one
+    std::atomic<uint64_t>      capture{0};
+    std::atomic<ProfileChunk*> head{ATOM_NULLPTR};
+    ProfileChunk*              tail = ATOM_NULLPTR;
+    // spare chunks of earlier captures
+    ProfileChunk*              free_chunks = ATOM_NULLPTR;
+    char                       name[kProfileThreadNameSize] = {};
+};
+
+static std::atomic<bool>           g_profile_capturing{false};
+static std::atomic<uint64_t>       g_profile_capture{0};
+static std::atomic<ProfileThread*> g_profile_threads{ATOM_NULLPTR};
+static std::atomic<uint32_t>       g_profile_thread_ids{0};
+static std::mutex                  g_profile_control_mutex;
+static int64_t                     g_capture_begin_ticks = 0;
+static int64_t                     g_capture_begin_ns    = 0;
+static int64_t                     g_capture_end_ticks   = 0;
+static int64_t                     g_capture_end_ns      = 0;
+
+struct atom_profile_track_t : ProfileThread {
+};
+
+static void free_profile_chunks(ProfileChunk* chunk)
+{
+    while (chunk) {
+        ProfileChunk* next = chunk->next;
+        atom_delete_placed(chunk);
+        atom_freeN(chunk, kProfileMemoryTag);
+        chunk = next;
+    }
+}
+
+static void register_profile_thread(ProfileThread* thread)
+{
+    thread->id          = g_profile_thread_ids.fetch_add(1, std::memory_order_relaxed) + 1;
+    ProfileThread* head = g_profile_threads.load(std::memory_order_relaxed);
+    do {
+        thread->next = head;
+    } while (!g_profile_threads.compare_exchange_weak(head, thread, std::memory_order_release, std::memory_order_relaxed));
+}
+
+struct ThreadProfileState {
+    ProfileThread* thread = ATOM_NULLPTR;
+
+    ~ThreadProfileState()
+    {
+        if (thread) thread->retired.store(true, std::memory_order_release);
+    }
+
+    ProfileThread* get()
+    {
+        if (thread) return thread;
+        thread = atom_new<ProfileThread>();
+        register_profile_thread(thread);
+        return thread;
+    }
+};
+
+static thread_local ThreadProfileState t_profile_thread;
+
+static ProfileChunk* acquire_profile_chunk(ProfileThread* thread)
+{
+    ProfileChunk* chunk = thread->free_chunks;
+    if (chunk) {
+        thread->free_chunks = chunk->next;
+        chunk->next         = ATOM_NULLPTR;
+        chunk->count.store(0, std::memory_order_relaxed);
+        return chunk;
+    }
+    return atom_new_placed<ProfileChunk>(atom_mallocN(sizeof(ProfileChunk), kProfileMemoryTag));
+}
+
+static void record_profile_event(ProfileThread* thread, const ProfileEvent& event)
+{
+    const uint64_t capture = g_profile_capture.load(std::memory_order_acquire);
+    if (thread->capture.load(std::memory_order_relaxed) != capture) {
+        // recycle what the previous capture left, the exporter is done with it once a new capture started
+        ProfileChunk* chunk = thread->head.exchange(ATOM_NULLPTR, std::memory_order_acq_rel);
+        while (chunk) {
+            ProfileChunk* next  = chunk->next;
+            chunk->next         = thread->free_chunks;
+            thread->free_chunks = chunk;
+            chunk               = next;
+        }
+        thread->tail = ATOM_NULLPTR;
+        thread->capture.store(capture, std::memory_order_release);
+    }
+    ProfileChunk* tail  = thread->tail;
+    uint32_t      count = tail ? tail->count.load(std::memory_order_relaxed) : kProfileEventsPerChunk;
+    if (count == kProfileEventsPerChunk) {
+        ProfileChunk* chunk = acquire_profile_chunk(thread);
+        if (tail) {
+            std::atomic_ref<ProfileChunk*>(tail->next).store(chunk, std::memory_order_release);
+        } else {
+            thread->head.store(chunk, std::memory_order_release);
+        }
+        thread->tail = tail = chunk;
+        count               = 0;
+    }
+    tail->events[count] = event;
+    tail->count.store(count + 1, std::memory_order_release);
+}
+
+atom_profile_zone_t atom_profile_zone_begin(const atom_profile_site_t* site)
+{
+    if (!g_profile_capturing.load(std::memory_order_relaxed)) return atom_profile_zone_t{ATOM_NULLPTR, 0};
+    return atom_profile_zone_t{site, profile_timestamp()};
+}
+
+void atom_profile_zone_end(const atom_profile_zone_t* zone)
+{
+    if (zone->site == ATOM_NULLPTR) return;
+    record_profile_event(t_profile_thread.get(), ProfileEvent{zone->site, zone->begin, profile_timestamp()});
+}
+
+void atom_profile_set_thread_name(const char* name)
+{
+    ProfileThread*              thread = t_profile_thread.get();
+    std::lock_guard<std::mutex> lock(g_profile_control_mutex);
+    snprintf(thread->name, sizeof(thread->name), "%s", name);
+}
+
+void atom_profile_begin_capture()
+{
+    std::lock_guard<std::mutex> lock(g_profile_control_mutex);
+    if (g_profile_capturing.load(std::memory_order_relaxed)) return;
+    // threads that exited cannot recycle their chunks themselves
+    for (ProfileThread* thread = g_profile_threads.load(std::memory_order_acquire); thread; thread = thread->next) {
+        if (!thread->retired.load(std::memory_order_acquire)) continue;
+        free_profile_chunks(thread->head.exchange(ATOM_NULLPTR, std::memory_order_acq_rel));
+        free_profile_chunks(thread->free_chunks);
+        thread->free_chunks = ATOM_NULLPTR;
+        thread->tail        = ATOM_NULLPTR;
+    }
+    g_capture_begin_ticks = profile_timestamp();
+    g_capture_begin_ns    = steady_time_ns();
+    g_profile_capture.fetch_add(1, std::memory_order_acq_rel);
+    g_profile_capturing.store(true, std::memory_order_release);
+}
+
+void atom_profile_end_capture()
+{
+    std::lock_guard<std::mutex> lock(g_profile_control_mutex);
+    if (!g_profile_capturing.load(std::memory_order_relaxed)) return;
+    g_profile_capturing.store(false, std::memory_order_release);
+    g_capture_end_ticks = profile_timestamp();
+    g_capture_end_ns    = steady_time_ns();
+}
+
+bool atom_profile_is_capturing() { return g_profile_capturing.load(std::memory_order_acquire); }
+
+template <typename F>
+static void for_each_profile_event(const ProfileThread* thread, F&& callback)
+{
+    for (ProfileChunk* chunk = thread->head.load(std::memory_order_acquire); chunk;
+         chunk               = std::atomic_ref<ProfileChunk*>(chunk->next).load(std::memory_order_acquire)) {
+        const uint32_t count = chunk->count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++) callback(chunk->events[i]);
+    }
+}
+
+uint64_t atom_profile_event_count()
+{
+    std::lock_guard<std::mutex> lock(g_profile_control_mutex);
+    uint64_t                    count    = 0;
+    const uint64_t              captured = g_profile_capture.load(std::memory_order_acquire);
+    for (ProfileThread* thread = g_profile_threads.load(std::memory_order_acquire); thread; thread = thread->next) {
+        if (thread->capture.load(std::memory_order_acquire) != captured) continue;
+        for_each_profile_event(thread, [&count](const ProfileEvent&) { count++; });
+    }
+    return count;
+}
+
+static void write_json_string(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* c = text ? text : ""; *c; c++) {
+        switch (*c) {
+            case '"':  fputs("\\\"", file); break;
+            case '\\': fputs("\\\\", file); break;
+            case '\n': fputs("\\n", file); break;
+            case '\t': fputs("\\t", file); break;
+            default:
+                if ((unsigned char)*c < 0x20) {
+                    fprintf(file, "\\u%04x", (unsigned)*c);
+                } else {
+                    fputc(*c, file);
+                }
+                break;
+        }
+    }
+    fputc('"', file);
+}
+
+bool atom_profile_export_chrome_trace(const char* path)
+{
+    std::lock_guard<std::mutex> lock(g_profile_control_mutex);
+    FILE*                       file = fopen(path, "wb");
+    if (file == ATOM_NULLPTR) {
+        ATOM_error(u8"profiler: failed to open %s", path);
+        return false;
+    }
+    // convert ticks with the ratio measured over the whole capture
+    const bool    capturing   = g_profile_capturing.load(std::memory_order_acquire);
+    const int64_t end_ticks   = capturing ? profile_timestamp() : g_capture_end_ticks;
+    const int64_t end_ns      = capturing ? steady_time_ns() : g_capture_end_ns;
+    const int64_t ticks       = end_ticks - g_capture_begin_ticks;
+    const double  ns_per_tick = ticks > 0 ? (double)(end_ns - g_capture_begin_ns) / (double)ticks : 1.0;
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    if (capturing) ATOM_warn(u8"profiler: exporting while capturing, zones still open are missing");
+    bool           first    = true;
+    const uint64_t captured = g_profile_capture.load(std::memory_order_acquire);
+    for (ProfileThread* thread = g_profile_threads.load(std::memory_order_acquire); thread; thread = thread->next) {
+        if (thread->capture.load(std::memory_order_acquire) != captured) continue;
+        fprintf(file,
+                "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":",
+                first ? "" : ",\n",
+                thread->id);
+        if (thread->name[0]) {
+            write_json_string(file, thread->name);
+        } else {
+            fprintf(file, "\"thread %u\"", thread->id);
+        }
+        fputs("}}", file);
+        first = false;
+        const int64_t origin = thread->foreign_clock ? g_capture_begin_ns : g_capture_begin_ticks;
+        const double  scale  = thread->foreign_clock ? 1.0 : ns_per_tick;
+        for_each_profile_event(thread, [&](const ProfileEvent& event) {
+            // zones that were already open when the capture began
+            if (event.begin < origin) return;
+            // chrome trace timestamps are microseconds
+            const double begin = (double)(event.begin - origin) * scale / 1000.0;
+            const double dur   = (double)(event.end - event.begin) * scale / 1000.0;
+            fprintf(file, ",\n{\"ph\":\"X\",\"cat\":\"%s\",\"name\":", thread->foreign_clock ? "track" : "cpu");
+            write_json_string(file, event.site->name);
+            fprintf(file, ",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"file\":", thread->id, begin, dur);
+            write_json_string(file, event.site->file);
+            fprintf(file, ",\"line\":%d}}", event.site->line);
+        });
+    }
+    fputs("\n]}\n", file);
+    fclose(file);
+    return true;
+}
+
+atom_profile_track_t* atom_profile_create_track(const char* name)
+{
+    atom_profile_track_t* track = atom_new<atom_profile_track_t>();
+    track->foreign_clock        = true;
+    snprintf(track->name, sizeof(track->name), "%s", name ? name : "");
+    register_profile_thread(track);
+    return track;
+}
+
+void atom_profile_free_track(atom_profile_track_t* track)
+{
+    if (track) track->retired.store(true, std::memory_order_release);
+}
+
+void atom_profile_track_emit(atom_profile_track_t* track, const atom_profile_site_t* site, int64_t begin_ns, int64_t end_ns)
+{
+    if (!g_profile_capturing.load(std::memory_order_relaxed)) return;
+    record_profile_event(track, ProfileEvent{site, begin_ns, end_ns});
+}
+
+int64_t atom_profile_time_ns() { return steady_time_ns(); }
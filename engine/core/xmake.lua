@@ -1,8 +1,31 @@
-add_requires("xxhash", "spdlog", "stduuid", "parallel-hashmap")
+add_requires("xxhash", "spdlog", "parallel-hashmap")
+
+option("log_level")
+    set_default("auto")
+    set_showmenu(true)
+    set_values("auto", "trace", "debug", "info", "warn", "error", "fatal", "off")
+    set_description("Strip log statements below this level at compile time (auto: trace in debug, info in release)")
+option_end()
+
+option("profile")
+    set_default(true)
+    set_showmenu(true)
+    set_description("Compile the ATOM_PROFILE_* cpu zones in")
+option_end()
+
+local log_levels = {trace = 0, debug = 1, info = 2, warn = 3, error = 4, fatal = 5, off = 6}
 
 target("AtomEngine_Core")
     set_kind("shared")
     add_includedirs("./include", {public = true})
     add_files("./src/build.**.c", "./src/build.**.cpp")
     add_defines("SHARED_MODULE")
-    add_packages("xxhash", "spdlog", "stduuid", "parallel-hashmap", {public = true})
\ No newline at end of file
+    if log_levels[get_config("log_level")] then
+        add_defines("ATOM_LOG_ACTIVE_LEVEL=" .. log_levels[get_config("log_level")], {public = true})
+    elseif is_mode("release") then
+        add_defines("ATOM_LOG_ACTIVE_LEVEL=2", {public = true})
+    end
+    if not has_config("profile") then
+        add_defines("ATOM_PROFILE_ENABLED=0", {public = true})
+    end
+    add_packages("xxhash", "spdlog", "parallel-hashmap", {public = true})
\ No newline at end of file
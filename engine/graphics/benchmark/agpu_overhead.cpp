@@ -0,0 +1,606 @@
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+
+#include <atomGraphics/common/agpux.h>
+
+// cpu cost of the agpu front end and the vulkan backend, meant to run headless on a software icd such as lavapipe or
+// swiftshader (point VK_ICD_FILENAMES at it to be sure). every benchmark reports ns/op, recording benchmarks record
+// kRecordOps commands per iteration so the command buffer reset is amortized away. set AGPU_BENCH_RENDER_PASS_OBJECTS
+// to keep render pass / framebuffer objects on devices that support dynamic rendering.
+// the pass cache eviction benchmark always runs on a second device that keeps them.
+
+alignas(uint32_t) static const uint8_t kIncrementCompSpv[] = {
+#include "increment.comp.spv.h"
+};
+alignas(uint32_t) static const uint8_t kFullscreenVertSpv[] = {
+#include "fullscreen.vert.spv.h"
+};
+alignas(uint32_t) static const uint8_t kSolidFragSpv[] = {
+#include "solid.frag.spv.h"
+};
+
+static constexpr uint32_t kRecordOps          = 100000;
+static constexpr uint32_t kBarrierOps         = 10000;
+static constexpr uint32_t kPassOps            = 10000;
+static constexpr uint32_t kPassRetireFrames   = 4;
+static constexpr uint32_t kRenderTargetExtent = 64;
+static constexpr uint64_t kCounterBufferSize  = 64 * 1024;
+
+static void set_ns_per_op(benchmark::State& state, uint32_t ops_per_iteration)
+{
+    state.counters["ns/op"] =
+        benchmark::Counter((double)ops_per_iteration * 1e-9,
+                           benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// one device shared by all benchmarks, created on first use and torn down before exit
+struct AGPUBenchContext {
+    AGPUInstanceIter        instance       = ATOM_NULLPTR;
+    AGPUAdapterIter         adapter        = ATOM_NULLPTR;
+    AGPUDeviceIter          device         = ATOM_NULLPTR;
+    AGPUQueueIter           queue          = ATOM_NULLPTR;
+    AGPUCommandPoolIter     cmd_pool       = ATOM_NULLPTR;
+    AGPUCommandBufferIter   cmd            = ATOM_NULLPTR;
+    AGPUFenceIter           fence          = ATOM_NULLPTR;
+    AGPUShaderLibraryIter   compute_shader = ATOM_NULLPTR;
+    AGPUShaderLibraryIter   vertex_shader  = ATOM_NULLPTR;
+    AGPUShaderLibraryIter   pixel_shader   = ATOM_NULLPTR;
+    AGPUPipelineLayoutIter  compute_layout = ATOM_NULLPTR;
+    AGPUPipelineLayoutIter  render_layout  = ATOM_NULLPTR;
+    AGPUComputePipelineIter compute_pso    = ATOM_NULLPTR;
+    AGPURenderPipelineIter  render_pso     = ATOM_NULLPTR;
+    AGPUDescriptorSetIter   compute_set    = ATOM_NULLPTR;
+    AGPUBufferIter          counters       = ATOM_NULLPTR;
+    AGPUTextureIter         render_target  = ATOM_NULLPTR;
+    AGPUTextureViewIter     render_view    = ATOM_NULLPTR;
+    AGPUXPsoCacheIter       pso_cache      = ATOM_NULLPTR;
+
+    // dynamic rendering disabled, so passes go through the render pass / framebuffer caches
+    AGPUDeviceIter        pass_device   = ATOM_NULLPTR;
+    AGPUQueueIter         pass_queue    = ATOM_NULLPTR;
+    AGPUCommandPoolIter   pass_cmd_pool = ATOM_NULLPTR;
+    AGPUCommandBufferIter pass_cmd      = ATOM_NULLPTR;
+    AGPUFenceIter         pass_fence    = ATOM_NULLPTR;
+    AGPUTextureIter       pass_target   = ATOM_NULLPTR;
+    AGPUTextureViewIter   pass_view     = ATOM_NULLPTR;
+
+    AGPUShaderEntryDescriptor compute_entry = {};
+    AGPUShaderEntryDescriptor vertex_entry  = {};
+    AGPUShaderEntryDescriptor pixel_entry   = {};
+    AGPUShaderEntryDescriptor render_entries[2];
+    AGPUBlendStateDescriptor  blend_state = {};
+    AGPUDepthStateDescriptor  depth_state = {};
+    eAGPUFormat               color_format = AGPU_FORMAT_R8G8B8A8_UNORM;
+
+    static AGPUBenchContext& get()
+    {
+        static AGPUBenchContext context;
+        if (!context.device) context.initialize();
+        return context;
+    }
+
+    AGPUShaderLibraryIter create_shader(const char8_t* name, const uint8_t* code, uint32_t size, eAGPUShaderStage stage)
+    {
+        AGPUShaderLibraryDescriptor desc = {};
+        desc.name                        = name;
+        desc.code                        = (const uint32_t*)code;
+        desc.code_size                   = size;
+        desc.stage                       = stage;
+        return agpu_create_shader_library(device, &desc);
+    }
+
+    void initialize()
+    {
+        AGPUInstanceDescriptor instance_desc = {};
+        instance_desc.backend                = AGPU_BACKEND_VULKAN;
+        instance                             = agpu_create_instance(&instance_desc);
+
+        // prefer a software device, that is what build machines have
+        uint32_t adapter_count = 0;
+        agpu_enum_adapters(instance, ATOM_NULLPTR, &adapter_count);
+        atom_assert(adapter_count && "no vulkan device, install lavapipe or swiftshader");
+        AGPUAdapterIter adapters[16] = {};
+        adapter_count                = atom_min(adapter_count, 16u);
+        agpu_enum_adapters(instance, adapters, &adapter_count);
+        adapter = adapters[0];
+        for (uint32_t i = 0; i < adapter_count; i++) {
+            if (agpu_query_adapter_detail(adapters[i])->is_cpu) adapter = adapters[i];
+        }
+        const AGPUAdapterDetail* detail = agpu_query_adapter_detail(adapter);
+        if (!detail->is_cpu) ATOM_warn(u8"agpu benchmark: no software device found, numbers include a hardware driver");
+        ATOM_info(u8"agpu benchmark: running on %s", detail->vendor_preset.gpu_name);
+
+        AGPUQueueGroupDescriptor queue_group  = {AGPU_QUEUE_TYPE_GRAPHICS, 1};
+        AGPUDeviceDescriptor     device_desc  = {};
+        device_desc.queue_groups              = &queue_group;
+        device_desc.queue_group_count         = 1;
+        device_desc.disable_dynamic_rendering = std::getenv("AGPU_BENCH_RENDER_PASS_OBJECTS") != nullptr;
+        device                                = agpu_create_device(adapter, &device_desc);
+        queue                                 = agpu_get_queue(device, AGPU_QUEUE_TYPE_GRAPHICS, 0);
+
+        AGPUCommandPoolDescriptor   pool_desc = {u8"agpu_benchmark"};
+        AGPUCommandBufferDescriptor cmd_desc  = {};
+        cmd_pool                              = agpu_create_command_pool(queue, &pool_desc);
+        cmd                                   = agpu_create_command_buffer(cmd_pool, &cmd_desc);
+        fence                                 = agpu_create_fence(device);
+
+        compute_shader = create_shader(u8"increment", kIncrementCompSpv, sizeof(kIncrementCompSpv), AGPU_SHADER_STAGE_COMPUTE);
+        vertex_shader  = create_shader(u8"fullscreen", kFullscreenVertSpv, sizeof(kFullscreenVertSpv), AGPU_SHADER_STAGE_VERT);
+        pixel_shader   = create_shader(u8"solid", kSolidFragSpv, sizeof(kSolidFragSpv), AGPU_SHADER_STAGE_FRAG);
+        compute_entry  = {compute_shader, u8"main", AGPU_SHADER_STAGE_COMPUTE, ATOM_NULLPTR, 0};
+        vertex_entry   = {vertex_shader, u8"main", AGPU_SHADER_STAGE_VERT, ATOM_NULLPTR, 0};
+        pixel_entry    = {pixel_shader, u8"main", AGPU_SHADER_STAGE_FRAG, ATOM_NULLPTR, 0};
+        render_entries[0] = vertex_entry;
+        render_entries[1] = pixel_entry;
+
+        AGPUPipelineLayoutDescriptor layout_desc = {};
+        layout_desc.shaders                      = &compute_entry;
+        layout_desc.shader_count                 = 1;
+        compute_layout                           = agpu_create_pipeline_layout(device, &layout_desc);
+        layout_desc.shaders                      = render_entries;
+        layout_desc.shader_count                 = 2;
+        render_layout                            = agpu_create_pipeline_layout(device, &layout_desc);
+
+        blend_state.src_factors[0]       = AGPU_BLEND_CONST_ONE;
+        blend_state.dst_factors[0]       = AGPU_BLEND_CONST_ZERO;
+        blend_state.src_alpha_factors[0] = AGPU_BLEND_CONST_ONE;
+        blend_state.dst_alpha_factors[0] = AGPU_BLEND_CONST_ZERO;
+        blend_state.blend_modes[0]       = AGPU_BLEND_MODE_ADD;
+        blend_state.blend_alpha_modes[0] = AGPU_BLEND_MODE_ADD;
+        blend_state.masks[0]             = 0xF;
+
+        compute_pso = create_compute_pipeline();
+        render_pso  = create_render_pipeline();
+
+        // the cache keeps one reference to each, so the hit benchmarks never drop the last one
+        const AGPUComputePipelineDescriptor compute_desc = compute_pipeline_desc();
+        const AGPURenderPipelineDescriptor  render_desc  = render_pipeline_desc();
+        pso_cache                                        = agpux_create_pso_cache(device, ATOM_NULLPTR);
+        agpux_pso_cache_acquire_compute_pipeline(pso_cache, &compute_desc);
+        agpux_pso_cache_acquire_render_pipeline(pso_cache, &render_desc);
+
+        AGPUBufferDescriptor buffer_desc = {};
+        buffer_desc.name                 = u8"agpu_benchmark::counters";
+        buffer_desc.size                 = kCounterBufferSize;
+        buffer_desc.descriptors          = AGPU_RESOURCE_TYPE_RW_BUFFER;
+        buffer_desc.memory_usage         = AGPU_MEM_USAGE_GPU_ONLY;
+        buffer_desc.start_state          = AGPU_RESOURCE_STATE_UNORDERED_ACCESS;
+        counters                         = agpu_create_buffer(device, &buffer_desc);
+
+        AGPUDescriptorSetDescriptor set_desc = {compute_layout, 0};
+        compute_set                          = agpu_create_descriptor_set(device, &set_desc);
+        update_compute_set(u8"counters");
+
+        create_render_target(device, &render_target, &render_view);
+
+        device_desc.disable_dynamic_rendering = true;
+        device_desc.pass_cache_retire_frames  = kPassRetireFrames;
+        pass_device                           = agpu_create_device(adapter, &device_desc);
+        pass_queue                            = agpu_get_queue(pass_device, AGPU_QUEUE_TYPE_GRAPHICS, 0);
+        pass_cmd_pool                         = agpu_create_command_pool(pass_queue, &pool_desc);
+        pass_cmd                              = agpu_create_command_buffer(pass_cmd_pool, &cmd_desc);
+        pass_fence                            = agpu_create_fence(pass_device);
+        create_render_target(pass_device, &pass_target, &pass_view);
+    }
+
+    void create_render_target(AGPUDeviceIter target_device, AGPUTextureIter* texture, AGPUTextureViewIter* view)
+    {
+        AGPUTextureDescriptor texture_desc = {};
+        texture_desc.name                  = u8"agpu_benchmark::render_target";
+        texture_desc.width                 = kRenderTargetExtent;
+        texture_desc.height                = kRenderTargetExtent;
+        texture_desc.depth                 = 1;
+        texture_desc.array_size            = 1;
+        texture_desc.mip_levels            = 1;
+        texture_desc.format                = color_format;
+        texture_desc.sample_count          = AGPU_SAMPLE_COUNT_1;
+        texture_desc.start_state           = AGPU_RESOURCE_STATE_RENDER_TARGET;
+        texture_desc.descriptors           = AGPU_RESOURCE_TYPE_RENDER_TARGET;
+        *texture                           = agpu_create_texture(target_device, &texture_desc);
+
+        AGPUTextureViewDescriptor view_desc = {};
+        view_desc.name                      = u8"agpu_benchmark::render_target";
+        view_desc.texture                   = *texture;
+        view_desc.format                    = color_format;
+        view_desc.usages                    = AGPU_TVU_RTV_DSV;
+        view_desc.aspects                   = AGPU_TVA_COLOR;
+        view_desc.dims                      = AGPU_TEX_DIMENSION_2D;
+        view_desc.array_layer_count         = 1;
+        view_desc.mip_level_count           = 1;
+        *view                               = agpu_create_texture_view(target_device, &view_desc);
+    }
+
+    AGPUComputePipelineDescriptor compute_pipeline_desc() { return {compute_layout, &compute_entry}; }
+
+    AGPUComputePipelineIter create_compute_pipeline()
+    {
+        const AGPUComputePipelineDescriptor desc = compute_pipeline_desc();
+        return agpu_create_compute_pipeline(device, &desc);
+    }
+
+    // const, the pipeline cache benchmarks build it on several threads at once
+    AGPURenderPipelineDescriptor render_pipeline_desc() const
+    {
+        AGPURenderPipelineDescriptor desc = {};
+        desc.pipeline_layout              = render_layout;
+        desc.vertex_shader                = &vertex_entry;
+        desc.fragment_shader              = &pixel_entry;
+        desc.blend_state                  = &blend_state;
+        desc.depth_state                  = &depth_state;
+        desc.color_formats                = &color_format;
+        desc.render_target_count          = 1;
+        desc.sample_count                 = AGPU_SAMPLE_COUNT_1;
+        desc.depth_stencil_format         = AGPU_FORMAT_UNDEFINED;
+        desc.prim_topology                = AGPU_PRIM_TOPO_TRI_LIST;
+        return desc;
+    }
+
+    AGPURenderPipelineIter create_render_pipeline()
+    {
+        const AGPURenderPipelineDescriptor desc = render_pipeline_desc();
+        return agpu_create_render_pipeline(device, &desc);
+    }
+
+    void update_compute_set(const char8_t* name)
+    {
+        AGPUDescriptorData data = {};
+        data.name               = name;
+        data.binding            = 0;
+        data.binding_type       = AGPU_RESOURCE_TYPE_RW_BUFFER;
+        data.buffers            = &counters;
+        data.count              = 1;
+        agpu_update_descriptor_set(compute_set, &data, 1);
+    }
+
+    void finalize()
+    {
+        if (!device) return;
+        agpu_wait_queue_idle(pass_queue);
+        agpu_free_texture_view(pass_view);
+        agpu_free_texture(pass_target);
+        agpu_free_fence(pass_fence);
+        agpu_free_command_buffer(pass_cmd);
+        agpu_free_command_pool(pass_cmd_pool);
+        agpu_free_queue(pass_queue);
+        agpu_free_device(pass_device);
+        agpu_wait_queue_idle(queue);
+        agpux_free_pso_cache(pso_cache);
+        agpu_free_texture_view(render_view);
+        agpu_free_texture(render_target);
+        agpu_free_descriptor_set(compute_set);
+        agpu_free_buffer(counters);
+        agpu_free_render_pipeline(render_pso);
+        agpu_free_compute_pipeline(compute_pso);
+        agpu_free_pipeline_layout(render_layout);
+        agpu_free_pipeline_layout(compute_layout);
+        agpu_free_shader_library(pixel_shader);
+        agpu_free_shader_library(vertex_shader);
+        agpu_free_shader_library(compute_shader);
+        agpu_free_fence(fence);
+        agpu_free_command_buffer(cmd);
+        agpu_free_command_pool(cmd_pool);
+        agpu_free_queue(queue);
+        agpu_free_device(device);
+        agpu_free_instance(instance);
+        device = ATOM_NULLPTR;
+    }
+};
+
+// resets the pool and records one batch per iteration, the command buffer is never submitted
+template <typename F>
+static void record_batches(benchmark::State& state, uint32_t ops_per_batch, F&& record)
+{
+    AGPUBenchContext& context = AGPUBenchContext::get();
+    for (auto _ : state) {
+        agpu_reset_command_pool(context.cmd_pool);
+        agpu_cmd_begin(context.cmd);
+        record(context);
+        agpu_cmd_end(context.cmd);
+    }
+    set_ns_per_op(state, ops_per_batch);
+}
+
+static void bm_buffer_create_free(benchmark::State& state)
+{
+    AGPUBenchContext&    context = AGPUBenchContext::get();
+    AGPUBufferDescriptor desc    = {};
+    desc.size                    = (uint64_t)state.range(0);
+    desc.descriptors             = AGPU_RESOURCE_TYPE_RW_BUFFER;
+    desc.memory_usage            = (eAGPUMemoryUsage)state.range(1);
+    desc.flags                   = desc.memory_usage == AGPU_MEM_USAGE_GPU_ONLY ? AGPU_BCF_NONE : AGPU_BCF_PERSISTENT_MAP_BIT;
+    for (auto _ : state) {
+        AGPUBufferIter buffer = agpu_create_buffer(context.device, &desc);
+        benchmark::DoNotOptimize(buffer);
+        agpu_free_buffer(buffer);
+    }
+    set_ns_per_op(state, 1);
+}
+
+static void bm_descriptor_set_create_free(benchmark::State& state)
+{
+    AGPUBenchContext&           context = AGPUBenchContext::get();
+    AGPUDescriptorSetDescriptor desc    = {context.compute_layout, 0};
+    for (auto _ : state) {
+        AGPUDescriptorSetIter set = agpu_create_descriptor_set(context.device, &desc);
+        benchmark::DoNotOptimize(set);
+        agpu_free_descriptor_set(set);
+    }
+    set_ns_per_op(state, 1);
+}
+
+static void bm_descriptor_set_update_by_name(benchmark::State& state)
+{
+    AGPUBenchContext& context = AGPUBenchContext::get();
+    for (auto _ : state) context.update_compute_set(u8"counters");
+    set_ns_per_op(state, 1);
+}
+
+static void bm_descriptor_set_update_by_binding(benchmark::State& state)
+{
+    AGPUBenchContext& context = AGPUBenchContext::get();
+    for (auto _ : state) context.update_compute_set(ATOM_NULLPTR);
+    set_ns_per_op(state, 1);
+}
+
+static void bm_descriptor_set_bind(benchmark::State& state)
+{
+    record_batches(state, kRecordOps, [](AGPUBenchContext& context) {
+        AGPUComputePassDescriptor  pass_desc = {u8"bind"};
+        AGPUComputePassEncoderIter encoder   = agpu_cmd_begin_compute_pass(context.cmd, &pass_desc);
+        agpu_compute_encoder_bind_pipeline(encoder, context.compute_pso);
+        for (uint32_t i = 0; i < kRecordOps; i++) agpu_compute_encoder_bind_descriptor_set(encoder, context.compute_set);
+        agpu_cmd_end_compute_pass(context.cmd, encoder);
+    });
+}
+
+static void bm_pipeline_layout_create_free(benchmark::State& state)
+{
+    AGPUBenchContext&            context = AGPUBenchContext::get();
+    AGPUPipelineLayoutDescriptor desc    = {};
+    desc.shaders                         = context.render_entries;
+    desc.shader_count                    = 2;
+    for (auto _ : state) {
+        AGPUPipelineLayoutIter layout = agpu_create_pipeline_layout(context.device, &desc);
+        benchmark::DoNotOptimize(layout);
+        agpu_free_pipeline_layout(layout);
+    }
+    set_ns_per_op(state, 1);
+}
+
+static void bm_compute_pipeline_create_free(benchmark::State& state)
+{
+    AGPUBenchContext& context = AGPUBenchContext::get();
+    for (auto _ : state) {
+        AGPUComputePipelineIter pipeline = context.create_compute_pipeline();
+        benchmark::DoNotOptimize(pipeline);
+        agpu_free_compute_pipeline(pipeline);
+    }
+    set_ns_per_op(state, 1);
+}
+
+static void bm_render_pipeline_create_free(benchmark::State& state)
+{
+    AGPUBenchContext& context = AGPUBenchContext::get();
+    for (auto _ : state) {
+        AGPURenderPipelineIter pipeline = context.create_render_pipeline();
+        benchmark::DoNotOptimize(pipeline);
+        agpu_free_render_pipeline(pipeline);
+    }
+    set_ns_per_op(state, 1);
+}
+
+static void set_pso_cache_hit_rate(benchmark::State& state, AGPUXPsoCacheIter cache)
+{
+    if (state.thread_index() != 0) return;
+    AGPUXPsoCacheStatistics stats = {};
+    agpux_pso_cache_query_statistics(cache, &stats);
+    const uint64_t hits   = stats.render_hits + stats.compute_hits;
+    const uint64_t misses = stats.render_misses + stats.compute_misses;
+
+    state.counters["hit_rate"] = hits + misses ? (double)hits / (double)(hits + misses) : 0.0;
+}
+
+// what a lookup per draw costs next to the create benchmarks above, threads contend on the same descriptor
+static void bm_compute_pipeline_cache_hit(benchmark::State& state)
+{
+    AGPUBenchContext&                   context = AGPUBenchContext::get();
+    const AGPUComputePipelineDescriptor desc    = context.compute_pipeline_desc();
+    for (auto _ : state) {
+        AGPUComputePipelineIter pipeline = agpux_pso_cache_acquire_compute_pipeline(context.pso_cache, &desc);
+        benchmark::DoNotOptimize(pipeline);
+        agpux_pso_cache_release_compute_pipeline(context.pso_cache, pipeline);
+    }
+    set_ns_per_op(state, 1);
+    set_pso_cache_hit_rate(state, context.pso_cache);
+}
+
+static void bm_render_pipeline_cache_hit(benchmark::State& state)
+{
+    AGPUBenchContext&                  context = AGPUBenchContext::get();
+    const AGPURenderPipelineDescriptor desc    = context.render_pipeline_desc();
+    for (auto _ : state) {
+        AGPURenderPipelineIter pipeline = agpux_pso_cache_acquire_render_pipeline(context.pso_cache, &desc);
+        benchmark::DoNotOptimize(pipeline);
+        agpux_pso_cache_release_render_pipeline(context.pso_cache, pipeline);
+    }
+    set_ns_per_op(state, 1);
+    set_pso_cache_hit_rate(state, context.pso_cache);
+}
+
+static void bm_buffer_barrier_record(benchmark::State& state)
+{
+    record_batches(state, kBarrierOps, [](AGPUBenchContext& context) {
+        AGPUBufferBarrier barrier = {};
+        barrier.buffer            = context.counters;
+        barrier.src_state         = AGPU_RESOURCE_STATE_UNORDERED_ACCESS;
+        barrier.dst_state         = AGPU_RESOURCE_STATE_UNORDERED_ACCESS;
+        AGPUResourceBarrierDescriptor desc = {};
+        desc.buffer_barriers               = &barrier;
+        desc.buffer_barriers_count         = 1;
+        for (uint32_t i = 0; i < kBarrierOps; i++) agpu_cmd_resource_barrier(context.cmd, &desc);
+    });
+}
+
+static void bm_dispatch_record(benchmark::State& state)
+{
+    record_batches(state, kRecordOps, [](AGPUBenchContext& context) {
+        AGPUComputePassDescriptor  pass_desc = {u8"dispatch"};
+        AGPUComputePassEncoderIter encoder   = agpu_cmd_begin_compute_pass(context.cmd, &pass_desc);
+        agpu_compute_encoder_bind_pipeline(encoder, context.compute_pso);
+        agpu_compute_encoder_bind_descriptor_set(encoder, context.compute_set);
+        for (uint32_t i = 0; i < kRecordOps; i++) agpu_compute_encoder_dispatch(encoder, 1, 1, 1);
+        agpu_cmd_end_compute_pass(context.cmd, encoder);
+    });
+}
+
+static void bm_draw_record(benchmark::State& state)
+{
+    record_batches(state, kRecordOps, [](AGPUBenchContext& context) {
+        AGPUColorAttachment attachment = {};
+        attachment.view                = context.render_view;
+        attachment.load_action         = AGPU_LOAD_ACTION_CLEAR;
+        attachment.store_action        = AGPU_STORE_ACTION_STORE;
+        AGPURenderPassDescriptor pass_desc = {};
+        pass_desc.name                     = u8"draw";
+        pass_desc.sample_count             = AGPU_SAMPLE_COUNT_1;
+        pass_desc.color_attachments        = &attachment;
+        pass_desc.render_target_count      = 1;
+        AGPURenderPassEncoderIter encoder  = agpu_cmd_begin_render_pass(context.cmd, &pass_desc);
+        agpu_render_encoder_set_viewport(encoder, 0.f, 0.f, (float)kRenderTargetExtent, (float)kRenderTargetExtent, 0.f, 1.f);
+        agpu_render_encoder_set_scissor(encoder, 0, 0, kRenderTargetExtent, kRenderTargetExtent);
+        agpu_render_encoder_bind_pipeline(encoder, context.render_pso);
+        for (uint32_t i = 0; i < kRecordOps; i++) agpu_render_encoder_draw(encoder, 3, 0);
+        agpu_cmd_end_render_pass(context.cmd, encoder);
+    });
+}
+
+// empty passes, so this is what beginning a pass costs: cache lookups or a bare vkCmdBeginRendering
+static void bm_render_pass_record(benchmark::State& state)
+{
+    record_batches(state, kPassOps, [](AGPUBenchContext& context) {
+        AGPUColorAttachment attachment = {};
+        attachment.view                = context.render_view;
+        attachment.load_action         = AGPU_LOAD_ACTION_DONTCARE;
+        attachment.store_action        = AGPU_STORE_ACTION_STORE;
+        AGPURenderPassDescriptor pass_desc = {};
+        pass_desc.name                     = u8"empty";
+        pass_desc.sample_count             = AGPU_SAMPLE_COUNT_1;
+        pass_desc.color_attachments        = &attachment;
+        pass_desc.render_target_count      = 1;
+        for (uint32_t i = 0; i < kPassOps; i++)
+            agpu_cmd_end_render_pass(context.cmd, agpu_cmd_begin_render_pass(context.cmd, &pass_desc));
+    });
+}
+
+// records and submits one frame on the pass device, with a single empty render pass or with nothing at all
+static void submit_pass_frame(AGPUBenchContext& context, bool with_pass)
+{
+    agpu_device_begin_frame(context.pass_device);
+    agpu_reset_command_pool(context.pass_cmd_pool);
+    agpu_cmd_begin(context.pass_cmd);
+    if (with_pass) {
+        AGPUColorAttachment attachment = {};
+        attachment.view                = context.pass_view;
+        attachment.load_action         = AGPU_LOAD_ACTION_DONTCARE;
+        attachment.store_action        = AGPU_STORE_ACTION_STORE;
+        AGPURenderPassDescriptor pass_desc = {};
+        pass_desc.name                     = u8"evicted";
+        pass_desc.sample_count             = AGPU_SAMPLE_COUNT_1;
+        pass_desc.color_attachments        = &attachment;
+        pass_desc.render_target_count      = 1;
+        agpu_cmd_end_render_pass(context.pass_cmd, agpu_cmd_begin_render_pass(context.pass_cmd, &pass_desc));
+    }
+    agpu_cmd_end(context.pass_cmd);
+    AGPUQueueSubmitDescriptor desc = {};
+    desc.cmds                      = &context.pass_cmd;
+    desc.cmds_count                = 1;
+    desc.signal_fence              = context.pass_fence;
+    agpu_submit_queue(context.pass_queue, &desc);
+    agpu_wait_fences(&context.pass_fence, 1);
+}
+
+// a pass used once and then left alone, frames are advanced until the cache destroys it. fails unless both the render
+// pass and its framebuffer go exactly kPassRetireFrames frames after their last use, reports the cost of one frame
+static void bm_render_pass_cache_eviction(benchmark::State& state)
+{
+    AGPUBenchContext&       context = AGPUBenchContext::get();
+    AGPUPassCacheStatistics before  = {};
+    AGPUPassCacheStatistics after   = {};
+    uint64_t                frames  = 0;
+    for (auto _ : state) {
+        agpu_query_pass_cache_statistics(context.pass_device, &before);
+        submit_pass_frame(context, true);
+        uint32_t unused = 0;
+        do {
+            submit_pass_frame(context, false);
+            agpu_query_pass_cache_statistics(context.pass_device, &after);
+            unused++;
+        } while (after.render_pass_evictions == before.render_pass_evictions && unused <= kPassRetireFrames);
+        frames += unused + 1;
+        if (unused != kPassRetireFrames || after.framebuffer_evictions == before.framebuffer_evictions
+            || after.render_pass_count || after.framebuffer_count) {
+            state.SkipWithError("pass cache did not evict the unused pass after kPassRetireFrames frames");
+            break;
+        }
+    }
+    state.counters["ns/frame"] =
+        benchmark::Counter((double)frames * 1e-9, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// an empty command buffer, so this is the submission round trip through the driver
+static void bm_queue_submit_wait(benchmark::State& state)
+{
+    AGPUBenchContext&         context = AGPUBenchContext::get();
+    AGPUQueueSubmitDescriptor desc    = {};
+    desc.cmds                         = &context.cmd;
+    desc.cmds_count                   = 1;
+    desc.signal_fence                 = context.fence;
+    for (auto _ : state) {
+        // command buffers are begun as one-time-submit, so each submit needs a fresh recording
+        state.PauseTiming();
+        agpu_reset_command_pool(context.cmd_pool);
+        agpu_cmd_begin(context.cmd);
+        agpu_cmd_end(context.cmd);
+        agpu_device_begin_frame(context.device);
+        state.ResumeTiming();
+        agpu_submit_queue(context.queue, &desc);
+        agpu_wait_fences(&context.fence, 1);
+    }
+    set_ns_per_op(state, 1);
+}
+
+// {size, eAGPUMemoryUsage}
+BENCHMARK(bm_buffer_create_free)
+    ->Args({256, AGPU_MEM_USAGE_GPU_ONLY})
+    ->Args({64 * 1024, AGPU_MEM_USAGE_GPU_ONLY})
+    ->Args({64 * 1024, AGPU_MEM_USAGE_CPU_TO_GPU})
+    ->Args({16 * 1024 * 1024, AGPU_MEM_USAGE_GPU_ONLY});
+BENCHMARK(bm_descriptor_set_create_free);
+BENCHMARK(bm_descriptor_set_update_by_name);
+BENCHMARK(bm_descriptor_set_update_by_binding);
+BENCHMARK(bm_descriptor_set_bind)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_pipeline_layout_create_free);
+BENCHMARK(bm_compute_pipeline_create_free)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bm_render_pipeline_create_free)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bm_compute_pipeline_cache_hit)->ThreadRange(1, 8);
+BENCHMARK(bm_render_pipeline_cache_hit)->ThreadRange(1, 8);
+BENCHMARK(bm_buffer_barrier_record)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_dispatch_record)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_draw_record)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_render_pass_record)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_render_pass_cache_eviction)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bm_queue_submit_wait)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    // up front, threaded benchmarks must not race on the first use
+    AGPUBenchContext::get();
+    benchmark::RunSpecifiedBenchmarks();
+    // device objects must go before the vulkan loader unloads at exit
+    AGPUBenchContext::get().finalize();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,8 @@
+#version 460
+
+// oversized triangle covering the viewport
+void main()
+{
+    vec2 texCoords = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position    = vec4(texCoords * 2 - 1, 1.f, 1.f);
+}
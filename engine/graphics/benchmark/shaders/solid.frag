@@ -0,0 +1,8 @@
+#version 460
+
+layout(location = 0) out vec4 outputColor;
+
+void main()
+{
+    outputColor = vec4(1.f, 0.f, 1.f, 1.f);
+}
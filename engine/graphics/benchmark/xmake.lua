@@ -0,0 +1,13 @@
+if has_config("benchmarks") then
+    -- runs headless, VK_ICD_FILENAMES=<path to lvp_icd.json> xmake run AtomEngine_Graphics_Benchmark pins it to lavapipe
+    target("AtomEngine_Graphics_Benchmark")
+        set_kind("binary")
+        set_default(false)
+        add_rules("utils.glsl2spv", {targetenv = "vulkan1.3", bin2c = true})
+        add_files("./shaders/*.vert", "./shaders/*.frag", "./shaders/*.comp")
+        add_files("./*.cpp")
+        add_deps("AtomEngine_Graphics_AGPU")
+        add_packages("benchmark")
+        set_runargs("--benchmark_out=agpu_benchmark.json", "--benchmark_out_format=json")
+    target_end()
+end
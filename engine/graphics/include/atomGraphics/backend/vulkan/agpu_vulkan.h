@@ -45,6 +45,9 @@ ATOM_API uint32_t                 agpu_query_queue_count_vulkan(const AGPUAdapte
 ATOM_API AGPUDeviceIter agpu_create_device_vulkan(AGPUAdapterIter adapter, const AGPUDeviceDescriptor* desc);
 ATOM_API void           agpu_query_video_memory_info_vulkan(const AGPUDeviceIter device, uint64_t* total, uint64_t* used_bytes);
 ATOM_API void agpu_query_shared_memory_info_vulkan(const AGPUDeviceIter device, uint64_t* total, uint64_t* used_bytes);
+ATOM_API void agpu_query_pass_cache_statistics_vulkan(const AGPUDeviceIter device, AGPUPassCacheStatistics* statistics);
+ATOM_API void agpu_device_begin_frame_vulkan(AGPUDeviceIter device, uint64_t frame);
+ATOM_API bool agpu_save_pipeline_cache_vulkan(AGPUDeviceIter device);
 ATOM_API void agpu_free_device_vulkan(AGPUDeviceIter device);
 
 // API Object APIs
@@ -72,6 +75,12 @@ ATOM_API void                    agpu_free_compute_pipeline_vulkan(AGPUComputePi
 ATOM_API AGPURenderPipelineIter  agpu_create_render_pipeline_vulkan(AGPUDeviceIter                             device,
                                                                     const struct AGPURenderPipelineDescriptor* desc);
 ATOM_API void                    agpu_free_render_pipeline_vulkan(AGPURenderPipelineIter pipeline);
+ATOM_API AGPUComputePipelineIter
+    agpu_create_compute_pipeline_async_vulkan(AGPUDeviceIter device, const struct AGPUComputePipelineDescriptor* desc);
+ATOM_API AGPURenderPipelineIter
+    agpu_create_render_pipeline_async_vulkan(AGPUDeviceIter device, const struct AGPURenderPipelineDescriptor* desc);
+ATOM_API void agpu_wait_compute_pipeline_vulkan(AGPUComputePipelineIter pipeline);
+ATOM_API void agpu_wait_render_pipeline_vulkan(AGPURenderPipelineIter pipeline);
 ATOM_API AGPUQueryPoolIter agpu_create_query_pool_vulkan(AGPUDeviceIter device, const struct AGPUQueryPoolDescriptor* desc);
 ATOM_API void              agpu_free_query_pool_vulkan(AGPUQueryPoolIter pool);
 
@@ -318,10 +327,29 @@ typedef struct VulkanAdapter {
     AGPUAdapterDetail adapter_detail;
 } VulkanAdapter;
 
+// fixed-size backend objects are recycled through per-device slab pools instead of the global heap
+typedef enum eVulkanObjectPool {
+    VK_OBJECT_POOL_BUFFER,
+    VK_OBJECT_POOL_TEXTURE,
+    VK_OBJECT_POOL_TEXTURE_VIEW,
+    VK_OBJECT_POOL_SAMPLER,
+    VK_OBJECT_POOL_FENCE,
+    VK_OBJECT_POOL_SEMAPHORE,
+    VK_OBJECT_POOL_COMMAND_BUFFER,
+    VK_OBJECT_POOL_COUNT
+} eVulkanObjectPool;
+
 typedef struct VulkanDevice {
     AGPUDevice                    super;
     VkDevice                      pVkDevice;
     VkPipelineCache               pPipelineCache;
+    // file the pipeline cache is loaded from and saved to, NULL when it is not persisted
+    char8_t*                      pPipelineCachePath;
+    uint32_t                      mPipelineCacheSaveInterval;
+    _Atomic(uint32_t)             mPipelinesSinceSave;
+    _Atomic(uint32_t)             mPipelineCacheSaving;
+    // periodic saves in flight, waited for before the final save at teardown
+    struct atom_job_counter_t*    pPipelineCacheSaveCounter;
     struct VulkanDescriptorPool*  pDescriptorPool;
     struct VmaAllocator_T*        pVmaAllocator;
     struct VmaPool_T*             pExternalMemoryVmaPools[VK_MAX_MEMORY_TYPES];
@@ -330,13 +358,18 @@ typedef struct VulkanDevice {
     struct VolkDeviceTable        mVkDeviceTable;
     // Created renderpass table
     struct VulkanRenderPassTable* pPassTable;
+    struct atom_object_pool_t*    pObjectPools[VK_OBJECT_POOL_COUNT];
     uint32_t                      next_shared_id;
+    // passes begin with vkCmdBeginRendering and pipelines carry their attachment formats, pPassTable stays unused
+    uint32_t                      mDynamicRendering : 1;
 } VulkanDevice;
 
 typedef struct VulkanFence {
     AGPUFence super;
     VkFence   pVkFence;
     uint32_t  mSubmitted : 1;
+    // frame arena frame the last submission belongs to, retired on completion
+    uint64_t  mFrameIndex;
 } VulkanFence;
 
 typedef struct VulkanSemaphore {
@@ -363,9 +396,10 @@ typedef struct VulkanCommandPool {
 } VulkanCommandPool;
 
 typedef struct VulkanQueryPool {
-    AGPUQueryPool super;
-    VkQueryPool   pVkQueryPool;
-    VkQueryType   mType;
+    AGPUQueryPool       super;
+    VkQueryPool         pVkQueryPool;
+    VkQueryType         mType;
+    VkQueryControlFlags mControlFlags;
 } VulkanQueryPool;
 
 typedef struct VulkanCommandBuffer {
@@ -375,6 +409,8 @@ typedef struct VulkanCommandBuffer {
     VkRenderPass      pRenderPass;
     uint32_t          mNodeIndex : 4;
     uint32_t          mType      : 3;
+    // the bound pipeline is still compiling and had no fallback, draws and dispatches are dropped until the next bind
+    uint32_t          mSkipDraws : 1;
 } VulkanCommandBuffer;
 
 typedef struct VulkanBuffer {
@@ -478,13 +514,16 @@ typedef struct VulkanDescriptorSet {
 } VulkanDescriptorSet;
 
 typedef struct VulkanComputePipeline {
-    AGPUComputePipeline super;
-    VkPipeline          pVkPipeline;
+    AGPUComputePipeline        super;
+    VkPipeline                 pVkPipeline;
+    // async pipelines only, counts the compile job until it finished
+    struct atom_job_counter_t* pCompileCounter;
 } VulkanComputePipeline;
 
 typedef struct VulkanRenderPipeline {
-    AGPURenderPipeline super;
-    VkPipeline         pVkPipeline;
+    AGPURenderPipeline         super;
+    VkPipeline                 pVkPipeline;
+    struct atom_job_counter_t* pCompileCounter;
 } VulkanRenderPipeline;
 
 static const VkPipelineBindPoint gPipelineBindPoint[AGPU_PIPELINE_TYPE_COUNT] = {VK_PIPELINE_BIND_POINT_MAX_ENUM,
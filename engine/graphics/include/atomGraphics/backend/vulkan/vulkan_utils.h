@@ -41,10 +41,15 @@ void vulkan_query_all_adapters(VulkanInstance*    I,
                                uint32_t           device_extension_count);
 
 // Device Helpers
-void vulkan_create_pipeline_cache(VulkanDevice* D);
+void vulkan_create_pipeline_cache(VulkanDevice* D, const struct AGPUDeviceDescriptor* desc);
+bool vulkan_save_pipeline_cache(VulkanDevice* D);
+// counts towards AGPUDeviceDescriptor::pipeline_cache_save_interval
+void vulkan_pipeline_cache_on_pipeline_created(VulkanDevice* D);
 void vulkan_create_vma_allocator(VulkanInstance* I, VulkanAdapter* A, VulkanDevice* D);
 void vulkan_free_vma_allocator(VulkanInstance* I, VulkanAdapter* A, VulkanDevice* D);
 void vulkan_free_pipeline_cache(VulkanInstance* I, VulkanAdapter* A, VulkanDevice* D);
+void vulkan_create_object_pools(VulkanDevice* D);
+void vulkan_free_object_pools(VulkanDevice* D);
 
 // API Objects Helpers
 struct VulkanDescriptorPool* vulkan_create_desciptor_pool(VulkanDevice* D);
@@ -94,6 +99,8 @@ VkFramebuffer vulkan_frame_buffer_table_try_bind(struct VulkanRenderPassTable*
 void          vulkan_frame_buffer_table_add(struct VulkanRenderPassTable*             table,
                                             const struct VulkanFramebufferDescriptor* desc,
                                             VkFramebuffer                             framebuffer);
+// drops the framebuffers over a view that is about to be destroyed, they are freed once their last frame retired
+void          vulkan_frame_buffer_table_forget_image_view(struct VulkanRenderPassTable* table, VkImageView view);
 
 // Debug Helpers
 VKAPI_ATTR VkBool32 VKAPI_CALL vulkan_debug_utils_callback(VkDebugUtilsMessageSeverityFlagBitsEXT      messageSeverity,
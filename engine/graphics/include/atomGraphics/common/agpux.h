@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomCore/profile.h>
 #include <atomGraphics/common/api.h>
 
 typedef const char8_t* AGPUXName;
 DEFINE_AGPU_OBJECT(AGPUXBindTable)
 DEFINE_AGPU_OBJECT(AGPUXMergedBindTable)
+DEFINE_AGPU_OBJECT(AGPUXGpuProfiler)
+DEFINE_AGPU_OBJECT(AGPUXQueryRing)
+DEFINE_AGPU_OBJECT(AGPUXPsoCache)
 struct AGPUXBindTableDescriptor;
 struct AGPUXMergedBindTableDescriptor;
 
@@ -36,6 +40,137 @@ ATOM_EXTERN_C ATOM_API void agpux_compute_encoder_bind_merged_bind_table(AGPUCom
 
 ATOM_EXTERN_C ATOM_API void agpux_free_merged_bind_table(AGPUXMergedBindTableIter merged_table);
 
+// fence reactor
+// a background thread polls the status of watched fences in batches and calls back once they completed, so waiting
+// on the gpu does not block a thread per fence. completed fences are reset like agpu_wait_fences() does, fences that
+// were never submitted complete right away. a watched fence must not be submitted, waited on or freed until its
+// callback ran. callbacks run on the reactor thread and should hand heavier work to the job system.
+typedef void (*AGPUXFenceCallback)(AGPUFenceIter fence, void* user_data);
+
+ATOM_EXTERN_C ATOM_API void agpux_fence_reactor_watch(AGPUFenceIter fence, AGPUXFenceCallback callback, void* user_data);
+// blocks on the fences still watched, runs their callbacks and stops the thread. required before freeing the devices,
+// nothing shuts the reactor down at exit
+ATOM_EXTERN_C ATOM_API void agpux_fence_reactor_shutdown();
+
+// fences of the device whose callback has not run yet, agpu_free_device asserts there are none
+ATOM_EXTERN_C ATOM_API uint32_t agpux_fence_reactor_watch_count(AGPUDeviceIter device);
+
+// gpu profiler
+// zones write a timestamp query at their begin and end and open a debug event with the zone name, so captures in
+// external tools show the same scopes. every frame in flight owns a range of one query pool and a readback buffer,
+// a frame is read back when its slot comes around again, at which point its fence was already waited on. zones are
+// converted onto the atom_profile_time_ns() clock and emitted into a profiler track while a capture runs.
+// begin_frame resets queries and must be recorded outside of any pass, zones must nest within one command buffer.
+#define AGPUX_GPU_ZONE_INVALID UINT32_MAX
+
+typedef struct AGPUXGpuZone {
+    const atom_profile_site_t* site;
+    uint32_t                   depth;
+    int64_t                    begin_ns;
+    int64_t                    end_ns;
+} AGPUXGpuZone;
+
+// submits a timestamp on the queue and blocks until it arrived, must not race other submits to the queue
+ATOM_EXTERN_C ATOM_API AGPUXGpuProfilerIter agpux_create_gpu_profiler(AGPUDeviceIter                          device,
+                                                                      const struct AGPUXGpuProfilerDescriptor* desc);
+
+ATOM_EXTERN_C ATOM_API void agpux_gpu_profiler_begin_frame(AGPUXGpuProfilerIter profiler, AGPUCommandBufferIter cmd);
+
+ATOM_EXTERN_C ATOM_API void agpux_gpu_profiler_end_frame(AGPUXGpuProfilerIter profiler, AGPUCommandBufferIter cmd);
+
+// returns AGPUX_GPU_ZONE_INVALID once the frame ran out of queries, the debug event is recorded regardless
+ATOM_EXTERN_C ATOM_API uint32_t agpux_gpu_profiler_begin_zone(AGPUXGpuProfilerIter       profiler,
+                                                              AGPUCommandBufferIter      cmd,
+                                                              const atom_profile_site_t* site);
+
+ATOM_EXTERN_C ATOM_API void agpux_gpu_profiler_end_zone(AGPUXGpuProfilerIter  profiler,
+                                                        AGPUCommandBufferIter cmd,
+                                                        uint32_t              zone);
+
+// zones of the most recently read back frame, valid until the next begin_frame
+ATOM_EXTERN_C ATOM_API const AGPUXGpuZone* agpux_gpu_profiler_get_zones(AGPUXGpuProfilerIter profiler, uint32_t* count);
+
+// measures the gpu to cpu clock offset again, gpu clocks drift over long sessions. same constraints as creation
+ATOM_EXTERN_C ATOM_API void agpux_gpu_profiler_calibrate(AGPUXGpuProfilerIter profiler);
+
+ATOM_EXTERN_C ATOM_API void agpux_free_gpu_profiler(AGPUXGpuProfilerIter profiler);
+
+#define AGPUX_GPU_ZONE_BEGIN(var, profiler, cmd, name)                                   \
+    static const atom_profile_site_t var##_site_ = {(name), __FILE__, __LINE__};         \
+    const uint32_t                   var         = agpux_gpu_profiler_begin_zone((profiler), (cmd), &var##_site_)
+#define AGPUX_GPU_ZONE_END(var, profiler, cmd) agpux_gpu_profiler_end_zone((profiler), (cmd), (var))
+
+// query ring
+// pipeline statistics or occlusion queries per pass, ring-buffered over the frames in flight like the gpu profiler.
+// each frame resolves its queries into its own persistently mapped readback buffer, which begin_frame reads once the
+// slot comes around again, so results show up frames_in_flight frames late without the cpu waiting on the gpu.
+// begin_frame must be recorded outside of any pass, a query must begin and end within the same pass.
+#define AGPUX_QUERY_INVALID UINT32_MAX
+
+typedef struct AGPUXQueryResult {
+    // name given to agpux_query_ring_begin
+    const char8_t*  name;
+    // AGPUQueryPool::result_count counters, enabled statistics in bit order or the occlusion sample count
+    const uint64_t* values;
+} AGPUXQueryResult;
+
+ATOM_EXTERN_C ATOM_API AGPUXQueryRingIter agpux_create_query_ring(AGPUDeviceIter                        device,
+                                                                  const struct AGPUXQueryRingDescriptor* desc);
+
+ATOM_EXTERN_C ATOM_API void agpux_query_ring_begin_frame(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd);
+
+ATOM_EXTERN_C ATOM_API void agpux_query_ring_end_frame(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd);
+
+// name must stay valid until the frame was read back, returns AGPUX_QUERY_INVALID once the frame ran out of queries
+ATOM_EXTERN_C ATOM_API uint32_t agpux_query_ring_begin(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd, const char8_t* name);
+
+ATOM_EXTERN_C ATOM_API void agpux_query_ring_end(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd, uint32_t query);
+
+// results of the most recently read back frame, valid until the next begin_frame
+ATOM_EXTERN_C ATOM_API const AGPUXQueryResult* agpux_query_ring_get_results(AGPUXQueryRingIter ring, uint32_t* count);
+
+// picks one counter out of a pipeline statistics result, 0 if the ring does not collect it
+ATOM_EXTERN_C ATOM_API uint64_t agpux_query_ring_statistic(AGPUXQueryRingIter      ring,
+                                                           const AGPUXQueryResult* result,
+                                                           eAGPUPipelineStatistic  statistic);
+
+ATOM_EXTERN_C ATOM_API void agpux_free_query_ring(AGPUXQueryRingIter ring);
+
+// pso cache
+// deduplicates pipelines of a device by descriptor: acquiring an equal descriptor again hands out the same pipeline and
+// takes a reference, the pipeline is freed with its last release. descriptors are keyed on their std::hash from
+// agpux.hpp and told apart with std::equal_to against a copy the cache keeps. hits and all but the last release only
+// take the shared lock of one submap, so concurrent lookups do not wait on each other. misses compile outside of any
+// lock, when two threads miss on the same descriptor the later one frees its pipeline and takes the other. shader
+// libraries and pipeline layouts have to outlive the cached pipelines.
+typedef struct AGPUXPsoCacheStatistics {
+    uint64_t render_hits;
+    uint64_t render_misses;
+    uint64_t compute_hits;
+    uint64_t compute_misses;
+    // pipelines currently cached
+    uint32_t render_pipeline_count;
+    uint32_t compute_pipeline_count;
+} AGPUXPsoCacheStatistics;
+
+ATOM_EXTERN_C ATOM_API AGPUXPsoCacheIter agpux_create_pso_cache(AGPUDeviceIter                       device,
+                                                                 const struct AGPUXPsoCacheDescriptor* desc);
+
+ATOM_EXTERN_C ATOM_API AGPURenderPipelineIter
+    agpux_pso_cache_acquire_render_pipeline(AGPUXPsoCacheIter cache, const struct AGPURenderPipelineDescriptor* desc);
+
+ATOM_EXTERN_C ATOM_API AGPUComputePipelineIter
+    agpux_pso_cache_acquire_compute_pipeline(AGPUXPsoCacheIter cache, const struct AGPUComputePipelineDescriptor* desc);
+
+ATOM_EXTERN_C ATOM_API void agpux_pso_cache_release_render_pipeline(AGPUXPsoCacheIter cache, AGPURenderPipelineIter pipeline);
+
+ATOM_EXTERN_C ATOM_API void agpux_pso_cache_release_compute_pipeline(AGPUXPsoCacheIter cache, AGPUComputePipelineIter pipeline);
+
+ATOM_EXTERN_C ATOM_API void agpux_pso_cache_query_statistics(AGPUXPsoCacheIter cache, AGPUXPsoCacheStatistics* stats);
+
+// frees the pipelines that are still referenced as well
+ATOM_EXTERN_C ATOM_API void agpux_free_pso_cache(AGPUXPsoCacheIter cache);
+
 typedef struct AGPUXBindTableDescriptor {
     AGPUPipelineLayoutIter layout;
     const AGPUXName*       names;
@@ -45,3 +180,26 @@ typedef struct AGPUXBindTableDescriptor {
 typedef struct AGPUXMergedBindTableDescriptor {
     AGPUPipelineLayoutIter layout;
 } AGPUXMergedBindTableDescriptor;
+
+typedef struct AGPUXGpuProfilerDescriptor {
+    // queue the profiled command buffers are submitted to
+    AGPUQueueIter queue;
+    // track name in the exported trace
+    const char*   name;
+    uint32_t      frames_in_flight;
+    uint32_t      max_zones_per_frame;
+} AGPUXGpuProfilerDescriptor;
+
+typedef struct AGPUXQueryRingDescriptor {
+    // AGPU_QUERY_TYPE_PIPELINE_STATISTICS or AGPU_QUERY_TYPE_OCCLUSION
+    eAGPUQueryType         type;
+    AGPUPipelineStatistics pipeline_statistics;
+    bool                   precise_occlusion;
+    uint32_t               frames_in_flight;
+    uint32_t               max_queries_per_frame;
+} AGPUXQueryRingDescriptor;
+
+typedef struct AGPUXPsoCacheDescriptor {
+    // misses create pending pipelines with agpu_create_*_pipeline_async, pending render pipelines have no fallback
+    bool async_compile;
+} AGPUXPsoCacheDescriptor;
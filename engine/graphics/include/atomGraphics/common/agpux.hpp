@@ -132,6 +132,8 @@ struct equal_to<AGPUBlendStateDescriptor> {
 template <>
 struct hash<AGPUBlendStateDescriptor> {
     ATOM_API size_t operator()(const AGPUBlendStateDescriptor& val) const;
+
+    uint32_t count = AGPU_MAX_MRT_COUNT;
 };
 
 static const AGPUBlendStateDescriptor kZeroAGPUBlendStateDescriptor = make_zeroed<AGPUBlendStateDescriptor>();
@@ -187,4 +189,14 @@ template <>
 struct hash<hash<AGPURenderPipelineDescriptor>::ParameterBlock> {
     ATOM_API size_t operator()(const hash<AGPURenderPipelineDescriptor>::ParameterBlock& val) const;
 };
+
+template <>
+struct equal_to<AGPUComputePipelineDescriptor> {
+    ATOM_API size_t operator()(const AGPUComputePipelineDescriptor& a, const AGPUComputePipelineDescriptor& b) const;
+};
+
+template <>
+struct hash<AGPUComputePipelineDescriptor> {
+    ATOM_API size_t operator()(const AGPUComputePipelineDescriptor& val) const;
+};
 } // namespace std
\ No newline at end of file
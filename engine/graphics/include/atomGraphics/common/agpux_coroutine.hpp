@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomCore/coroutine.hpp>
+#include <atomGraphics/common/agpux.h>
+
+// co_await agpux_await_fence(fence) suspends the coroutine until the fence completed instead of blocking the thread
+// in agpu_wait_fences(). the fence reactor resumes it from a job (or on the reactor thread while the job system is
+// not initialized), so the coroutine may continue on another thread than the one that suspended it.
+struct AGPUXFenceAwaiter {
+    bool await_ready() const ATOM_NOEXCEPT
+    {
+        if (agpu_query_fence_status(fence) == AGPU_FENCE_STATUS_INCOMPLETE) return false;
+        agpu_wait_fences(&fence, 1);
+        return true;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const ATOM_NOEXCEPT
+    {
+        agpux_fence_reactor_watch(fence, &AGPUXFenceAwaiter::resume, handle.address());
+    }
+
+    void await_resume() const ATOM_NOEXCEPT {}
+
+    static void resume(AGPUFenceIter, void* address)
+    {
+        const atom_job_decl_t decl = {&atom::detail::resume_coroutine_job, address, ATOM_JOB_AFFINITY_ANY, false};
+        atom_job_run(&decl, 1, ATOM_NULLPTR);
+    }
+
+    AGPUFenceIter fence;
+};
+
+inline AGPUXFenceAwaiter agpux_await_fence(AGPUFenceIter fence) ATOM_NOEXCEPT { return AGPUXFenceAwaiter{fence}; }
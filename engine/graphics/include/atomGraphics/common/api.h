@@ -52,6 +52,7 @@ struct AGPUTextureToTextureTransfer;
 struct AGPUQueryDescriptor;
 struct AGPUDescriptorData;
 struct AGPUResourceBarrierDescriptor;
+struct AGPUPassCacheStatistics;
 struct AGPUTextureAliasingBindDescriptor;
 struct AGPURenderPassDescriptor;
 struct AGPUComputePassDescriptor;
@@ -145,6 +146,15 @@ ATOM_API void agpu_query_video_memory_info(const AGPUDeviceIter device, uint64_t
 typedef void (*AGPUProcQueryVideoMemoryInfo)(const AGPUDeviceIter device, uint64_t* total, uint64_t* used_bytes);
 ATOM_API void agpu_query_shared_memory_info(const AGPUDeviceIter device, uint64_t* total, uint64_t* used_bytes);
 typedef void (*AGPUProcQuerySharedMemoryInfo)(const AGPUDeviceIter device, uint64_t* total, uint64_t* used_bytes);
+ATOM_API void agpu_query_pass_cache_statistics(const AGPUDeviceIter device, struct AGPUPassCacheStatistics* statistics);
+typedef void (*AGPUProcQueryPassCacheStatistics)(const AGPUDeviceIter device, struct AGPUPassCacheStatistics* statistics);
+ATOM_API bool agpu_save_pipeline_cache(AGPUDeviceIter device);
+typedef bool (*AGPUProcSavePipelineCache)(AGPUDeviceIter device);
+// starts the next frame of the frame arena (atom_frame_arena_begin_frame), returns its index. agpu_queue_present calls it
+// after every present, loops that never present (headless, compute only) call it once per frame instead. backends
+// evict their per-frame caches (render passes, framebuffers) here
+ATOM_API uint64_t agpu_device_begin_frame(AGPUDeviceIter device);
+typedef void (*AGPUProcDeviceBeginFrame)(AGPUDeviceIter device, uint64_t frame);
 ATOM_API void agpu_free_device(AGPUDeviceIter device);
 typedef void (*AGPUProcFreeDevice)(AGPUDeviceIter device);
 
@@ -193,6 +203,26 @@ typedef AGPURenderPipelineIter (*AGPUProcCreateRenderPipeline)(AGPUDeviceIter
                                                                const struct AGPURenderPipelineDescriptor* desc);
 ATOM_API void agpu_free_render_pipeline(AGPURenderPipelineIter pipeline);
 typedef void (*AGPUProcFreeRenderPipeline)(AGPURenderPipelineIter pipeline);
+// the async variants return a pending pipeline right away and compile it on a job system worker against the device
+// pipeline cache. shader libraries and the pipeline layout have to outlive the compile, the descriptor does not.
+// binding a pending or failed compute pipeline skips dispatches until the next bind, a render pipeline draws with
+// its fallback instead (itself checked the same way) or skips draws when there is none.
+ATOM_API AGPUComputePipelineIter agpu_create_compute_pipeline_async(AGPUDeviceIter                              device,
+                                                                    const struct AGPUComputePipelineDescriptor* desc);
+typedef AGPUComputePipelineIter (*AGPUProcCreateComputePipelineAsync)(AGPUDeviceIter                              device,
+                                                                      const struct AGPUComputePipelineDescriptor* desc);
+ATOM_API AGPURenderPipelineIter agpu_create_render_pipeline_async(AGPUDeviceIter                             device,
+                                                                  const struct AGPURenderPipelineDescriptor* desc,
+                                                                  AGPURenderPipelineIter                     fallback);
+typedef AGPURenderPipelineIter (*AGPUProcCreateRenderPipelineAsync)(AGPUDeviceIter                             device,
+                                                                    const struct AGPURenderPipelineDescriptor* desc);
+ATOM_API eAGPUPipelineStatus agpu_query_compute_pipeline_status(AGPUComputePipelineIter pipeline);
+ATOM_API eAGPUPipelineStatus agpu_query_render_pipeline_status(AGPURenderPipelineIter pipeline);
+// helps the job system until the compile finished
+ATOM_API eAGPUPipelineStatus agpu_wait_compute_pipeline(AGPUComputePipelineIter pipeline);
+typedef void (*AGPUProcWaitComputePipeline)(AGPUComputePipelineIter pipeline);
+ATOM_API eAGPUPipelineStatus agpu_wait_render_pipeline(AGPURenderPipelineIter pipeline);
+typedef void (*AGPUProcWaitRenderPipeline)(AGPURenderPipelineIter pipeline);
 ATOM_API AGPUQueryPoolIter agpu_create_query_pool(AGPUDeviceIter, const struct AGPUQueryPoolDescriptor* desc);
 typedef AGPUQueryPoolIter (*AGPUProcCreateQueryPool)(AGPUDeviceIter, const struct AGPUQueryPoolDescriptor* desc);
 ATOM_API void agpu_free_query_pool(AGPUQueryPoolIter);
@@ -490,31 +520,38 @@ typedef struct AGPUProcTable {
     const AGPUProcQueryQueueCount       query_queue_count;
 
     // Device APIs
-    const AGPUProcCreateDevice create_device;
-    const AGPUProcFreeDevice   free_device;
+    const AGPUProcCreateDevice             create_device;
+    const AGPUProcQueryPassCacheStatistics query_pass_cache_statistics;
+    const AGPUProcDeviceBeginFrame         device_begin_frame;
+    const AGPUProcSavePipelineCache        save_pipeline_cache;
+    const AGPUProcFreeDevice               free_device;
 
     // API Objects
-    const AGPUProcCreateFence              create_fence;
-    const AGPUProcWaitFences               wait_fences;
-    const AGPUProcQueryFenceStatus         query_fence_status;
-    const AGPUProcFreeFence                free_fence;
-    const AGPUProcCreateSemaphore          create_semaphore;
-    const AGPUProcFreeSemaphore            free_semaphore;
-    const AGPUProcCreatePipelineLayoutPool create_pipeline_layout_pool;
-    const AGPUProcFreePipelineLayoutPool   free_pipeline_layout_pool;
-    const AGPUProcCreatePipelineLayout     create_pipeline_layout;
-    const AGPUProcFreePipelineLayout       free_pipeline_layout;
-    const AGPUProcCreateDescriptorSet      create_descriptor_set;
-    const AGPUProcFreeDescriptorSet        free_descriptor_set;
-    const AGPUProcUpdateDescriptorSet      update_descriptor_set;
-    const AGPUProcCreateComputePipeline    create_compute_pipeline;
-    const AGPUProcFreeComputePipeline      free_compute_pipeline;
-    const AGPUProcCreateRenderPipeline     create_render_pipeline;
-    const AGPUProcFreeRenderPipeline       free_render_pipeline;
-    const AGPUProcCreateMemoryPool         create_memory_pool;
-    const AGPUProcFreeMemoryPool           free_memory_pool;
-    const AGPUProcCreateQueryPool          create_query_pool;
-    const AGPUProcFreeQueryPool            free_query_pool;
+    const AGPUProcCreateFence                create_fence;
+    const AGPUProcWaitFences                 wait_fences;
+    const AGPUProcQueryFenceStatus           query_fence_status;
+    const AGPUProcFreeFence                  free_fence;
+    const AGPUProcCreateSemaphore            create_semaphore;
+    const AGPUProcFreeSemaphore              free_semaphore;
+    const AGPUProcCreatePipelineLayoutPool   create_pipeline_layout_pool;
+    const AGPUProcFreePipelineLayoutPool     free_pipeline_layout_pool;
+    const AGPUProcCreatePipelineLayout       create_pipeline_layout;
+    const AGPUProcFreePipelineLayout         free_pipeline_layout;
+    const AGPUProcCreateDescriptorSet        create_descriptor_set;
+    const AGPUProcFreeDescriptorSet          free_descriptor_set;
+    const AGPUProcUpdateDescriptorSet        update_descriptor_set;
+    const AGPUProcCreateComputePipeline      create_compute_pipeline;
+    const AGPUProcFreeComputePipeline        free_compute_pipeline;
+    const AGPUProcCreateRenderPipeline       create_render_pipeline;
+    const AGPUProcFreeRenderPipeline         free_render_pipeline;
+    const AGPUProcCreateComputePipelineAsync create_compute_pipeline_async;
+    const AGPUProcCreateRenderPipelineAsync  create_render_pipeline_async;
+    const AGPUProcWaitComputePipeline        wait_compute_pipeline;
+    const AGPUProcWaitRenderPipeline         wait_render_pipeline;
+    const AGPUProcCreateMemoryPool           create_memory_pool;
+    const AGPUProcFreeMemoryPool             free_memory_pool;
+    const AGPUProcCreateQueryPool            create_query_pool;
+    const AGPUProcFreeQueryPool              free_query_pool;
 
     // Queue APIs
     const AGPUProcGetQueue                  get_queue;
@@ -703,20 +740,22 @@ typedef struct AGPUAdapterDetail {
     uint32_t                 wave_lane_count;
     uint64_t                 host_visible_vram_budget;
     AGPUDynamicStateFeatures dynamic_state_features;
-    bool                     support_host_visible_vram : 1;
-    bool                     multidraw_indirect        : 1;
-    bool                     support_geom_shader       : 1;
-    bool                     support_tessellation      : 1;
-    bool                     is_uma                    : 1;
-    bool                     is_virtual                : 1;
-    bool                     is_cpu                    : 1;
-    bool                     support_tiled_buffer      : 1;
-    bool                     support_tiled_texture     : 1;
-    bool                     support_tiled_volume      : 1;
+    bool                     support_host_visible_vram   : 1;
+    bool                     multidraw_indirect          : 1;
+    bool                     support_geom_shader         : 1;
+    bool                     support_tessellation        : 1;
+    bool                     is_uma                      : 1;
+    bool                     is_virtual                  : 1;
+    bool                     is_cpu                      : 1;
+    bool                     support_tiled_buffer        : 1;
+    bool                     support_tiled_texture       : 1;
+    bool                     support_tiled_volume        : 1;
+    bool                     support_pipeline_statistics : 1;
+    bool                     support_precise_occlusion   : 1;
     // RDNA2
-    bool                     support_shading_rate      : 1;
-    bool                     support_shading_rate_mask : 1;
-    bool                     support_shading_rate_sv   : 1;
+    bool                     support_shading_rate        : 1;
+    bool                     support_shading_rate_mask   : 1;
+    bool                     support_shading_rate_sv     : 1;
     AGPUFormatSupport        format_supports[AGPU_FORMAT_COUNT];
     AGPUVendorPreset         vendor_preset;
 } AGPUAdapterDetail;
@@ -778,6 +817,9 @@ typedef struct AGPUCommandBuffer {
 typedef struct AGPUQueryPool {
     AGPUDeviceIter device;
     uint32_t       count;
+    eAGPUQueryType type;
+    // uint64_t values a query resolves to, one per enabled statistic for pipeline statistics and one otherwise
+    uint32_t       result_count;
 } AGPUQueryPool;
 
 // Notice that we must keep this header same with AGPUCommandBuffer
@@ -958,8 +1000,12 @@ typedef struct AGPUQueuePresentDescriptor {
 } AGPUQueuePresentDescriptor;
 
 typedef struct AGPUQueryPoolDescriptor {
-    eAGPUQueryType type;
-    uint32_t       query_count;
+    eAGPUQueryType         type;
+    uint32_t               query_count;
+    /// Counters collected by pipeline statistics queries, needs AGPUAdapterDetail::support_pipeline_statistics
+    AGPUPipelineStatistics pipeline_statistics;
+    /// Occlusion queries count passed samples instead of only telling whether any passed, needs support_precise_occlusion
+    bool                   precise_occlusion;
 } AGPUQueryPoolDescriptor;
 
 typedef struct AGPUQueryDescriptor {
@@ -1078,10 +1124,30 @@ typedef struct AGPUResourceBarrierDescriptor {
 
 typedef struct AGPUDeviceDescriptor {
     bool                      disable_pipeline_cache;
+    // keep render pass / framebuffer objects even where the backend could begin passes without them
+    bool                      disable_dynamic_rendering;
+    // directory the pipeline cache is persisted in, one file per adapter; NULL keeps it in memory only
+    const char8_t*            pipeline_cache_directory;
+    // also save after this many pipelines were created, 0 = only on agpu_save_pipeline_cache and device teardown
+    uint32_t                  pipeline_cache_save_interval;
     AGPUQueueGroupDescriptor* queue_groups;
     uint32_t                  queue_group_count;
+    // cached render passes / framebuffers unused for this many frames are destroyed once those frames retired, 0 = default
+    uint32_t                  pass_cache_retire_frames;
 } AGPUDeviceDescriptor;
 
+// counters of the backend render pass / framebuffer caches since device creation
+typedef struct AGPUPassCacheStatistics {
+    uint64_t render_pass_hits;
+    uint64_t render_pass_misses;
+    uint64_t render_pass_evictions;
+    uint64_t framebuffer_hits;
+    uint64_t framebuffer_misses;
+    uint64_t framebuffer_evictions;
+    uint32_t render_pass_count;
+    uint32_t framebuffer_count;
+} AGPUPassCacheStatistics;
+
 typedef struct AGPUCommandPoolDescriptor {
     const char8_t* name;
 } AGPUCommandPoolDescriptor;
@@ -1328,11 +1394,16 @@ typedef struct AGPUDescriptorSet {
 typedef struct AGPUComputePipeline {
     AGPUDeviceIter         device;
     AGPUPipelineLayoutIter pipeline_layout;
+    // eAGPUPipelineStatus, only async pipelines are ever anything but ready
+    _Atomic(uint32_t)      status;
 } AGPUComputePipeline;
 
 typedef struct AGPURenderPipeline {
     AGPUDeviceIter         device;
     AGPUPipelineLayoutIter pipeline_layout;
+    // eAGPUPipelineStatus, only async pipelines are ever anything but ready
+    _Atomic(uint32_t)      status;
+    AGPURenderPipelineIter fallback;
 } AGPURenderPipeline;
 
 // Resources
@@ -18,6 +18,9 @@
 #define AGPU_NAME_HASH_SEED 8053064571610612741
 #endif
 #define agpu_name_hash(buffer, size) atom_hash((buffer), (size), (AGPU_NAME_HASH_SEED))
+// batched agpu_name_hash over null-terminated names, matches it on 64-bit targets
+#define agpu_name_hash_batch(names, count, out) \
+    atom_hash_batch_strings((const char* const*)(names), (count), (AGPU_NAME_HASH_SEED), (out))
 
 #define AGPU_MAX_MRT_COUNT       8u
 #define AGPU_MAX_VERTEX_ATTRIBS  15
@@ -29,6 +32,9 @@
 #define AGPU_COLOR_MASK_ALL      AGPU_COLOR_MASK_RED | AGPU_COLOR_MASK_GREEN | AGPU_COLOR_MASK_BLUE | AGPU_COLOR_MASK_ALPHA
 #define AGPU_COLOR_MASK_NONE     0
 
+// frames a cached render pass / framebuffer may go unused before it is evicted, see AGPUDeviceDescriptor
+#define AGPU_DEFAULT_PASS_CACHE_RETIRE_FRAMES 8u
+
 #define AGPU_SINGLE_GPU_NODE_COUNT 1
 #define AGPU_SINGLE_GPU_NODE_MASK  1
 #define AGPU_SINGLE_GPU_NODE_INDEX 0
\ No newline at end of file
@@ -493,6 +493,13 @@ typedef enum eAGPUFenceStatus {
     AGPU_FENCE_STATUS_MAX_ENUM_BIT = 0x7FFFFFFF
 } eAGPUFenceStatus;
 
+typedef enum eAGPUPipelineStatus {
+    AGPU_PIPELINE_STATUS_READY = 0,
+    AGPU_PIPELINE_STATUS_PENDING,
+    AGPU_PIPELINE_STATUS_FAILED,
+    AGPU_PIPELINE_STATUS_MAX_ENUM_BIT = 0x7FFFFFFF
+} eAGPUPipelineStatus;
+
 typedef enum eAGPUQueryType {
     AGPU_QUERY_TYPE_TIMESTAMP = 0,
     AGPU_QUERY_TYPE_PIPELINE_STATISTICS,
@@ -500,6 +507,24 @@ typedef enum eAGPUQueryType {
     AGPU_QUERY_TYPE_COUNT,
 } eAGPUQueryType;
 
+/// Values match VkQueryPipelineStatisticFlagBits, a query writes one counter per enabled bit in bit order
+typedef enum eAGPUPipelineStatistic {
+    AGPU_PIPELINE_STATISTIC_NONE                        = 0,
+    AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES     = 0x001,
+    AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES   = 0x002,
+    AGPU_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS   = 0x004,
+    AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS = 0x008,
+    AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES  = 0x010,
+    AGPU_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS        = 0x020,
+    AGPU_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES         = 0x040,
+    AGPU_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS = 0x080,
+    AGPU_PIPELINE_STATISTIC_HULL_SHADER_PATCHES         = 0x100,
+    AGPU_PIPELINE_STATISTIC_DOMAIN_SHADER_INVOCATIONS   = 0x200,
+    AGPU_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS  = 0x400,
+    AGPU_PIPELINE_STATISTIC_MAX_ENUM_BIT                = 0x7FFFFFFF
+} eAGPUPipelineStatistic;
+typedef uint32_t AGPUPipelineStatistics;
+
 typedef enum eAGPUResourceState {
     AGPU_RESOURCE_STATE_UNDEFINED                  = 0,
     AGPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER = 0x1,
@@ -5,4 +5,8 @@
 
 // common utils
 #include "common/agpux.cpp"
+#include "common/fence_reactor.cpp"
+#include "common/gpu_profiler.cpp"
+#include "common/query_ring.cpp"
+#include "common/pso_cache.cpp"
 #include "common/agpu.cpp"
\ No newline at end of file
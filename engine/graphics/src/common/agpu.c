@@ -3,6 +3,8 @@
 #include <atomGraphics/common/api.h>
 #include <atomGraphics/common/flags.h>
 #include <atomGraphics/common/common_utils.h>
+#include <atomGraphics/common/agpux.h>
+#include <atomCore/profile.h>
 #ifdef AGPU_USE_VULKAN
 // #include <atomGraphics/backend/vulkan/AGPU_vulkan.h>
 #endif
@@ -12,6 +14,7 @@
 
 ATOM_API AGPUInstanceIter agpu_create_instance(const AGPUInstanceDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert((desc->backend == AGPU_BACKEND_VULKAN || desc->backend == AGPU_BACKEND_D3D12)
                 && "AGPU support only vulkan & d3d12!");
     const AGPUProcTable*         tbl   = ATOM_NULLPTR;
@@ -99,6 +102,7 @@ uint32_t agpu_query_queue_count(const AGPUAdapterIter adapter, const eAGPUQueueT
 
 AGPUDeviceIter agpu_create_device(AGPUAdapterIter adapter, const AGPUDeviceDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(adapter != ATOM_NULLPTR && "fatal: call on NULL adapter!");
     atom_assert(adapter->proc_table_cache->create_device && "create_device Proc Missing!");
 
@@ -127,8 +131,36 @@ void agpu_query_shared_memory_info(const AGPUDeviceIter device, uint64_t* total,
     device->proc_table_cache->query_shared_memory_info(device, total, used_bytes);
 }
 
+void agpu_query_pass_cache_statistics(const AGPUDeviceIter device, AGPUPassCacheStatistics* statistics)
+{
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->query_pass_cache_statistics && "query_pass_cache_statistics Proc Missing!");
+
+    device->proc_table_cache->query_pass_cache_statistics(device, statistics);
+}
+
+uint64_t agpu_device_begin_frame(AGPUDeviceIter device)
+{
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+
+    const uint64_t frame = atom_frame_arena_begin_frame();
+    // optional, backends without per-frame caches leave it out
+    if (device->proc_table_cache->device_begin_frame) device->proc_table_cache->device_begin_frame(device, frame);
+    return frame;
+}
+
+bool agpu_save_pipeline_cache(AGPUDeviceIter device)
+{
+    ATOM_PROFILE_FUNCTION();
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->save_pipeline_cache && "save_pipeline_cache Proc Missing!");
+
+    return device->proc_table_cache->save_pipeline_cache(device);
+}
+
 AGPUFenceIter agpu_create_fence(AGPUDeviceIter device)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_fence && "create_fence Proc Missing!");
     AGPUFence* fence = (AGPUFence*)device->proc_table_cache->create_fence(device);
@@ -138,6 +170,7 @@ AGPUFenceIter agpu_create_fence(AGPUDeviceIter device)
 
 void agpu_wait_fences(const AGPUFenceIter* fences, uint32_t fence_count)
 {
+    ATOM_PROFILE_FUNCTION();
     if (fences == ATOM_NULLPTR || fence_count <= 0) { return; }
     AGPUFenceIter fence = fences[0];
     atom_assert(fence != ATOM_NULLPTR && "fatal: call on NULL fence!");
@@ -167,6 +200,7 @@ void agpu_free_fence(AGPUFenceIter fence)
 
 AGPUSemaphoreIter agpu_create_semaphore(AGPUDeviceIter device)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_semaphore && "create_semaphore Proc Missing!");
     AGPUSemaphore* semaphore = (AGPUSemaphore*)device->proc_table_cache->create_semaphore(device);
@@ -185,6 +219,7 @@ void agpu_free_semaphore(AGPUSemaphoreIter semaphore)
 
 AGPUPipelineLayoutIter agpu_create_pipeline_layout(AGPUDeviceIter device, const struct AGPUPipelineLayoutDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_pipeline_layout && "create_pipeline_layout Proc Missing!");
     AGPUPipelineLayout* layout = (AGPUPipelineLayout*)device->proc_table_cache->create_pipeline_layout(device, desc);
@@ -205,6 +240,7 @@ void agpu_free_pipeline_layout(AGPUPipelineLayoutIter layout)
 AGPUPipelineLayoutPoolIter agpu_create_pipeline_layout_pool(AGPUDeviceIter                                 device,
                                                             const struct AGPUPipelineLayoutPoolDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_pipeline_layout_pool && "create_pipeline_layout_pool Proc Missing!");
     AGPUPipelineLayoutPool* pool = (AGPUPipelineLayoutPool*)device->proc_table_cache->create_pipeline_layout_pool(device, desc);
@@ -224,6 +260,7 @@ void agpu_free_pipeline_layout_pool(AGPUPipelineLayoutPoolIter pool)
 
 AGPUDescriptorSetIter agpu_create_descriptor_set(AGPUDeviceIter device, const struct AGPUDescriptorSetDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_descriptor_set && "create_descriptor_set Proc Missing!");
     AGPUDescriptorSet* set = (AGPUDescriptorSet*)device->proc_table_cache->create_descriptor_set(device, desc);
@@ -235,6 +272,7 @@ AGPUDescriptorSetIter agpu_create_descriptor_set(AGPUDeviceIter device, const st
 
 void agpu_update_descriptor_set(AGPUDescriptorSetIter set, const struct AGPUDescriptorData* datas, uint32_t count)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(set != ATOM_NULLPTR && "fatal: call on NULL descriptor set!");
     const AGPUDeviceIter device = set->pipeline_layout->device;
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
@@ -253,6 +291,7 @@ void agpu_free_descriptor_set(AGPUDescriptorSetIter set)
 
 AGPUComputePipelineIter agpu_create_compute_pipeline(AGPUDeviceIter device, const struct AGPUComputePipelineDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_compute_pipeline && "create_compute_pipeline Proc Missing!");
     AGPUComputePipeline* pipeline = (AGPUComputePipeline*)device->proc_table_cache->create_compute_pipeline(device, desc);
@@ -271,6 +310,43 @@ void agpu_free_compute_pipeline(AGPUComputePipelineIter pipeline)
     device->proc_table_cache->free_compute_pipeline(pipeline);
 }
 
+AGPUComputePipelineIter agpu_create_compute_pipeline_async(AGPUDeviceIter                              device,
+                                                           const struct AGPUComputePipelineDescriptor* desc)
+{
+    ATOM_PROFILE_FUNCTION();
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->create_compute_pipeline_async && "create_compute_pipeline_async Proc Missing!");
+    AGPUComputePipeline* pipeline =
+        (AGPUComputePipeline*)device->proc_table_cache->create_compute_pipeline_async(device, desc);
+    pipeline->device          = device;
+    pipeline->pipeline_layout = desc->pipeline_layout;
+
+    return pipeline;
+}
+
+static ATOM_FORCEINLINE eAGPUPipelineStatus agpu_load_pipeline_status(const _Atomic(uint32_t)* status)
+{
+    return (eAGPUPipelineStatus)atomic_load_explicit((_Atomic(uint32_t)*)status, memory_order_acquire);
+}
+
+eAGPUPipelineStatus agpu_query_compute_pipeline_status(AGPUComputePipelineIter pipeline)
+{
+    atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL pipeline!");
+    return agpu_load_pipeline_status(&pipeline->status);
+}
+
+eAGPUPipelineStatus agpu_wait_compute_pipeline(AGPUComputePipelineIter pipeline)
+{
+    ATOM_PROFILE_FUNCTION();
+    atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL pipeline!");
+    const AGPUDeviceIter device = pipeline->device;
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->wait_compute_pipeline && "wait_compute_pipeline Proc Missing!");
+    if (agpu_load_pipeline_status(&pipeline->status) == AGPU_PIPELINE_STATUS_PENDING)
+        device->proc_table_cache->wait_compute_pipeline(pipeline);
+    return agpu_load_pipeline_status(&pipeline->status);
+}
+
 static const AGPUBlendStateDescriptor      defaultBlendStateDesc  = {.src_factors[0]       = AGPU_BLEND_CONST_ONE,
                                                                      .dst_factors[0]       = AGPU_BLEND_CONST_ZERO,
                                                                      .blend_modes[0]       = AGPU_BLEND_MODE_ADD,
@@ -290,24 +366,65 @@ static const AGPUDepthStateDescriptor      defaultDepthStateDesc  = {.depth_test
                                                                      .depth_write  = false,
                                                                      .stencil_test = false};
 
+static void agpu_fill_render_pipeline_defaults(AGPURenderPipelineDescriptor* new_desc, const AGPURenderPipelineDescriptor* desc)
+{
+    memcpy(new_desc, desc, sizeof(AGPURenderPipelineDescriptor));
+    if (desc->sample_count == 0) new_desc->sample_count = 1;
+    if (desc->blend_state == ATOM_NULLPTR) new_desc->blend_state = &defaultBlendStateDesc;
+    if (desc->depth_state == ATOM_NULLPTR) new_desc->depth_state = &defaultDepthStateDesc;
+    if (desc->rasterizer_state == ATOM_NULLPTR) new_desc->rasterizer_state = &defaultRasterStateDesc;
+}
+
 AGPURenderPipelineIter agpu_create_render_pipeline(AGPUDeviceIter device, const struct AGPURenderPipelineDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_render_pipeline && "create_render_pipeline Proc Missing!");
     AGPURenderPipelineDescriptor new_desc;
-    memcpy(&new_desc, desc, sizeof(AGPURenderPipelineDescriptor));
-    AGPURenderPipeline* pipeline = ATOM_NULLPTR;
-    if (desc->sample_count == 0) new_desc.sample_count = 1;
-    if (desc->blend_state == ATOM_NULLPTR) new_desc.blend_state = &defaultBlendStateDesc;
-    if (desc->depth_state == ATOM_NULLPTR) new_desc.depth_state = &defaultDepthStateDesc;
-    if (desc->rasterizer_state == ATOM_NULLPTR) new_desc.rasterizer_state = &defaultRasterStateDesc;
-    pipeline                  = (AGPURenderPipeline*)device->proc_table_cache->create_render_pipeline(device, &new_desc);
+    agpu_fill_render_pipeline_defaults(&new_desc, desc);
+    AGPURenderPipeline* pipeline = (AGPURenderPipeline*)device->proc_table_cache->create_render_pipeline(device, &new_desc);
+    pipeline->device             = device;
+    pipeline->pipeline_layout    = desc->pipeline_layout;
+
+    return pipeline;
+}
+
+AGPURenderPipelineIter agpu_create_render_pipeline_async(AGPUDeviceIter                             device,
+                                                         const struct AGPURenderPipelineDescriptor* desc,
+                                                         AGPURenderPipelineIter                     fallback)
+{
+    ATOM_PROFILE_FUNCTION();
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->create_render_pipeline_async && "create_render_pipeline_async Proc Missing!");
+    AGPURenderPipelineDescriptor new_desc;
+    agpu_fill_render_pipeline_defaults(&new_desc, desc);
+    AGPURenderPipeline* pipeline =
+        (AGPURenderPipeline*)device->proc_table_cache->create_render_pipeline_async(device, &new_desc);
     pipeline->device          = device;
     pipeline->pipeline_layout = desc->pipeline_layout;
+    pipeline->fallback        = fallback;
 
     return pipeline;
 }
 
+eAGPUPipelineStatus agpu_query_render_pipeline_status(AGPURenderPipelineIter pipeline)
+{
+    atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL pipeline!");
+    return agpu_load_pipeline_status(&pipeline->status);
+}
+
+eAGPUPipelineStatus agpu_wait_render_pipeline(AGPURenderPipelineIter pipeline)
+{
+    ATOM_PROFILE_FUNCTION();
+    atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL pipeline!");
+    const AGPUDeviceIter device = pipeline->device;
+    atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
+    atom_assert(device->proc_table_cache->wait_render_pipeline && "wait_render_pipeline Proc Missing!");
+    if (agpu_load_pipeline_status(&pipeline->status) == AGPU_PIPELINE_STATUS_PENDING)
+        device->proc_table_cache->wait_render_pipeline(pipeline);
+    return agpu_load_pipeline_status(&pipeline->status);
+}
+
 void agpu_free_render_pipeline(AGPURenderPipelineIter pipeline)
 {
     atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL layout!");
@@ -319,6 +436,7 @@ void agpu_free_render_pipeline(AGPURenderPipelineIter pipeline)
 
 AGPUQueryPoolIter agpu_create_query_pool(AGPUDeviceIter device, const struct AGPUQueryPoolDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     AGPUProcCreateQueryPool fn_create_query_pool = device->proc_table_cache->create_query_pool;
     atom_assert(fn_create_query_pool && "create_query_pool Proc Missing!");
@@ -340,6 +458,7 @@ void agpu_free_device(AGPUDeviceIter device)
 {
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->free_device && "free_device Proc Missing!");
+    atom_assert(!agpux_fence_reactor_watch_count(device) && "watched fences left, call agpux_fence_reactor_shutdown first!");
 
     device->proc_table_cache->free_device(device);
     return;
@@ -367,6 +486,7 @@ AGPUQueueIter agpu_get_queue(AGPUDeviceIter device, eAGPUQueueType type, uint32_
 
 void agpu_submit_queue(AGPUQueueIter queue, const struct AGPUQueueSubmitDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(desc != ATOM_NULLPTR && "fatal: call on NULL desc!");
     atom_assert(queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     atom_assert(queue->device != ATOM_NULLPTR && "fatal: call on NULL device!");
@@ -378,6 +498,7 @@ void agpu_submit_queue(AGPUQueueIter queue, const struct AGPUQueueSubmitDescript
 
 void agpu_queue_present(AGPUQueueIter queue, const struct AGPUQueuePresentDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(desc != ATOM_NULLPTR && "fatal: call on NULL desc!");
     atom_assert(queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     atom_assert(queue->device != ATOM_NULLPTR && "fatal: call on NULL device!");
@@ -385,10 +506,13 @@ void agpu_queue_present(AGPUQueueIter queue, const struct AGPUQueuePresentDescri
     atom_assert(fn_queue_present && "queue_present Proc Missing!");
 
     fn_queue_present(queue, desc);
+    // a present closes the frame, what is submitted from here on belongs to the next one
+    agpu_device_begin_frame(queue->device);
 }
 
 void agpu_wait_queue_idle(AGPUQueueIter queue)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     atom_assert(queue->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcWaitQueueIterle wait_queue_idle = queue->device->proc_table_cache->wait_queue_idle;
@@ -456,6 +580,7 @@ void agpu_free_queue(AGPUQueueIter queue)
 
 ATOM_API AGPUCommandPoolIter agpu_create_command_pool(AGPUQueueIter queue, const AGPUCommandPoolDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     atom_assert(queue->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(queue->device->proc_table_cache->create_command_pool && "create_command_pool Proc Missing!");
@@ -468,6 +593,7 @@ ATOM_API AGPUCommandPoolIter agpu_create_command_pool(AGPUQueueIter queue, const
 ATOM_API AGPUCommandBufferIter agpu_create_command_buffer(AGPUCommandPoolIter                       pool,
                                                           const struct AGPUCommandBufferDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(pool != ATOM_NULLPTR && "fatal: call on NULL pool!");
     atom_assert(pool->queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     const AGPUDeviceIter device = pool->queue->device;
@@ -483,6 +609,7 @@ ATOM_API AGPUCommandBufferIter agpu_create_command_buffer(AGPUCommandPoolIter
 
 ATOM_API void agpu_reset_command_pool(AGPUCommandPoolIter pool)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(pool != ATOM_NULLPTR && "fatal: call on NULL pool!");
     atom_assert(pool->queue != ATOM_NULLPTR && "fatal: call on NULL queue!");
     atom_assert(pool->queue->device != ATOM_NULLPTR && "fatal: call on NULL device!");
@@ -520,6 +647,7 @@ ATOM_API void agpu_free_command_pool(AGPUCommandPoolIter pool)
 // CMDs
 void agpu_cmd_begin(AGPUCommandBufferIter cmd)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdBegin fn_cmd_begin = cmd->device->proc_table_cache->cmd_begin;
@@ -529,6 +657,7 @@ void agpu_cmd_begin(AGPUCommandBufferIter cmd)
 
 void agpu_cmd_transfer_buffer_to_buffer(AGPUCommandBufferIter cmd, const struct AGPUBufferToBufferTransfer* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_NONE
                 && "fatal: can't call transfer apis on commdn buffer while preparing dispatching!");
@@ -544,6 +673,7 @@ void agpu_cmd_transfer_buffer_to_buffer(AGPUCommandBufferIter cmd, const struct
 
 void agpu_cmd_transfer_buffer_to_texture(AGPUCommandBufferIter cmd, const struct AGPUBufferToTextureTransfer* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_NONE
                 && "fatal: can't call transfer apis on commdn buffer while preparing dispatching!");
@@ -559,6 +689,7 @@ void agpu_cmd_transfer_buffer_to_texture(AGPUCommandBufferIter cmd, const struct
 
 void agpu_cmd_transfer_texture_to_texture(AGPUCommandBufferIter cmd, const struct AGPUTextureToTextureTransfer* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_NONE
                 && "fatal: can't call transfer apis on commdn buffer while preparing dispatching!");
@@ -574,6 +705,7 @@ void agpu_cmd_transfer_texture_to_texture(AGPUCommandBufferIter cmd, const struc
 
 void agpu_cmd_transfer_buffer_to_tiles(AGPUCommandBufferIter cmd, const struct AGPUBufferToTilesTransfer* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_NONE
                 && "fatal: can't call transfer apis on commdn buffer while preparing dispatching!");
@@ -589,6 +721,7 @@ void agpu_cmd_transfer_buffer_to_tiles(AGPUCommandBufferIter cmd, const struct A
 
 void agpu_cmd_resource_barrier(AGPUCommandBufferIter cmd, const struct AGPUResourceBarrierDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_NONE
                 && "fatal: can't call resource barriers in render/dispatch passes!");
@@ -600,6 +733,7 @@ void agpu_cmd_resource_barrier(AGPUCommandBufferIter cmd, const struct AGPUResou
 
 void agpu_cmd_begin_query(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, const struct AGPUQueryDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdBeginQuery fn_cmd_begin_query = cmd->device->proc_table_cache->cmd_begin_query;
@@ -609,6 +743,7 @@ void agpu_cmd_begin_query(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, con
 
 void agpu_cmd_end_query(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, const struct AGPUQueryDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdEndQuery fn_cmd_end_query = cmd->device->proc_table_cache->cmd_end_query;
@@ -618,6 +753,7 @@ void agpu_cmd_end_query(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, const
 
 void agpu_cmd_reset_query_pool(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, uint32_t start_query, uint32_t query_count)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(pool != ATOM_NULLPTR && "fatal: call on NULL pool!");
     atom_assert(pool->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     AGPUProcCmdResetQueryPool fn_reset_query_pool = pool->device->proc_table_cache->cmd_reset_query_pool;
@@ -631,6 +767,7 @@ void agpu_cmd_resolve_query(AGPUCommandBufferIter cmd,
                             uint32_t              start_query,
                             uint32_t              query_count)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdResolveQuery fn_cmd_resolve_query = cmd->device->proc_table_cache->cmd_resolve_query;
@@ -640,6 +777,7 @@ void agpu_cmd_resolve_query(AGPUCommandBufferIter cmd,
 
 void agpu_cmd_end(AGPUCommandBufferIter cmd)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdEnd fn_cmd_end = cmd->device->proc_table_cache->cmd_end;
@@ -650,6 +788,7 @@ void agpu_cmd_end(AGPUCommandBufferIter cmd)
 // Compute CMDs
 AGPUComputePassEncoderIter agpu_cmd_begin_compute_pass(AGPUCommandBufferIter cmd, const struct AGPUComputePassDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdBeginComputePass fn_begin_compute_pass = cmd->device->proc_table_cache->cmd_begin_compute_pass;
@@ -690,6 +829,9 @@ void agpu_compute_encoder_bind_pipeline(AGPUComputePassEncoderIter encoder, AGPU
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcComputeEncoderBindPipeline fn_compute_bind_pipeline = device->proc_table_cache->compute_encoder_bind_pipeline;
     atom_assert(fn_compute_bind_pipeline && "compute_encoder_bind_pipeline Proc Missing!");
+    atom_assert(pipeline != ATOM_NULLPTR && "fatal: call on NULL pipeline!");
+    // NULL tells the backend to drop dispatches until the next bind
+    if (agpu_load_pipeline_status(&pipeline->status) != AGPU_PIPELINE_STATUS_READY) pipeline = ATOM_NULLPTR;
     fn_compute_bind_pipeline(encoder, pipeline);
 }
 
@@ -704,6 +846,7 @@ void agpu_compute_encoder_dispatch(AGPUComputePassEncoderIter encoder, uint32_t
 
 void agpu_cmd_end_compute_pass(AGPUCommandBufferIter cmd, AGPUComputePassEncoderIter encoder)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_COMPUTE
@@ -718,6 +861,7 @@ void agpu_cmd_end_compute_pass(AGPUCommandBufferIter cmd, AGPUComputePassEncoder
 // Render CMDs
 AGPURenderPassEncoderIter agpu_cmd_begin_render_pass(AGPUCommandBufferIter cmd, const struct AGPURenderPassDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdBeginRenderPass fn_begin_render_pass = cmd->device->proc_table_cache->cmd_begin_render_pass;
@@ -800,6 +944,9 @@ void agpu_render_encoder_bind_pipeline(AGPURenderPassEncoderIter encoder, AGPURe
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcRenderEncoderBindPipeline fn_render_bind_pipeline = device->proc_table_cache->render_encoder_bind_pipeline;
     atom_assert(fn_render_bind_pipeline && "render_encoder_bind_pipeline Proc Missing!");
+    // NULL tells the backend to drop draws until the next bind
+    while (pipeline && agpu_load_pipeline_status(&pipeline->status) != AGPU_PIPELINE_STATUS_READY)
+        pipeline = pipeline->fallback;
     fn_render_bind_pipeline(encoder, pipeline);
 }
 
@@ -866,6 +1013,7 @@ void agpu_render_encoder_draw_indexed_instanced(AGPURenderPassEncoderIter encode
 
 void agpu_cmd_end_render_pass(AGPUCommandBufferIter cmd, AGPURenderPassEncoderIter encoder)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(cmd->current_dispatch == AGPU_PIPELINE_TYPE_GRAPHICS
@@ -880,6 +1028,7 @@ void agpu_cmd_end_render_pass(AGPUCommandBufferIter cmd, AGPURenderPassEncoderIt
 // Events
 void agpu_cmd_begin_event(AGPUCommandBufferIter cmd, const AGPUEventInfo* event)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdBeginEvent fn_begin_event = cmd->device->proc_table_cache->cmd_begin_event;
@@ -888,6 +1037,7 @@ void agpu_cmd_begin_event(AGPUCommandBufferIter cmd, const AGPUEventInfo* event)
 
 void agpu_cmd_set_marker(AGPUCommandBufferIter cmd, const AGPUMarkerInfo* marker)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdSetMarker fn_cmd_set_marker = cmd->device->proc_table_cache->cmd_set_marker;
@@ -896,6 +1046,7 @@ void agpu_cmd_set_marker(AGPUCommandBufferIter cmd, const AGPUMarkerInfo* marker
 
 void agpu_cmd_end_event(AGPUCommandBufferIter cmd)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(cmd != ATOM_NULLPTR && "fatal: call on NULL cmdbuffer!");
     atom_assert(cmd->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     const AGPUProcCmdEndEvent fn_end_event = cmd->device->proc_table_cache->cmd_end_event;
@@ -905,6 +1056,7 @@ void agpu_cmd_end_event(AGPUCommandBufferIter cmd)
 // Shader APIs
 AGPUShaderLibraryIter agpu_create_shader_library(AGPUDeviceIter device, const struct AGPUShaderLibraryDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_shader_library && "create_shader_library Proc Missing!");
 
@@ -937,6 +1089,7 @@ void agpu_free_shader_library(AGPUShaderLibraryIter library)
 // Buffer APIs
 AGPUBufferIter agpu_create_buffer(AGPUDeviceIter device, const struct AGPUBufferDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_buffer && "create_buffer Proc Missing!");
     AGPUBufferDescriptor new_desc;
@@ -986,6 +1139,7 @@ void agpu_free_buffer(AGPUBufferIter buffer)
 // Texture/TextureView APIs
 AGPUTextureIter agpu_create_texture(AGPUDeviceIter device, const struct AGPUTextureDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_texture && "create_texture Proc Missing!");
     AGPUTextureDescriptor new_desc;
@@ -1016,6 +1170,7 @@ void agpu_free_texture(AGPUTextureIter texture)
 
 AGPUSamplerIter agpu_create_sampler(AGPUDeviceIter device, const struct AGPUSamplerDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_sampler && "create_sampler Proc Missing!");
     AGPUProcCreateSampler fn_create_sampler = device->proc_table_cache->create_sampler;
@@ -1038,6 +1193,7 @@ void agpu_free_sampler(AGPUSamplerIter sampler)
 
 AGPUTextureViewIter agpu_create_texture_view(AGPUDeviceIter device, const struct AGPUTextureViewDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_texture_view && "create_texture_view Proc Missing!");
     AGPUTextureViewDescriptor new_desc;
@@ -1097,6 +1253,7 @@ AGPUTextureIter agpu_import_shared_texture_handle(AGPUDeviceIter device, const s
 // SwapChain APIs
 AGPUSwapChainIter agpu_create_swapchain(AGPUDeviceIter device, const AGPUSwapChainDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(device->proc_table_cache->create_swapchain && "create_swapchain Proc Missing!");
 
@@ -1127,6 +1284,7 @@ AGPUSwapChainIter agpu_create_swapchain(AGPUDeviceIter device, const AGPUSwapCha
 
 uint32_t agpu_acquire_next_image(AGPUSwapChainIter swapchain, const struct AGPUAcquireNextDescriptor* desc)
 {
+    ATOM_PROFILE_FUNCTION();
     atom_assert(swapchain != ATOM_NULLPTR && "fatal: call on NULL swapchain!");
     atom_assert(swapchain->device != ATOM_NULLPTR && "fatal: call on NULL device!");
     atom_assert(swapchain->device->proc_table_cache->acquire_next_image && "acquire_next_image Proc Missing!");
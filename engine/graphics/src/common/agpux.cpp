@@ -4,6 +4,7 @@
 #include <atomGraphics/common/common_utils.h>
 
 // AGPUX bind table apis
+static const char* kAGPUXBindTableMemoryPoolName = "AGPUX::bind_table";
 
 void AGPUXBindTableValue::initialize(const AGPUXBindTableLocation& loc, const AGPUDescriptorData& rhs)
 {
@@ -34,7 +35,8 @@ AGPUXBindTableIter AGPUXBindTable::create(AGPUDeviceIter device, const struct AG
     const auto              locations_size = desc->names_count * sizeof(AGPUXBindTableLocation);
     const auto              sets_size      = rs->table_count * sizeof(AGPUDescriptorSetIter);
     const auto              total_size     = sizeof(AGPUXBindTable) + hashes_size + locations_size + sets_size;
-    AGPUXBindTable*         table          = (AGPUXBindTable*)atom_calloc_aligned(1, total_size, alignof(AGPUXBindTable));
+    AGPUXBindTable*         table =
+        (AGPUXBindTable*)atom_calloc_alignedN(1, total_size, alignof(AGPUXBindTable), kAGPUXBindTableMemoryPoolName);
     uint64_t*               pHashes        = (uint64_t*)(table + 1);
     AGPUXBindTableLocation* pLocations     = (AGPUXBindTableLocation*)(pHashes + desc->names_count);
     AGPUDescriptorSetIter*  pSets          = (AGPUDescriptorSetIter*)(pLocations + desc->names_count);
@@ -45,10 +47,7 @@ AGPUXBindTableIter AGPUXBindTable::create(AGPUDeviceIter device, const struct AG
     table->sets                            = pSets;
     table->layout                          = desc->layout;
     // calculate hashes for each name
-    for (uint32_t i = 0; i < desc->names_count; i++) {
-        const auto name = desc->names[i];
-        pHashes[i]      = agpu_name_hash(name, strlen((const char*)name));
-    }
+    agpu_name_hash_batch(desc->names, desc->names_count, pHashes);
     // calculate active sets
     for (uint32_t setIterx = 0; setIterx < rs->table_count; setIterx++) {
         for (uint32_t bindIterx = 0; bindIterx < rs->tables[setIterx].resources_count; bindIterx++) {
@@ -75,13 +74,19 @@ AGPUXBindTableIter AGPUXBindTable::create(AGPUDeviceIter device, const struct AG
 
 void AGPUXBindTable::update(const struct AGPUDescriptorData* datas, uint32_t count) ATOM_NOEXCEPT
 {
+    const auto scratch   = atom_frame_arena_mark();
+    auto       names     = (const char8_t**)atom_frame_alloc(count * sizeof(const char8_t*), alignof(const char8_t*));
+    auto       in_hashes = (uint64_t*)atom_frame_alloc(count * sizeof(uint64_t), alignof(uint64_t));
+    for (uint32_t i = 0; i < count; i++) {
+        atom_assert(datas[i].name != ATOM_NULLPTR);
+        names[i] = datas[i].name;
+    }
+    agpu_name_hash_batch(names, count, in_hashes);
     for (uint32_t i = 0; i < count; i++) {
         bool        updated = false;
         const auto& data    = datas[i];
-        atom_assert(data.name != ATOM_NULLPTR);
-        const auto name_hash = agpu_name_hash(data.name, strlen((const char*)data.name));
         for (uint32_t j = 0; j < names_count; j++) {
-            if (name_hash == name_hashes[j]) {
+            if (in_hashes[i] == name_hashes[j]) {
                 const auto& location = name_locations[j];
                 if (!std::equal_to<AGPUDescriptorData>()(data, location.value.data)) {
                     auto& loc = name_locations[j];
@@ -92,6 +97,7 @@ void AGPUXBindTable::update(const struct AGPUDescriptorData* datas, uint32_t cou
             }
         }
     }
+    atom_frame_arena_rewind(scratch);
     updateDescSetsIfDirty();
 }
 
@@ -99,17 +105,20 @@ void AGPUXBindTable::update(const struct AGPUDescriptorData* datas, uint32_t cou
 // TODO: support update-after-bind
 void AGPUXBindTable::updateDescSetsIfDirty() const ATOM_NOEXCEPT
 {
-    atom::static_flat_map<uint32_t, atom::small_vector<AGPUDescriptorData, 4>> needsUpdateData{};
-    for (auto iter = name_locations; iter != name_locations + names_count; ++iter) {
-        if (!iter->value.binded) {
-            needsUpdateData[iter->tbl_idx].emplace_back(iter->value.data);
-            const_cast<bool&>(iter->value.binded) = true;
+    const auto scratch = atom_frame_arena_mark();
+    auto       datas =
+        (AGPUDescriptorData*)atom_frame_alloc(names_count * sizeof(AGPUDescriptorData), alignof(AGPUDescriptorData));
+    for (uint32_t setIterx = 0; setIterx < sets_count; setIterx++) {
+        uint32_t updateDataCount = 0;
+        for (auto iter = name_locations; iter != name_locations + names_count; ++iter) {
+            if (iter->tbl_idx == setIterx && !iter->value.binded) {
+                datas[updateDataCount++]              = iter->value.data;
+                const_cast<bool&>(iter->value.binded) = true;
+            }
         }
+        if (updateDataCount) agpu_update_descriptor_set(sets[setIterx], datas, updateDataCount);
     }
-    for (auto& [setIterx, datas] : needsUpdateData) {
-        const auto updateDataCount = static_cast<uint32_t>(datas.size());
-        if (updateDataCount) agpu_update_descriptor_set(sets[setIterx], datas.data(), updateDataCount);
-    }
+    atom_frame_arena_rewind(scratch);
 }
 
 void AGPUXBindTable::bind(AGPURenderPassEncoderIter encoder) const ATOM_NOEXCEPT
@@ -133,8 +142,7 @@ void AGPUXBindTable::free(AGPUXBindTableIter table) ATOM_NOEXCEPT
     }
     for (uint32_t i = 0; i < table->names_count; i++) { table->name_locations[i].~AGPUXBindTableLocation(); }
     ((AGPUXBindTable*)table)->~AGPUXBindTable();
-    // atom_free_aligned((void*)table, alignof(AGPUXBindTable));
-    atom_free_aligned((void*)table);
+    atom_free_alignedN((void*)table, alignof(AGPUXBindTable), kAGPUXBindTableMemoryPoolName);
 }
 
 AGPUXBindTableIter agpux_create_bind_table(AGPUDeviceIter device, const struct AGPUXBindTableDescriptor* desc)
@@ -164,7 +172,8 @@ AGPUXMergedBindTableIter AGPUXMergedBindTable::create(AGPUDeviceIter
     atom_assert(desc->layout);
 
     const auto total_size       = sizeof(AGPUXMergedBindTable) + 3 * desc->layout->table_count * sizeof(AGPUDescriptorSetIter);
-    AGPUXMergedBindTable* table = (AGPUXMergedBindTable*)atom_calloc_aligned(1, total_size, alignof(AGPUXMergedBindTable));
+    AGPUXMergedBindTable* table = (AGPUXMergedBindTable*)
+        atom_calloc_alignedN(1, total_size, alignof(AGPUXMergedBindTable), kAGPUXBindTableMemoryPoolName);
     table->layout               = desc->layout;
     table->sets_count           = desc->layout->table_count;
     table->copied               = (AGPUDescriptorSetIter*)(table + 1);
@@ -219,22 +228,26 @@ void AGPUXMergedBindTable::mergeUpdateForTable(const AGPUXBindTableIter* bind_ta
                                                uint32_t                  count,
                                                uint32_t                  tbl_idx) ATOM_NOEXCEPT
 {
-    auto                            to_update = merged[tbl_idx];
-    // TODO: refactor & remove this vector
-    std::vector<AGPUDescriptorData> datas{};
+    auto     to_update   = merged[tbl_idx];
+    uint32_t names_count = 0;
+    for (uint32_t i = 0; i < count; i++) names_count += bind_tables[i]->names_count;
+    const auto scratch = atom_frame_arena_mark();
+    auto datas = (AGPUDescriptorData*)atom_frame_alloc(names_count * sizeof(AGPUDescriptorData), alignof(AGPUDescriptorData));
+    uint32_t datas_count = 0;
     // foreach table location to update values
     for (uint32_t i = 0; i < count; i++) {
         for (uint32_t j = 0; j < bind_tables[i]->names_count; j++) {
             const auto& location = bind_tables[i]->name_locations[j];
             if (location.tbl_idx == tbl_idx) {
                 // batch update for better performance
-                datas.emplace_back(location.value.data);
+                datas[datas_count++] = location.value.data;
             }
         }
     }
     // this update is kinda dangerous during draw-call because update-after-bind may happen
     // TODO: give some runtime warning
-    agpu_update_descriptor_set(to_update, datas.data(), (uint32_t)datas.size());
+    agpu_update_descriptor_set(to_update, datas, datas_count);
+    atom_frame_arena_rewind(scratch);
 }
 
 void AGPUXMergedBindTable::bind(AGPURenderPassEncoderIter encoder) const ATOM_NOEXCEPT
@@ -258,8 +271,7 @@ void AGPUXMergedBindTable::free(AGPUXMergedBindTableIter table) ATOM_NOEXCEPT
         if (table->merged[i]) agpu_free_descriptor_set(table->merged[i]);
     }
     ((AGPUXMergedBindTable*)table)->~AGPUXMergedBindTable();
-    atom_free_aligned((void*)table);
-    // atom_free_aligned((void*)table, alignof(AGPUXMergedBindTable));
+    atom_free_alignedN((void*)table, alignof(AGPUXMergedBindTable), kAGPUXBindTableMemoryPoolName);
 }
 
 AGPUXMergedBindTableIter AGPUx_create_megred_bind_table(AGPUDeviceIter                               device,
@@ -290,7 +302,22 @@ namespace std
 {
 size_t hash<AGPUVertexLayout>::operator()(const AGPUVertexLayout& val) const
 {
-    return agpu_name_hash(&val, sizeof(AGPUVertexLayout));
+    // only what equal_to looks at, the bytes past the semantic names and the unused attributes stay out
+    size_t result = val.attribute_count;
+    for (uint32_t i = 0; i < val.attribute_count; i++) {
+        const auto& attribute = val.attributes[i];
+        const auto  name_hash =
+            agpu_name_hash((const char*)attribute.semantic_name, strlen((const char*)attribute.semantic_name));
+        hash_combine(result,
+                     name_hash,
+                     attribute.array_size,
+                     attribute.format,
+                     attribute.binding,
+                     attribute.offset,
+                     attribute.elem_stride,
+                     attribute.rate);
+    }
+    return result;
 }
 
 size_t equal_to<AGPUVertexLayout>::operator()(const AGPUVertexLayout& a, const AGPUVertexLayout& b) const
@@ -347,14 +374,14 @@ size_t equal_to<AGPUShaderEntryDescriptor>::operator()(const AGPUShaderEntryDesc
     return true;
 }
 
+// constants are hashed field by field, the padding after constantID is not preserved by copies
 size_t hash<AGPUShaderEntryDescriptor>::operator()(const AGPUShaderEntryDescriptor& val) const
 {
     size_t     result     = val.stage;
     const auto entry_hash = val.entry ? agpu_name_hash((const char*)val.entry, strlen((const char*)val.entry)) : 0;
-    const auto constants_hash =
-        val.constants ? agpu_name_hash(val.constants, sizeof(AGPUConstantSpecialization) * val.num_constants) : 0;
-    const auto pLibrary = static_cast<const void*>(val.library);
-    hash_combine(result, entry_hash, constants_hash, pLibrary);
+    const auto pLibrary   = static_cast<const void*>(val.library);
+    hash_combine(result, entry_hash, pLibrary, val.num_constants);
+    for (uint32_t i = 0; i < val.num_constants; i++) hash_combine(result, val.constants[i].constantID, val.constants[i].u);
     return result;
 }
 
@@ -375,9 +402,23 @@ size_t equal_to<AGPUBlendStateDescriptor>::operator()(const AGPUBlendStateDescri
     return true;
 }
 
+// padded structs are hashed up to their last member or field by field, padding bytes are not preserved by copies.
+// like equal_to, only the first count render targets take part
 size_t hash<AGPUBlendStateDescriptor>::operator()(const AGPUBlendStateDescriptor& val) const
 {
-    return agpu_name_hash(&val, sizeof(AGPUBlendStateDescriptor));
+    size_t result = count;
+    for (uint32_t i = 0; i < count; i++) {
+        hash_combine(result,
+                     val.src_factors[i],
+                     val.dst_factors[i],
+                     val.src_alpha_factors[i],
+                     val.dst_alpha_factors[i],
+                     val.blend_modes[i],
+                     val.blend_alpha_modes[i],
+                     val.masks[i]);
+    }
+    hash_combine(result, val.alpha_to_coverage, val.independent_blend);
+    return result;
 }
 
 size_t equal_to<AGPUDepthStateDesc>::operator()(const AGPUDepthStateDesc& a, const AGPUDepthStateDesc& b) const
@@ -401,7 +442,23 @@ size_t equal_to<AGPUDepthStateDesc>::operator()(const AGPUDepthStateDesc& a, con
 
 size_t hash<AGPUDepthStateDesc>::operator()(const AGPUDepthStateDesc& val) const
 {
-    return agpu_name_hash(&val, sizeof(AGPUDepthStateDesc));
+    size_t result = 0;
+    hash_combine(result,
+                 val.depth_test,
+                 val.depth_write,
+                 val.depth_func,
+                 val.stencil_test,
+                 val.stencil_read_mask,
+                 val.stencil_write_mask,
+                 val.stencil_front_func,
+                 val.stencil_front_fail,
+                 val.depth_front_fail,
+                 val.stencil_front_pass,
+                 val.stencil_back_func,
+                 val.stencil_back_fail,
+                 val.depth_back_fail,
+                 val.stencil_back_pass);
+    return result;
 }
 
 size_t equal_to<AGPURasterizerStateDescriptor>::operator()(const AGPURasterizerStateDescriptor& a,
@@ -420,13 +477,12 @@ size_t equal_to<AGPURasterizerStateDescriptor>::operator()(const AGPURasterizerS
 
 size_t hash<AGPURasterizerStateDescriptor>::operator()(const AGPURasterizerStateDescriptor& val) const
 {
-    return agpu_name_hash(&val, sizeof(AGPURasterizerStateDescriptor));
+    return agpu_name_hash(&val, offsetof(AGPURasterizerStateDescriptor, enable_depth_clamp) + sizeof(bool));
 }
 
 size_t equal_to<AGPURenderPipelineDescriptor>::operator()(const AGPURenderPipelineDescriptor& a,
                                                           const AGPURenderPipelineDescriptor& b) const
 {
-    if (a.vertex_layout->attribute_count != b.vertex_layout->attribute_count) return false;
     if (a.render_target_count != b.render_target_count) return false;
 
     // equal root signature
@@ -496,7 +552,8 @@ size_t equal_to<AGPURenderPipelineDescriptor>::operator()(const AGPURenderPipeli
 }
 
 hash<AGPURenderPipelineDescriptor>::ParameterBlock::ParameterBlock(const AGPURenderPipelineDescriptor& desc)
-    : render_target_count(desc.render_target_count),
+    : color_formats(), // the unused formats are hashed too
+      render_target_count(desc.render_target_count),
       sample_count(desc.sample_count),
       sample_quality(desc.sample_quality),
       color_resolve_disable_mask(desc.color_resolve_disable_mask),
@@ -521,6 +578,8 @@ size_t hash<AGPURenderPipelineDescriptor>::operator()(const AGPURenderPipelineDe
     const auto& blend_state      = a.blend_state ? *a.blend_state : kZeroAGPUBlendStateDescriptor;
     const auto& depth_state      = a.depth_state ? *a.depth_state : kZeroAGPUDepthStateDesc;
     const auto& rasterizer_state = a.rasterizer_state ? *a.rasterizer_state : kZeroAGPURasterizerStateDescriptor;
+    auto        bs_hash          = hash<AGPUBlendStateDescriptor>();
+    bs_hash.count                = a.render_target_count;
     hash_combine(result,
                  rs_a,
                  vertex_shader,
@@ -529,16 +588,40 @@ size_t hash<AGPURenderPipelineDescriptor>::operator()(const AGPURenderPipelineDe
                  geom_shader,
                  fragment_shader,
                  vertex_layout,
-                 blend_state,
+                 bs_hash(blend_state),
                  depth_state,
                  rasterizer_state,
                  block);
-    return 0;
+    return result;
 }
 
 size_t hash<hash<AGPURenderPipelineDescriptor>::ParameterBlock>::operator()(
     const hash<AGPURenderPipelineDescriptor>::ParameterBlock& val) const
 {
-    return agpu_name_hash(&val, sizeof(hash<AGPURenderPipelineDescriptor>::ParameterBlock));
+    using ParameterBlock = hash<AGPURenderPipelineDescriptor>::ParameterBlock;
+    return agpu_name_hash(&val, offsetof(ParameterBlock, enable_indirect_command) + sizeof(bool));
+}
+
+size_t equal_to<AGPUComputePipelineDescriptor>::operator()(const AGPUComputePipelineDescriptor& a,
+                                                           const AGPUComputePipelineDescriptor& b) const
+{
+    // equal root signature
+    const auto rs_a = a.pipeline_layout->pool_layout ? a.pipeline_layout->pool_layout : a.pipeline_layout;
+    const auto rs_b = b.pipeline_layout->pool_layout ? b.pipeline_layout->pool_layout : b.pipeline_layout;
+    if (rs_a != rs_b) return false;
+
+    if (a.compute_shader && !b.compute_shader) return false;
+    if (!a.compute_shader && b.compute_shader) return false;
+    if (a.compute_shader && !equal_to<AGPUShaderEntryDescriptor>()(*a.compute_shader, *b.compute_shader)) return false;
+    return true;
+}
+
+size_t hash<AGPUComputePipelineDescriptor>::operator()(const AGPUComputePipelineDescriptor& a) const
+{
+    size_t      result         = 0;
+    const void* rs_a           = a.pipeline_layout->pool_layout ? a.pipeline_layout->pool_layout : a.pipeline_layout;
+    const auto& compute_shader = a.compute_shader ? *a.compute_shader : kZeroAGPUShaderEntryDescriptor;
+    hash_combine(result, rs_a, compute_shader);
+    return result;
 }
 } // namespace std
\ No newline at end of file
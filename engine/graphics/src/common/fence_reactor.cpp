@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <atomGraphics/common/agpux.h>
+
+// the poll interval doubles while no fence completes, new watches wake the reactor right away
+static constexpr std::chrono::microseconds kFenceReactorMinPollInterval{20};
+static constexpr std::chrono::microseconds kFenceReactorMaxPollInterval{1000};
+
+struct FenceWatch {
+    AGPUFenceIter      fence;
+    AGPUXFenceCallback callback;
+    void*              user_data;
+};
+
+struct FenceReactor {
+    std::mutex              mutex;
+    std::condition_variable wake;
+    std::thread             worker;
+    bool                    running    = false;
+    // bumped by every shutdown, a worker stops once it no longer matches, even if a later watch started another one
+    uint64_t                generation = 0;
+    std::vector<FenceWatch> incoming;
+
+    // fences watched per device, for the check in agpu_free_device
+    std::vector<std::pair<AGPUDeviceIter, uint32_t>> watched;
+
+    // never destroyed, a static destructor would poll fences of devices that are gone by then.
+    // agpux_fence_reactor_shutdown has to run before the devices are freed
+    static FenceReactor& instance()
+    {
+        static FenceReactor* reactor = new FenceReactor();
+        return *reactor;
+    }
+
+    void watch(const FenceWatch& entry)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            incoming.push_back(entry);
+            count(entry.fence->device, 1);
+            if (!running) {
+                running = true;
+                worker  = std::thread([this, current = generation] { run(current); });
+            }
+        }
+        wake.notify_all();
+    }
+
+    void shutdown()
+    {
+        std::thread stopped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return;
+            running = false;
+            generation++;
+            // moved out under the lock, a watch racing the join starts a new worker instead of overwriting this one
+            stopped = std::move(worker);
+        }
+        wake.notify_all();
+        stopped.join();
+    }
+
+    // mutex held
+    auto find(AGPUDeviceIter device)
+    {
+        return std::find_if(watched.begin(), watched.end(), [device](const auto& pair) { return pair.first == device; });
+    }
+
+    // mutex held
+    void count(AGPUDeviceIter device, int32_t delta)
+    {
+        auto iter = find(device);
+        if (iter == watched.end()) iter = watched.insert(watched.end(), {device, 0u});
+        iter->second += delta;
+        if (!iter->second) watched.erase(iter);
+    }
+
+    uint32_t watch_count(AGPUDeviceIter device)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto                  iter = find(device);
+        return iter != watched.end() ? iter->second : 0;
+    }
+
+    void complete(const FenceWatch& entry)
+    {
+        // the callback may free the fence
+        const AGPUDeviceIter device = entry.fence->device;
+        // the fence already signaled, so this only resets it and retires its frame
+        agpu_wait_fences(&entry.fence, 1);
+        entry.callback(entry.fence, entry.user_data);
+        std::lock_guard<std::mutex> lock(mutex);
+        count(device, -1);
+    }
+
+    void run(uint64_t current)
+    {
+        std::vector<FenceWatch>   active;
+        std::chrono::microseconds interval = kFenceReactorMinPollInterval;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (active.empty()) {
+                    wake.wait(lock, [&] { return !incoming.empty() || generation != current; });
+                } else if (incoming.empty() && generation == current) {
+                    wake.wait_for(lock, interval);
+                }
+                active.insert(active.end(), incoming.begin(), incoming.end());
+                incoming.clear();
+                if (generation != current) break;
+            }
+            // poll the whole batch, callbacks run outside the lock so they may watch further fences
+            size_t kept = 0;
+            for (size_t i = 0; i < active.size(); i++) {
+                if (agpu_query_fence_status(active[i].fence) == AGPU_FENCE_STATUS_INCOMPLETE) {
+                    active[kept++] = active[i];
+                } else {
+                    complete(active[i]);
+                }
+            }
+            interval =
+                kept < active.size() ? kFenceReactorMinPollInterval : std::min(interval * 2, kFenceReactorMaxPollInterval);
+            active.resize(kept);
+        }
+        // nobody polls anymore, block on the rest so that no waiter is left behind
+        for (const auto& entry : active) complete(entry);
+    }
+};
+
+void agpux_fence_reactor_watch(AGPUFenceIter fence, AGPUXFenceCallback callback, void* user_data)
+{
+    atom_assert(fence && callback);
+    FenceReactor::instance().watch(FenceWatch{fence, callback, user_data});
+}
+
+void agpux_fence_reactor_shutdown() { FenceReactor::instance().shutdown(); }
+
+uint32_t agpux_fence_reactor_watch_count(AGPUDeviceIter device) { return FenceReactor::instance().watch_count(device); }
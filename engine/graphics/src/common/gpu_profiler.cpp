@@ -0,0 +1,219 @@
+#include <cstdio>
+#include <vector>
+
+#include <atomGraphics/common/agpux.h>
+
+struct AGPUXGpuProfilerFrame {
+    AGPUBufferIter                          readback = ATOM_NULLPTR;
+    std::vector<const atom_profile_site_t*> sites;
+    std::vector<uint32_t>                   depths;
+    uint32_t                                zone_count = 0;
+    // resolved and not yet read back
+    bool                                    pending    = false;
+};
+
+struct AGPUXGpuProfiler {
+    AGPUDeviceIter                     device       = ATOM_NULLPTR;
+    AGPUQueueIter                      queue        = ATOM_NULLPTR;
+    AGPUQueryPoolIter                  pool         = ATOM_NULLPTR;
+    AGPUBufferIter                     calibration  = ATOM_NULLPTR;
+    atom_profile_track_t*              track        = ATOM_NULLPTR;
+    uint32_t                           max_zones    = 0;
+    uint32_t                           frame_slot   = 0;
+    float                              ns_per_tick  = 1.f;
+    // a gpu timestamp and the cpu time it was taken at
+    uint64_t                           anchor_ticks = 0;
+    int64_t                            anchor_ns    = 0;
+    bool                               overflowed   = false;
+    std::vector<AGPUXGpuProfilerFrame> frames;
+    std::vector<uint32_t>              open_zones;
+    std::vector<AGPUXGpuZone>          zones;
+
+    // the last query of the pool is kept for calibration
+    uint32_t calibration_query() const { return (uint32_t)frames.size() * max_zones * 2; }
+
+    uint32_t frame_base() const { return frame_slot * max_zones * 2; }
+
+    void calibrate()
+    {
+        AGPUCommandPoolDescriptor   pool_desc = {u8"AGPUX::gpu_profiler"};
+        AGPUCommandBufferDescriptor cmd_desc  = {};
+        AGPUCommandPoolIter         cmd_pool  = agpu_create_command_pool(queue, &pool_desc);
+        AGPUCommandBufferIter       cmd       = agpu_create_command_buffer(cmd_pool, &cmd_desc);
+        AGPUFenceIter               fence     = agpu_create_fence(device);
+
+        const uint32_t      query = calibration_query();
+        AGPUQueryDescriptor stamp = {query, AGPU_SHADER_STAGE_ALL_GRAPHICS};
+        agpu_cmd_begin(cmd);
+        agpu_cmd_reset_query_pool(cmd, pool, query, 1);
+        agpu_cmd_begin_query(cmd, pool, &stamp);
+        agpu_cmd_resolve_query(cmd, pool, calibration, query, 1);
+        agpu_cmd_end(cmd);
+
+        AGPUQueueSubmitDescriptor submit = {};
+        submit.cmds                      = &cmd;
+        submit.cmds_count                = 1;
+        submit.signal_fence              = fence;
+        const int64_t submitted_ns       = atom_profile_time_ns();
+        agpu_submit_queue(queue, &submit);
+        agpu_wait_fences(&fence, 1);
+        const int64_t completed_ns = atom_profile_time_ns();
+
+        // the timestamp landed somewhere in between, the midpoint bounds the error by half the round trip
+        anchor_ticks = *(const uint64_t*)calibration->info->cpu_mapped_address;
+        anchor_ns    = submitted_ns + (completed_ns - submitted_ns) / 2;
+        ns_per_tick  = agpu_queue_get_timestamp_period_ns(queue);
+
+        agpu_free_fence(fence);
+        agpu_free_command_buffer(cmd);
+        agpu_free_command_pool(cmd_pool);
+    }
+
+    int64_t to_ns(uint64_t ticks) const
+    {
+        return anchor_ns + (int64_t)((double)(int64_t)(ticks - anchor_ticks) * (double)ns_per_tick);
+    }
+
+    void read_back(const AGPUXGpuProfilerFrame& frame)
+    {
+        const uint64_t* ticks = (const uint64_t*)frame.readback->info->cpu_mapped_address;
+        zones.resize(frame.zone_count);
+        for (uint32_t i = 0; i < frame.zone_count; i++) {
+            AGPUXGpuZone& zone = zones[i];
+            zone.site          = frame.sites[i];
+            zone.depth         = frame.depths[i];
+            zone.begin_ns      = to_ns(ticks[i * 2]);
+            zone.end_ns        = to_ns(ticks[i * 2 + 1]);
+            atom_profile_track_emit(track, zone.site, zone.begin_ns, zone.end_ns);
+        }
+    }
+
+    void begin_frame(AGPUCommandBufferIter cmd)
+    {
+        AGPUXGpuProfilerFrame& frame = frames[frame_slot];
+        if (frame.pending) read_back(frame);
+        frame.zone_count = 0;
+        frame.pending    = false;
+        open_zones.clear();
+        agpu_cmd_reset_query_pool(cmd, pool, frame_base(), max_zones * 2);
+    }
+
+    void end_frame(AGPUCommandBufferIter cmd)
+    {
+        atom_assert(open_zones.empty() && "gpu zones left open at the end of the frame");
+        AGPUXGpuProfilerFrame& frame = frames[frame_slot];
+        // unwritten queries would block the resolve forever
+        while (!open_zones.empty()) end_zone(cmd, open_zones.back());
+        if (frame.zone_count) {
+            agpu_cmd_resolve_query(cmd, pool, frame.readback, frame_base(), frame.zone_count * 2);
+            frame.pending = true;
+        }
+        frame_slot = (frame_slot + 1) % (uint32_t)frames.size();
+    }
+
+    uint32_t begin_zone(AGPUCommandBufferIter cmd, const atom_profile_site_t* site)
+    {
+        AGPUEventInfo event = {(const char8_t*)site->name, {1.f, 1.f, 1.f, 1.f}};
+        agpu_cmd_begin_event(cmd, &event);
+
+        AGPUXGpuProfilerFrame& frame = frames[frame_slot];
+        if (frame.zone_count == max_zones) {
+            if (!overflowed) ATOM_warn(u8"gpu profiler: more than %u zones in a frame, the rest is dropped", max_zones);
+            overflowed = true;
+            open_zones.push_back(AGPUX_GPU_ZONE_INVALID);
+            return AGPUX_GPU_ZONE_INVALID;
+        }
+        const uint32_t      zone  = frame.zone_count++;
+        AGPUQueryDescriptor stamp = {frame_base() + zone * 2, AGPU_SHADER_STAGE_NONE};
+        agpu_cmd_begin_query(cmd, pool, &stamp);
+        frame.sites[zone]  = site;
+        frame.depths[zone] = (uint32_t)open_zones.size();
+        open_zones.push_back(zone);
+        return zone;
+    }
+
+    void end_zone(AGPUCommandBufferIter cmd, uint32_t zone)
+    {
+        atom_assert(!open_zones.empty() && open_zones.back() == zone && "gpu zones must nest");
+        open_zones.pop_back();
+        if (zone != AGPUX_GPU_ZONE_INVALID) {
+            AGPUQueryDescriptor stamp = {frame_base() + zone * 2 + 1, AGPU_SHADER_STAGE_ALL_GRAPHICS};
+            agpu_cmd_end_query(cmd, pool, &stamp);
+        }
+        agpu_cmd_end_event(cmd);
+    }
+};
+
+AGPUXGpuProfilerIter agpux_create_gpu_profiler(AGPUDeviceIter device, const struct AGPUXGpuProfilerDescriptor* desc)
+{
+    atom_assert(desc->queue && desc->frames_in_flight && desc->max_zones_per_frame);
+    AGPUXGpuProfiler* profiler = atom_new<AGPUXGpuProfiler>();
+    profiler->device           = device;
+    profiler->queue            = desc->queue;
+    profiler->max_zones        = desc->max_zones_per_frame;
+    profiler->frames.resize(desc->frames_in_flight);
+
+    AGPUQueryPoolDescriptor pool_desc = {};
+    pool_desc.type                    = AGPU_QUERY_TYPE_TIMESTAMP;
+    pool_desc.query_count             = profiler->calibration_query() + 1;
+    profiler->pool                    = agpu_create_query_pool(device, &pool_desc);
+
+    AGPUBufferDescriptor buffer_desc = {};
+    buffer_desc.name                 = u8"AGPUX::gpu_profiler::readback";
+    buffer_desc.memory_usage         = AGPU_MEM_USAGE_GPU_TO_CPU;
+    buffer_desc.flags                = AGPU_BCF_PERSISTENT_MAP_BIT;
+    buffer_desc.size                 = sizeof(uint64_t);
+    profiler->calibration            = agpu_create_buffer(device, &buffer_desc);
+    buffer_desc.size                 = sizeof(uint64_t) * 2 * profiler->max_zones;
+    for (auto& frame : profiler->frames) {
+        frame.readback = agpu_create_buffer(device, &buffer_desc);
+        frame.sites.resize(profiler->max_zones);
+        frame.depths.resize(profiler->max_zones);
+    }
+
+    char track_name[64];
+    snprintf(track_name, sizeof(track_name), "gpu: %s", desc->name ? desc->name : "queue");
+    profiler->track = atom_profile_create_track(track_name);
+    profiler->calibrate();
+    return profiler;
+}
+
+void agpux_gpu_profiler_begin_frame(AGPUXGpuProfilerIter profiler, AGPUCommandBufferIter cmd)
+{
+    ((AGPUXGpuProfiler*)profiler)->begin_frame(cmd);
+}
+
+void agpux_gpu_profiler_end_frame(AGPUXGpuProfilerIter profiler, AGPUCommandBufferIter cmd)
+{
+    ((AGPUXGpuProfiler*)profiler)->end_frame(cmd);
+}
+
+uint32_t agpux_gpu_profiler_begin_zone(AGPUXGpuProfilerIter       profiler,
+                                       AGPUCommandBufferIter      cmd,
+                                       const atom_profile_site_t* site)
+{
+    return ((AGPUXGpuProfiler*)profiler)->begin_zone(cmd, site);
+}
+
+void agpux_gpu_profiler_end_zone(AGPUXGpuProfilerIter profiler, AGPUCommandBufferIter cmd, uint32_t zone)
+{
+    ((AGPUXGpuProfiler*)profiler)->end_zone(cmd, zone);
+}
+
+const AGPUXGpuZone* agpux_gpu_profiler_get_zones(AGPUXGpuProfilerIter profiler, uint32_t* count)
+{
+    *count = (uint32_t)profiler->zones.size();
+    return profiler->zones.data();
+}
+
+void agpux_gpu_profiler_calibrate(AGPUXGpuProfilerIter profiler) { ((AGPUXGpuProfiler*)profiler)->calibrate(); }
+
+void agpux_free_gpu_profiler(AGPUXGpuProfilerIter profiler)
+{
+    AGPUXGpuProfiler* P = (AGPUXGpuProfiler*)profiler;
+    for (auto& frame : P->frames) agpu_free_buffer(frame.readback);
+    agpu_free_buffer(P->calibration);
+    agpu_free_query_pool(P->pool);
+    atom_profile_free_track(P->track);
+    atom_delete(P);
+}
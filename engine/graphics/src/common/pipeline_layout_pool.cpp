@@ -2,18 +2,14 @@
 #include <atomGraphics/common/common_utils.h>
 
 // hash container for resolved pipeline layout
+// tables, push constants, static samplers and the pipeline type are streamed into one 128-bit digest,
+// which is wide enough to serve as the identity of the layout
 struct PipelineLayoutCharacteristic {
-    // table count & hash
-    uint32_t          table_count;
-    size_t            table_hash;
-    uint32_t          push_constant_count;
-    size_t            push_constant_hash;
-    // static samplers tie with root layoutnature
-    uint32_t          static_sampler_count;
-    size_t            static_samplers_hash;
-    eAGPUPipelineType pipeline_type;
-
-    operator size_t() const { return atom_hash(this, sizeof(PipelineLayoutCharacteristic), (size_t)pipeline_type); }
+    atom_hash128_t digest;
+
+    operator size_t() const { return std::hash<atom_hash128_t>{}(digest); }
+
+    bool operator==(const PipelineLayoutCharacteristic& other) const { return digest == other.digest; }
 
     struct BoundResource {
         eAGPUResourceType     type;
@@ -57,9 +53,8 @@ public:
                                                                           const AGPUPipelineLayoutDescriptor* desc) const
     {
         // calculate characteristic
-        PipelineLayoutCharacteristic newCharacteristic = {};
-        newCharacteristic.table_count                  = layoutTables->table_count;
-        newCharacteristic.table_hash                   = (size_t)this;
+        AtomHasher hasher((size_t)this);
+        hasher.update(layoutTables->table_count);
         for (uint32_t i = 0; i < layoutTables->table_count; i++) {
             for (uint32_t j = 0; j < layoutTables->tables[i].resources_count; j++) {
                 const auto&                                 res = layoutTables->tables[i].resources[j];
@@ -71,11 +66,10 @@ public:
                 r.size                                          = res.size;
                 r.offset                                        = res.offset;
                 r.stages                                        = res.stages;
-                newCharacteristic.table_hash                    = atom_hash(&r, sizeof(r), newCharacteristic.table_hash);
+                hasher.update(r);
             }
         }
-        newCharacteristic.push_constant_count = layoutTables->push_constant_count;
-        newCharacteristic.push_constant_hash  = (size_t)this;
+        hasher.update(layoutTables->push_constant_count);
         for (uint32_t i = 0; i < desc->push_constant_count; i++) {
             PipelineLayoutCharacteristic::PushConstant p = {};
             p.set                                        = layoutTables->push_constants[i].set;
@@ -83,10 +77,9 @@ public:
             p.size                                       = layoutTables->push_constants[i].size;
             p.offset                                     = layoutTables->push_constants[i].offset;
             p.stages                                     = layoutTables->push_constants[i].stages;
-            newCharacteristic.push_constant_hash         = atom_hash(&p, sizeof(p), newCharacteristic.push_constant_hash);
+            hasher.update(p);
         }
-        newCharacteristic.static_sampler_count = desc->static_sampler_count;
-        newCharacteristic.static_samplers_hash = ~0;
+        hasher.update(desc->static_sampler_count);
         // static samplers are well stable-sorted during RSTable intiialization
         for (uint32_t i = 0; i < desc->static_sampler_count; i++) {
             for (uint32_t j = 0; j < desc->static_sampler_count; j++) {
@@ -96,11 +89,14 @@ public:
                     s.set                                         = layoutTables->static_samplers[i].set;
                     s.binding                                     = layoutTables->static_samplers[i].binding;
                     s.id                                          = desc->static_samplers[j];
-                    newCharacteristic.static_samplers_hash = atom_hash(&s, sizeof(s), newCharacteristic.static_samplers_hash);
+                    hasher.update(s);
                 }
             }
         }
-        newCharacteristic.pipeline_type = layoutTables->pipeline_type;
+        hasher.update(layoutTables->pipeline_type);
+
+        PipelineLayoutCharacteristic newCharacteristic = {};
+        newCharacteristic.digest                       = hasher.digest_128();
         return newCharacteristic;
     }
 
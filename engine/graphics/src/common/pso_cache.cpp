@@ -0,0 +1,262 @@
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <atomContainer/hashmap.hpp>
+#include <atomGraphics/common/agpux.hpp>
+
+// keeps the entry name and constants of a shader entry alive for as long as the cached descriptor points at them
+struct AGPUXPsoShaderEntry {
+    AGPUShaderEntryDescriptor               entry = {};
+    std::u8string                           name;
+    std::vector<AGPUConstantSpecialization> constants;
+
+    const AGPUShaderEntryDescriptor* assign(const AGPUShaderEntryDescriptor* src)
+    {
+        if (!src) return ATOM_NULLPTR;
+        entry = *src;
+        if (src->entry) {
+            name        = src->entry;
+            entry.entry = name.c_str();
+        }
+        if (src->num_constants) constants.assign(src->constants, src->constants + src->num_constants);
+        entry.constants = constants.data();
+        return &entry;
+    }
+};
+
+// entries are heap allocated and never move, the descriptor copies point into their own entry
+struct AGPUXRenderPsoEntry {
+    using descriptor_type = AGPURenderPipelineDescriptor;
+    using pipeline_type   = AGPURenderPipelineIter;
+
+    AGPURenderPipelineDescriptor  desc = {};
+    AGPUXPsoShaderEntry           shaders[5];
+    AGPUVertexLayout              vertex_layout;
+    AGPUBlendStateDescriptor      blend_state;
+    AGPUDepthStateDescriptor      depth_state;
+    AGPURasterizerStateDescriptor rasterizer_state;
+    eAGPUFormat                   color_formats[AGPU_MAX_MRT_COUNT];
+    size_t                        hash     = 0;
+    AGPURenderPipelineIter        pipeline = ATOM_NULLPTR;
+    std::atomic<uint32_t>         refs     = 1;
+
+    AGPUXRenderPsoEntry(const AGPURenderPipelineDescriptor& src, size_t hash) : desc(src), hash(hash)
+    {
+        desc.vertex_shader   = shaders[0].assign(src.vertex_shader);
+        desc.tesc_shader     = shaders[1].assign(src.tesc_shader);
+        desc.tese_shader     = shaders[2].assign(src.tese_shader);
+        desc.geom_shader     = shaders[3].assign(src.geom_shader);
+        desc.fragment_shader = shaders[4].assign(src.fragment_shader);
+        if (src.vertex_layout) desc.vertex_layout = &(vertex_layout = *src.vertex_layout);
+        if (src.blend_state) desc.blend_state = &(blend_state = *src.blend_state);
+        if (src.depth_state) desc.depth_state = &(depth_state = *src.depth_state);
+        if (src.rasterizer_state) desc.rasterizer_state = &(rasterizer_state = *src.rasterizer_state);
+        for (uint32_t i = 0; i < src.render_target_count; i++) color_formats[i] = src.color_formats[i];
+        desc.color_formats = color_formats;
+    }
+};
+
+struct AGPUXComputePsoEntry {
+    using descriptor_type = AGPUComputePipelineDescriptor;
+    using pipeline_type   = AGPUComputePipelineIter;
+
+    AGPUComputePipelineDescriptor desc = {};
+    AGPUXPsoShaderEntry           compute_shader;
+    size_t                        hash     = 0;
+    AGPUComputePipelineIter       pipeline = ATOM_NULLPTR;
+    std::atomic<uint32_t>         refs     = 1;
+
+    AGPUXComputePsoEntry(const AGPUComputePipelineDescriptor& src, size_t hash) : desc(src), hash(hash)
+    {
+        desc.compute_shader = const_cast<AGPUShaderEntryDescriptor*>(compute_shader.assign(src.compute_shader));
+    }
+};
+
+// the hash is computed once per lookup and carried along, the map never rehashes a descriptor
+template <typename Entry>
+struct AGPUXPsoKey {
+    using descriptor_type = typename Entry::descriptor_type;
+
+    size_t                 hash;
+    const descriptor_type* desc;
+
+    bool operator==(const AGPUXPsoKey& rhs) const
+    {
+        return hash == rhs.hash && (desc == rhs.desc || std::equal_to<descriptor_type>()(*desc, *rhs.desc));
+    }
+};
+
+template <typename Entry>
+struct AGPUXPsoKeyHasher {
+    size_t operator()(const AGPUXPsoKey<Entry>& key) const { return key.hash; }
+};
+
+template <typename Entry>
+class AGPUXPsoTable
+{
+public:
+    using descriptor_type = typename Entry::descriptor_type;
+    using pipeline_type   = typename Entry::pipeline_type;
+    using key_type        = AGPUXPsoKey<Entry>;
+
+    template <typename Create>
+    pipeline_type acquire(const descriptor_type& desc, Create&& create)
+    {
+        const key_type key{std::hash<descriptor_type>()(desc), &desc};
+        pipeline_type  found = ATOM_NULLPTR;
+        // hits only hold the shared lock of the submap while the reference is taken
+        if (entries.if_contains(key, [&](const auto& value) {
+                value.second->refs.fetch_add(1, std::memory_order_relaxed);
+                found = value.second->pipeline;
+            })) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return found;
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+
+        // compile without holding any lock, then publish unless another thread got there first
+        Entry* entry    = atom_new<Entry>(desc, key.hash);
+        entry->pipeline = create(desc);
+        if (!entry->pipeline) {
+            atom_delete(entry);
+            return ATOM_NULLPTR;
+        }
+        // reachable for releases before anyone else can hit it
+        by_pipeline.emplace(entry->pipeline, entry);
+        Entry* winner = ATOM_NULLPTR;
+        entries.lazy_emplace_l(
+            key_type{key.hash, &entry->desc},
+            [&](auto& value) {
+                winner = value.second;
+                winner->refs.fetch_add(1, std::memory_order_relaxed);
+            },
+            [&](const auto& ctor) { ctor(key_type{key.hash, &entry->desc}, entry); });
+        if (!winner) return entry->pipeline;
+
+        by_pipeline.erase(entry->pipeline);
+        discard(entry);
+        return winner->pipeline;
+    }
+
+    void release(pipeline_type pipeline)
+    {
+        Entry* entry = ATOM_NULLPTR;
+        by_pipeline.if_contains(pipeline, [&](const auto& value) { entry = value.second; });
+        atom_assert(entry && "pipeline was not acquired from this pso cache");
+        if (!entry) return;
+
+        // any other reference drops under the shared lock, like a hit takes it
+        bool last = false;
+        entries.if_contains(key_type{entry->hash, &entry->desc}, [&](const auto& value) {
+            auto&    refs  = value.second->refs;
+            uint32_t count = refs.load(std::memory_order_relaxed);
+            while (count > 1
+                   && !refs.compare_exchange_weak(count, count - 1, std::memory_order_release, std::memory_order_relaxed)) {}
+            last = count == 1;
+        });
+        if (!last) return;
+
+        // the last reference drops under the write lock, so no hit can revive the entry after it was taken out
+        bool dead = false;
+        entries.erase_if(key_type{entry->hash, &entry->desc}, [&](auto& value) {
+            dead = value.second->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            return dead;
+        });
+        if (!dead) return;
+        by_pipeline.erase(pipeline);
+        discard(entry);
+    }
+
+    void clear()
+    {
+        entries.clear();
+        for (auto& [pipeline, entry] : by_pipeline) discard(entry);
+        by_pipeline.clear();
+    }
+
+    uint64_t hit_count() const { return hits.load(std::memory_order_relaxed); }
+
+    uint64_t miss_count() const { return misses.load(std::memory_order_relaxed); }
+
+    uint32_t size() const { return (uint32_t)entries.size(); }
+
+private:
+    static void discard(Entry* entry)
+    {
+        if constexpr (std::is_same_v<pipeline_type, AGPURenderPipelineIter>)
+            agpu_free_render_pipeline(entry->pipeline);
+        else
+            agpu_free_compute_pipeline(entry->pipeline);
+        atom_delete(entry);
+    }
+
+    atom::parallel_flat_hash_map<key_type, Entry*, AGPUXPsoKeyHasher<Entry>> entries{};
+    atom::parallel_flat_hash_map<pipeline_type, Entry*>                      by_pipeline{};
+    std::atomic<uint64_t>                                                    hits   = 0;
+    std::atomic<uint64_t>                                                    misses = 0;
+};
+
+struct AGPUXPsoCache {
+    AGPUDeviceIter                      device        = ATOM_NULLPTR;
+    bool                                async_compile = false;
+    AGPUXPsoTable<AGPUXRenderPsoEntry>  render;
+    AGPUXPsoTable<AGPUXComputePsoEntry> compute;
+};
+
+AGPUXPsoCacheIter agpux_create_pso_cache(AGPUDeviceIter device, const struct AGPUXPsoCacheDescriptor* desc)
+{
+    AGPUXPsoCache* cache = atom_new<AGPUXPsoCache>();
+    cache->device        = device;
+    cache->async_compile = desc && desc->async_compile;
+    return cache;
+}
+
+AGPURenderPipelineIter agpux_pso_cache_acquire_render_pipeline(AGPUXPsoCacheIter                          cache,
+                                                               const struct AGPURenderPipelineDescriptor* desc)
+{
+    AGPUXPsoCache* C = (AGPUXPsoCache*)cache;
+    return C->render.acquire(*desc, [C](const AGPURenderPipelineDescriptor& pipeline_desc) {
+        return C->async_compile ? agpu_create_render_pipeline_async(C->device, &pipeline_desc, ATOM_NULLPTR)
+                                : agpu_create_render_pipeline(C->device, &pipeline_desc);
+    });
+}
+
+AGPUComputePipelineIter agpux_pso_cache_acquire_compute_pipeline(AGPUXPsoCacheIter                           cache,
+                                                                 const struct AGPUComputePipelineDescriptor* desc)
+{
+    AGPUXPsoCache* C = (AGPUXPsoCache*)cache;
+    return C->compute.acquire(*desc, [C](const AGPUComputePipelineDescriptor& pipeline_desc) {
+        return C->async_compile ? agpu_create_compute_pipeline_async(C->device, &pipeline_desc)
+                                : agpu_create_compute_pipeline(C->device, &pipeline_desc);
+    });
+}
+
+void agpux_pso_cache_release_render_pipeline(AGPUXPsoCacheIter cache, AGPURenderPipelineIter pipeline)
+{
+    ((AGPUXPsoCache*)cache)->render.release(pipeline);
+}
+
+void agpux_pso_cache_release_compute_pipeline(AGPUXPsoCacheIter cache, AGPUComputePipelineIter pipeline)
+{
+    ((AGPUXPsoCache*)cache)->compute.release(pipeline);
+}
+
+void agpux_pso_cache_query_statistics(AGPUXPsoCacheIter cache, AGPUXPsoCacheStatistics* stats)
+{
+    stats->render_hits            = cache->render.hit_count();
+    stats->render_misses          = cache->render.miss_count();
+    stats->compute_hits           = cache->compute.hit_count();
+    stats->compute_misses         = cache->compute.miss_count();
+    stats->render_pipeline_count  = cache->render.size();
+    stats->compute_pipeline_count = cache->compute.size();
+}
+
+void agpux_free_pso_cache(AGPUXPsoCacheIter cache)
+{
+    AGPUXPsoCache* C = (AGPUXPsoCache*)cache;
+    C->render.clear();
+    C->compute.clear();
+    atom_delete(C);
+}
@@ -0,0 +1,149 @@
+#include <vector>
+
+#include <atomGraphics/common/agpux.h>
+
+struct AGPUXQueryRingFrame {
+    AGPUBufferIter              readback = ATOM_NULLPTR;
+    std::vector<const char8_t*> names;
+    uint32_t                    query_count = 0;
+    // resolved and not yet read back
+    bool                        pending     = false;
+};
+
+struct AGPUXQueryRing {
+    AGPUQueryPoolIter                pool        = ATOM_NULLPTR;
+    AGPUPipelineStatistics           statistics  = AGPU_PIPELINE_STATISTIC_NONE;
+    uint32_t                         max_queries = 0;
+    uint32_t                         frame_slot  = 0;
+    uint32_t                         open_query  = AGPUX_QUERY_INVALID;
+    bool                             overflowed  = false;
+    std::vector<AGPUXQueryRingFrame> frames;
+    // copied out of the readback buffer, the gpu reuses it frames_in_flight frames later
+    std::vector<uint64_t>            values;
+    std::vector<AGPUXQueryResult>    results;
+
+    uint32_t frame_base() const { return frame_slot * max_queries; }
+
+    void read_back(const AGPUXQueryRingFrame& frame)
+    {
+        const uint32_t  stride = pool->result_count;
+        const uint64_t* mapped = (const uint64_t*)frame.readback->info->cpu_mapped_address;
+        values.assign(mapped, mapped + frame.query_count * stride);
+        results.resize(frame.query_count);
+        for (uint32_t i = 0; i < frame.query_count; i++) results[i] = AGPUXQueryResult{frame.names[i], &values[i * stride]};
+    }
+
+    void begin_frame(AGPUCommandBufferIter cmd)
+    {
+        AGPUXQueryRingFrame& frame = frames[frame_slot];
+        if (frame.pending) read_back(frame);
+        frame.query_count = 0;
+        frame.pending     = false;
+        agpu_cmd_reset_query_pool(cmd, pool, frame_base(), max_queries);
+    }
+
+    void end_frame(AGPUCommandBufferIter cmd)
+    {
+        atom_assert(open_query == AGPUX_QUERY_INVALID && "query left open at the end of the frame");
+        AGPUXQueryRingFrame& frame = frames[frame_slot];
+        if (frame.query_count) {
+            agpu_cmd_resolve_query(cmd, pool, frame.readback, frame_base(), frame.query_count);
+            frame.pending = true;
+        }
+        frame_slot = (frame_slot + 1) % (uint32_t)frames.size();
+    }
+
+    uint32_t begin(AGPUCommandBufferIter cmd, const char8_t* name)
+    {
+        atom_assert(open_query == AGPUX_QUERY_INVALID && "queries of a ring cannot nest");
+        AGPUXQueryRingFrame& frame = frames[frame_slot];
+        if (frame.query_count == max_queries) {
+            if (!overflowed) ATOM_warn(u8"query ring: more than %u queries in a frame, the rest is dropped", max_queries);
+            overflowed = true;
+            return AGPUX_QUERY_INVALID;
+        }
+        const uint32_t      query = frame.query_count++;
+        AGPUQueryDescriptor desc  = {frame_base() + query, AGPU_SHADER_STAGE_NONE};
+        agpu_cmd_begin_query(cmd, pool, &desc);
+        frame.names[query] = name;
+        open_query         = query;
+        return query;
+    }
+
+    void end(AGPUCommandBufferIter cmd, uint32_t query)
+    {
+        if (query == AGPUX_QUERY_INVALID) return;
+        atom_assert(open_query == query && "ending a query that is not open");
+        AGPUQueryDescriptor desc = {frame_base() + query, AGPU_SHADER_STAGE_NONE};
+        agpu_cmd_end_query(cmd, pool, &desc);
+        open_query = AGPUX_QUERY_INVALID;
+    }
+};
+
+AGPUXQueryRingIter agpux_create_query_ring(AGPUDeviceIter device, const struct AGPUXQueryRingDescriptor* desc)
+{
+    atom_assert(desc->type != AGPU_QUERY_TYPE_TIMESTAMP && "timestamps are measured by the gpu profiler");
+    atom_assert(desc->frames_in_flight && desc->max_queries_per_frame);
+    AGPUXQueryRing* ring = atom_new<AGPUXQueryRing>();
+    ring->statistics     = desc->type == AGPU_QUERY_TYPE_PIPELINE_STATISTICS ? desc->pipeline_statistics : 0;
+    ring->max_queries    = desc->max_queries_per_frame;
+    ring->frames.resize(desc->frames_in_flight);
+
+    AGPUQueryPoolDescriptor pool_desc = {};
+    pool_desc.type                    = desc->type;
+    pool_desc.query_count             = desc->frames_in_flight * desc->max_queries_per_frame;
+    pool_desc.pipeline_statistics     = ring->statistics;
+    pool_desc.precise_occlusion       = desc->precise_occlusion;
+    ring->pool                        = agpu_create_query_pool(device, &pool_desc);
+
+    AGPUBufferDescriptor buffer_desc = {};
+    buffer_desc.name                 = u8"AGPUX::query_ring::readback";
+    buffer_desc.memory_usage         = AGPU_MEM_USAGE_GPU_TO_CPU;
+    buffer_desc.flags                = AGPU_BCF_PERSISTENT_MAP_BIT;
+    buffer_desc.size                 = sizeof(uint64_t) * ring->pool->result_count * ring->max_queries;
+    for (auto& frame : ring->frames) {
+        frame.readback = agpu_create_buffer(device, &buffer_desc);
+        frame.names.resize(ring->max_queries);
+    }
+    return ring;
+}
+
+void agpux_query_ring_begin_frame(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd)
+{
+    ((AGPUXQueryRing*)ring)->begin_frame(cmd);
+}
+
+void agpux_query_ring_end_frame(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd) { ((AGPUXQueryRing*)ring)->end_frame(cmd); }
+
+uint32_t agpux_query_ring_begin(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd, const char8_t* name)
+{
+    return ((AGPUXQueryRing*)ring)->begin(cmd, name);
+}
+
+void agpux_query_ring_end(AGPUXQueryRingIter ring, AGPUCommandBufferIter cmd, uint32_t query)
+{
+    ((AGPUXQueryRing*)ring)->end(cmd, query);
+}
+
+const AGPUXQueryResult* agpux_query_ring_get_results(AGPUXQueryRingIter ring, uint32_t* count)
+{
+    *count = (uint32_t)ring->results.size();
+    return ring->results.data();
+}
+
+uint64_t agpux_query_ring_statistic(AGPUXQueryRingIter ring, const AGPUXQueryResult* result, eAGPUPipelineStatistic statistic)
+{
+    if (!(ring->statistics & statistic)) return 0;
+    // counters are packed in bit order, the index is the number of enabled bits below this one
+    uint32_t index = 0;
+    for (AGPUPipelineStatistics bits = ring->statistics & (statistic - 1); bits; bits &= bits - 1) index++;
+    return result->values[index];
+}
+
+void agpux_free_query_ring(AGPUXQueryRingIter ring)
+{
+    AGPUXQueryRing* R = (AGPUXQueryRing*)ring;
+    for (auto& frame : R->frames) agpu_free_buffer(frame.readback);
+    agpu_free_query_pool(R->pool);
+    atom_delete(R);
+}
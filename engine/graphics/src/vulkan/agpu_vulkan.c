@@ -4,6 +4,7 @@
 #include <atomGraphics/backend/vulkan/vulkan_utils.h>
 #include <atomGraphics/common/config.h>
 #include <atomGraphics/common/common_utils.h>
+#include <atomCore/job.h>
 #include <../Source/SPIRV-Reflect/spirv_reflect.h>
 
 static void vulkan_find_or_create_frame_buffer(const VulkanDevice*                       D,
@@ -29,28 +30,11 @@ static void vulkan_find_or_create_frame_buffer(const VulkanDevice*
     vulkan_frame_buffer_table_add(D->pPassTable, pDesc, *ppFramebuffer);
 }
 
-// TODO: recycle cached render passes
-static ATOM_FORCEINLINE void vulkan_free_frame_buffer(VulkanDevice* D, VkFramebuffer pFramebuffer)
-{
-    D->mVkDeviceTable.vkDestroyFramebuffer(D->pVkDevice, pFramebuffer, GLOBAL_VkAllocationCallbacks);
-}
-
 // Render Pass Utils
-// TODO: recycle cached render passes
-static ATOM_FORCEINLINE void vulkan_free_render_pass(VulkanDevice* D, VkRenderPass pRenderPass)
+static void vulkan_create_render_pass(const VulkanDevice*               D,
+                                      const VulkanRenderPassDescriptor* pDesc,
+                                      VkRenderPass*                     ppRenderPass)
 {
-    D->mVkDeviceTable.vkDestroyRenderPass(D->pVkDevice, pRenderPass, GLOBAL_VkAllocationCallbacks);
-}
-
-static void vulkan_find_or_create_render_pass(const VulkanDevice*               D,
-                                              const VulkanRenderPassDescriptor* pDesc,
-                                              VkRenderPass*                     ppRenderPass)
-{
-    VkRenderPass found = vulkan_render_pass_table_try_find(D->pPassTable, pDesc);
-    if (found != VK_NULL_HANDLE) {
-        *ppRenderPass = found;
-        return;
-    }
     atom_assert(VK_NULL_HANDLE != D->pVkDevice);
     uint32_t                colorAttachmentCount        = pDesc->mColorAttachmentCount;
     uint32_t                colorResolveAttachmentCount = 0;
@@ -138,9 +122,29 @@ static void vulkan_find_or_create_render_pass(const VulkanDevice*
                                           .pDependencies   = NULL};
     CHECK_VKRESULT(
         D->mVkDeviceTable.vkCreateRenderPass(D->pVkDevice, &create_info, GLOBAL_VkAllocationCallbacks, ppRenderPass));
+}
+
+// cached passes and framebuffers are owned by D->pPassTable, which evicts them after they go unused for a few frames
+static void vulkan_find_or_create_render_pass(const VulkanDevice*               D,
+                                              const VulkanRenderPassDescriptor* pDesc,
+                                              VkRenderPass*                     ppRenderPass)
+{
+    VkRenderPass found = vulkan_render_pass_table_try_find(D->pPassTable, pDesc);
+    if (found != VK_NULL_HANDLE) {
+        *ppRenderPass = found;
+        return;
+    }
+    vulkan_create_render_pass(D, pDesc, ppRenderPass);
     vulkan_render_pass_table_add(D->pPassTable, pDesc, *ppRenderPass);
 }
 
+// X8_D24 is depth only although format_is_depth_only does not list it
+static ATOM_FORCEINLINE bool vulkan_format_has_stencil(eAGPUFormat format)
+{
+    return format == AGPU_FORMAT_D24_UNORM_S8_UINT || format == AGPU_FORMAT_D32_SFLOAT_S8_UINT
+           || format == AGPU_FORMAT_D16_UNORM_S8_UINT;
+}
+
 void agpu_query_instance_features_vulkan(AGPUInstanceIter instance, struct AGPUInstanceFeatures* features)
 {
     features->specialization_constant = true;
@@ -211,7 +215,7 @@ uint32_t agpu_query_queue_count_vulkan(const AGPUAdapterIter adapter, const eAGP
 AGPUFenceIter agpu_create_fence_vulkan(AGPUDeviceIter device)
 {
     VulkanDevice* D = (VulkanDevice*)device;
-    VulkanFence*  F = (VulkanFence*)atom_calloc(1, sizeof(VulkanFence));
+    VulkanFence*  F = (VulkanFence*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_FENCE]);
     atom_assert(F);
     VkFenceCreateInfo add_info = {
         .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
@@ -226,9 +230,10 @@ AGPUFenceIter agpu_create_fence_vulkan(AGPUDeviceIter device)
 
 void agpu_wait_fences_vulkan(const AGPUFenceIter* fences, uint32_t fence_count)
 {
-    VulkanDevice* D = (VulkanDevice*)fences[0]->device;
-    ATOM_DECLARE_ZERO_VLA(VkFence, vfences, fence_count)
-    uint32_t numValidFences = 0;
+    VulkanDevice*                   D              = (VulkanDevice*)fences[0]->device;
+    const atom_frame_arena_marker_t Scratch        = atom_frame_arena_mark();
+    VkFence*                        vfences        = atom_frame_calloc(fence_count, sizeof(VkFence), _Alignof(VkFence));
+    uint32_t                        numValidFences = 0;
     for (uint32_t i = 0; i < fence_count; ++i) {
         VulkanFence* Fence = (VulkanFence*)fences[i];
         if (Fence->mSubmitted) vfences[numValidFences++] = Fence->pVkFence;
@@ -239,8 +244,10 @@ void agpu_wait_fences_vulkan(const AGPUFenceIter* fences, uint32_t fence_count)
     }
     for (uint32_t i = 0; i < fence_count; ++i) {
         VulkanFence* Fence = (VulkanFence*)fences[i];
-        Fence->mSubmitted  = false;
+        if (Fence->mSubmitted) atom_frame_arena_retire(Fence->mFrameIndex);
+        Fence->mSubmitted = false;
     }
+    atom_frame_arena_rewind(Scratch);
 }
 
 eAGPUFenceStatus agpu_query_fence_status_vulkan(AGPUFenceIter fence)
@@ -258,6 +265,7 @@ eAGPUFenceStatus agpu_query_fence_status_vulkan(AGPUFenceIter fence)
         }
         */
         status         = vkRes == VK_SUCCESS ? AGPU_FENCE_STATUS_COMPLETE : AGPU_FENCE_STATUS_INCOMPLETE;
+        if (status == AGPU_FENCE_STATUS_COMPLETE) atom_frame_arena_retire(F->mFrameIndex);
     } else {
         status = AGPU_FENCE_STATUS_NOTSUBMITTED;
     }
@@ -269,13 +277,13 @@ void agpu_free_fence_vulkan(AGPUFenceIter fence)
     VulkanFence*        F = (VulkanFence*)fence;
     const VulkanDevice* D = (VulkanDevice*)fence->device;
     D->mVkDeviceTable.vkDestroyFence(D->pVkDevice, F->pVkFence, GLOBAL_VkAllocationCallbacks);
-    atom_free(F);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_FENCE], F);
 }
 
 AGPUSemaphoreIter agpu_create_semaphore_vulkan(AGPUDeviceIter device)
 {
     const VulkanDevice*   D              = (VulkanDevice*)device;
-    VulkanSemaphore*      Semaphore      = (VulkanSemaphore*)atom_calloc(1, sizeof(VulkanSemaphore));
+    VulkanSemaphore*      Semaphore      = (VulkanSemaphore*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_SEMAPHORE]);
     VkSemaphoreCreateInfo semaphore_info = {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = NULL, .flags = 0};
     CHECK_VKRESULT(D->mVkDeviceTable.vkCreateSemaphore(D->pVkDevice,
                                                        &semaphore_info,
@@ -290,7 +298,7 @@ void agpu_free_semaphore_vulkan(AGPUSemaphoreIter semaphore)
     const VulkanDevice* D         = (VulkanDevice*)semaphore->device;
     VulkanSemaphore*    Semaphore = (VulkanSemaphore*)semaphore;
     D->mVkDeviceTable.vkDestroySemaphore(D->pVkDevice, Semaphore->pVkSemaphore, GLOBAL_VkAllocationCallbacks);
-    atom_free(Semaphore);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_SEMAPHORE], Semaphore);
 }
 
 uint32_t get_set_count(uint32_t set_index_mask)
@@ -504,6 +512,7 @@ AGPUPipelineLayoutPoolIter agpu_create_pipeline_layout_pool_vulkan(AGPUDeviceIte
 
 void agpu_free_pipeline_layout_pool_vulkan(AGPUPipelineLayoutPoolIter pool) { agpu_free_pipeline_layout_pool_impl(pool); }
 
+static const char* kVkDescriptorSetMemoryPoolName = "AGPU::vk_descriptor_set";
 AGPUDescriptorSetIter agpu_create_descriptor_set_vulkan(AGPUDeviceIter device, const struct AGPUDescriptorSetDescriptor* desc)
 {
     size_t                totalSize   = sizeof(VulkanDescriptorSet);
@@ -516,7 +525,8 @@ AGPUDescriptorSetIter agpu_create_descriptor_set_vulkan(AGPUDeviceIter device, c
     const VulkanDevice* D                   = (VulkanDevice*)device;
     const size_t        UpdateTemplateSize  = PL->super.tables[table_index].resources_count * sizeof(VkDescriptorUpdateData);
     totalSize                              += UpdateTemplateSize;
-    VulkanDescriptorSet* Set                = atom_calloc_aligned(1, totalSize, _Alignof(VulkanDescriptorSet));
+    VulkanDescriptorSet* Set =
+        atom_calloc_alignedN(1, totalSize, _Alignof(VulkanDescriptorSet), kVkDescriptorSetMemoryPoolName);
     char8_t*             pMem               = (char8_t*)(Set + 1);
     // Allocate Descriptor Set
     vulkan_consume_descriptor_sets(D->pDescriptorPool, &SetLayout->layout, &Set->pVkDescriptorSet, 1);
@@ -539,13 +549,19 @@ void agpu_update_descriptor_set_vulkan(AGPUDescriptorSetIter set, const struct A
     const AGPUParameterTable* ParamTable  = &PL->super.tables[table_index];
     VkDescriptorUpdateData*   pUpdateData = Set->pUpdateData;
     memset(pUpdateData, 0, count * sizeof(VkDescriptorUpdateData));
+    // hash all argument names up front, unnamed arguments are matched by binding below
+    const atom_frame_arena_marker_t Scratch   = atom_frame_arena_mark();
+    const char**                    pNames    = atom_frame_alloc(count * sizeof(const char*), _Alignof(const char*));
+    uint64_t*                       pNameHash = atom_frame_alloc(count * sizeof(uint64_t), _Alignof(uint64_t));
+    for (uint32_t i = 0; i < count; i++) { pNames[i] = datas[i].name ? datas[i].name : ""; }
+    agpu_name_hash_batch(pNames, count, pNameHash);
     bool dirty = false;
     for (uint32_t i = 0; i < count; i++) {
         // Descriptor Info
         const AGPUDescriptorData* pParam  = datas + i;
         const AGPUShaderResource* ResData = ATOM_NULLPTR;
         if (pParam->name != ATOM_NULLPTR) {
-            size_t argNameHash = agpu_name_hash(pParam->name, strlen(pParam->name));
+            const uint64_t argNameHash = pNameHash[i];
             for (uint32_t p = 0; p < ParamTable->resources_count; p++) {
                 if (ParamTable->resources[p].name_hash == argNameHash) { ResData = ParamTable->resources + p; }
             }
@@ -612,6 +628,7 @@ void agpu_update_descriptor_set_vulkan(AGPUDescriptorSetIter set, const struct A
             default: atom_assert(0 && ResData->type && "Descriptor Type not supported!"); break;
         }
     }
+    atom_frame_arena_rewind(Scratch);
     if (dirty) {
         D->mVkDeviceTable.vkUpdateDescriptorSetWithTemplateKHR(D->pVkDevice,
                                                                Set->pVkDescriptorSet,
@@ -625,14 +642,13 @@ void agpu_free_descriptor_set_vulkan(AGPUDescriptorSetIter set)
     VulkanDescriptorSet* Set = (VulkanDescriptorSet*)set;
     VulkanDevice*        D   = (VulkanDevice*)set->pipeline_layout->device;
     vulkan_fetch_descriptor_sets(D->pDescriptorPool, &Set->pVkDescriptorSet, 1);
-    atom_free_aligned(Set);
+    atom_free_alignedN(Set, _Alignof(VulkanDescriptorSet), kVkDescriptorSetMemoryPoolName);
 }
 
-AGPUComputePipelineIter agpu_create_compute_pipeline_vulkan(AGPUDeviceIter                              device,
-                                                            const struct AGPUComputePipelineDescriptor* desc)
+static VkResult vulkan_compile_compute_pipeline(VulkanDevice*                               D,
+                                                const struct AGPUComputePipelineDescriptor* desc,
+                                                VulkanComputePipeline*                      PPL)
 {
-    VulkanDevice*                   D             = (VulkanDevice*)device;
-    VulkanComputePipeline*          PPL           = (VulkanComputePipeline*)atom_calloc(1, sizeof(VulkanComputePipeline));
     VulkanPipelineLayout*           PL            = (VulkanPipelineLayout*)desc->pipeline_layout;
     VulkanShaderLibrary*            SL            = (VulkanShaderLibrary*)desc->compute_shader->library;
     VkPipelineShaderStageCreateInfo cs_stage_info = {.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -649,44 +665,147 @@ AGPUComputePipelineIter agpu_create_compute_pipeline_vulkan(AGPUDeviceIter
                                                      .layout             = PL->pPipelineLayout,
                                                      .basePipelineHandle = 0,
                                                      .basePipelineIndex  = 0};
-    CHECK_VKRESULT(D->mVkDeviceTable.vkCreateComputePipelines(D->pVkDevice,
-                                                              D->pPipelineCache,
-                                                              1,
-                                                              &pipeline_info,
-                                                              GLOBAL_VkAllocationCallbacks,
-                                                              &PPL->pVkPipeline));
+
+    const VkResult result = D->mVkDeviceTable.vkCreateComputePipelines(D->pVkDevice,
+                                                                       D->pPipelineCache,
+                                                                       1,
+                                                                       &pipeline_info,
+                                                                       GLOBAL_VkAllocationCallbacks,
+                                                                       &PPL->pVkPipeline);
+    if (result == VK_SUCCESS) vulkan_pipeline_cache_on_pipeline_created(D);
+    return result;
+}
+
+AGPUComputePipelineIter agpu_create_compute_pipeline_vulkan(AGPUDeviceIter                              device,
+                                                            const struct AGPUComputePipelineDescriptor* desc)
+{
+    VulkanDevice*          D   = (VulkanDevice*)device;
+    VulkanComputePipeline* PPL = (VulkanComputePipeline*)atom_calloc(1, sizeof(VulkanComputePipeline));
+    CHECK_VKRESULT(vulkan_compile_compute_pipeline(D, desc, PPL));
     return &PPL->super;
 }
 
+// Async Pipelines
+// the job owns a copy of the descriptor, shader entries point into the storage that follows the job struct
+static size_t vulkan_shader_entry_storage_size(const AGPUShaderEntryDescriptor* entry)
+{
+    if (!entry) return 0;
+    const size_t name_size = strlen((const char*)entry->entry) + 1;
+    return entry->num_constants * sizeof(AGPUConstantSpecialization)
+           + (name_size + _Alignof(AGPUConstantSpecialization) - 1) / _Alignof(AGPUConstantSpecialization)
+                 * _Alignof(AGPUConstantSpecialization);
+}
+
+static const AGPUShaderEntryDescriptor* vulkan_copy_shader_entry(AGPUShaderEntryDescriptor*       dst,
+                                                                 const AGPUShaderEntryDescriptor* src,
+                                                                 uint8_t**                        storage)
+{
+    if (!src) return ATOM_NULLPTR;
+    *dst = *src;
+    if (src->num_constants) {
+        memcpy(*storage, src->constants, src->num_constants * sizeof(AGPUConstantSpecialization));
+        dst->constants = (const AGPUConstantSpecialization*)*storage;
+    }
+    char8_t* name = (char8_t*)(*storage + src->num_constants * sizeof(AGPUConstantSpecialization));
+    strcpy((char*)name, (const char*)src->entry);
+    dst->entry  = name;
+    *storage   += vulkan_shader_entry_storage_size(src);
+    return dst;
+}
+
+// ready and failed are published before the counter drops, so waiting on the counter and then reading the status is safe
+static void vulkan_publish_pipeline_status(_Atomic(uint32_t)* status, VkResult result, const char* kind)
+{
+    if (result != VK_SUCCESS)
+        ATOM_error((const char8_t*)"AGPU VULKAN: Failed to compile %s pipeline! Error Code: %d", kind, result);
+    const eAGPUPipelineStatus published = result == VK_SUCCESS ? AGPU_PIPELINE_STATUS_READY : AGPU_PIPELINE_STATUS_FAILED;
+    atomic_store_explicit(status, published, memory_order_release);
+}
+
+typedef struct VulkanComputePipelineCompileJob {
+    VulkanDevice*                 D;
+    VulkanComputePipeline*        PPL;
+    AGPUComputePipelineDescriptor desc;
+    AGPUShaderEntryDescriptor     compute_shader;
+} VulkanComputePipelineCompileJob;
+
+static void vulkan_compile_compute_pipeline_job(void* user_data)
+{
+    VulkanComputePipelineCompileJob* Job    = (VulkanComputePipelineCompileJob*)user_data;
+    const VkResult                   result = vulkan_compile_compute_pipeline(Job->D, &Job->desc, Job->PPL);
+    vulkan_publish_pipeline_status(&Job->PPL->super.status, result, "compute");
+    atom_free(Job);
+}
+
+AGPUComputePipelineIter agpu_create_compute_pipeline_async_vulkan(AGPUDeviceIter                              device,
+                                                                  const struct AGPUComputePipelineDescriptor* desc)
+{
+    VulkanDevice*                    D   = (VulkanDevice*)device;
+    VulkanComputePipeline*           PPL = (VulkanComputePipeline*)atom_calloc(1, sizeof(VulkanComputePipeline));
+    VulkanComputePipelineCompileJob* Job = (VulkanComputePipelineCompileJob*)atom_malloc(
+        sizeof(VulkanComputePipelineCompileJob) + vulkan_shader_entry_storage_size(desc->compute_shader));
+    uint8_t* storage         = (uint8_t*)(Job + 1);
+    Job->D                   = D;
+    Job->PPL                 = PPL;
+    Job->desc                = *desc;
+    Job->desc.compute_shader = (AGPUShaderEntryDescriptor*)vulkan_copy_shader_entry(&Job->compute_shader,
+                                                                                    desc->compute_shader,
+                                                                                    &storage);
+    atomic_init(&PPL->super.status, AGPU_PIPELINE_STATUS_PENDING);
+    PPL->pCompileCounter = atom_create_job_counter();
+    const atom_job_decl_t job = {.function  = &vulkan_compile_compute_pipeline_job,
+                                 .user_data = Job,
+                                 .affinity  = ATOM_JOB_AFFINITY_ANY,
+                                 .pinned    = false};
+    atom_job_run(&job, 1, PPL->pCompileCounter);
+    return &PPL->super;
+}
+
+void agpu_wait_compute_pipeline_vulkan(AGPUComputePipelineIter pipeline)
+{
+    VulkanComputePipeline* PPL = (VulkanComputePipeline*)pipeline;
+    if (PPL->pCompileCounter) atom_job_wait(PPL->pCompileCounter);
+}
+
 void agpu_free_compute_pipeline_vulkan(AGPUComputePipelineIter pipeline)
 {
     VulkanComputePipeline* PPL = (VulkanComputePipeline*)pipeline;
     VulkanDevice*          D   = (VulkanDevice*)pipeline->device;
+    if (PPL->pCompileCounter) {
+        atom_job_wait(PPL->pCompileCounter);
+        atom_free_job_counter(PPL->pCompileCounter);
+    }
     D->mVkDeviceTable.vkDestroyPipeline(D->pVkDevice, PPL->pVkPipeline, GLOBAL_VkAllocationCallbacks);
     atom_free(PPL);
 }
 
 /* clang-format off */
 static const char* kVkPSOMemoryPoolName = "AGPU::vk_pso";
-AGPURenderPipelineIter agpu_create_render_pipeline_vulkan(AGPUDeviceIter device, const struct AGPURenderPipelineDescriptor* desc)
+// the vertex input descriptions live right behind the pipeline
+static VulkanRenderPipeline* vulkan_alloc_render_pipeline(const struct AGPURenderPipelineDescriptor* desc)
 {
-    VulkanDevice* D = (VulkanDevice*)device;
-    VulkanAdapter* A = (VulkanAdapter*)device->adapter;
-    VulkanPipelineLayout* PL = (VulkanPipelineLayout*)desc->pipeline_layout;
-    
     uint32_t input_binding_count = 0;
 	uint32_t input_attribute_count = 0;
     vulkan_get_vertex_input_binding_attribute_count(desc->vertex_layout, &input_binding_count, &input_attribute_count);
     uint64_t dsize = sizeof(VulkanRenderPipeline);
-    const uint64_t input_elements_offset = dsize;
     dsize += (sizeof(VkVertexInputBindingDescription) * input_binding_count);
-    const uint64_t input_attrs_offset = dsize;
     dsize += (sizeof(VkVertexInputAttributeDescription) * input_attribute_count);
+    return (VulkanRenderPipeline*)atom_callocN(1, dsize, kVkPSOMemoryPoolName);
+}
 
-    uint8_t* ptr = (uint8_t*)atom_callocN(1, dsize, kVkPSOMemoryPoolName);
-    VulkanRenderPipeline* RP = (VulkanRenderPipeline*)ptr;
-    VkVertexInputBindingDescription* input_bindings = (VkVertexInputBindingDescription*)(ptr + input_elements_offset);
-    VkVertexInputAttributeDescription* input_attributes = (VkVertexInputAttributeDescription*)(ptr + input_attrs_offset);
+// off the recording thread the stub render pass is created for this call alone, D->pPassTable is not thread safe
+static VkResult vulkan_compile_render_pipeline(VulkanDevice* D, const struct AGPURenderPipelineDescriptor* desc,
+                                               VulkanRenderPipeline* RP, bool private_render_pass)
+{
+    VulkanAdapter* A = (VulkanAdapter*)D->super.adapter;
+    VulkanPipelineLayout* PL = (VulkanPipelineLayout*)desc->pipeline_layout;
+    
+    uint32_t input_binding_count = 0;
+	uint32_t input_attribute_count = 0;
+    vulkan_get_vertex_input_binding_attribute_count(desc->vertex_layout, &input_binding_count, &input_attribute_count);
+    VkVertexInputBindingDescription* input_bindings = (VkVertexInputBindingDescription*)(RP + 1);
+    VkVertexInputAttributeDescription* input_attributes =
+        (VkVertexInputAttributeDescription*)(input_bindings + input_binding_count);
     // Vertex input state
     if (desc->vertex_layout != NULL)
     {
@@ -935,27 +1054,56 @@ AGPURenderPipelineIter agpu_create_render_pipeline_vulkan(AGPUDeviceIter device,
         .blendConstants[2] = 0.0f,
         .blendConstants[3] = 0.0f
     };
-    // Create a stub render pass
+    // Attachment formats go straight into the pipeline with dynamic rendering, otherwise through a stub render pass
     VkRenderPass render_pass = VK_NULL_HANDLE;
     atom_assert(desc->render_target_count >= 0);
-    VulkanRenderPassDescriptor rp_desc = {
-        .mColorAttachmentCount = desc->render_target_count,
-        .mSampleCount = desc->sample_count,
-        .mDepthStencilFormat = desc->depth_stencil_format
+#if VK_KHR_dynamic_rendering
+    VkFormat color_formats[AGPU_MAX_MRT_COUNT] = {0};
+    VkPipelineRenderingCreateInfoKHR rendering_info = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+        .pNext = NULL,
+        .viewMask = 0,
+        .colorAttachmentCount = desc->render_target_count,
+        .pColorAttachmentFormats = color_formats,
+        .depthAttachmentFormat = VK_FORMAT_UNDEFINED,
+        .stencilAttachmentFormat = VK_FORMAT_UNDEFINED
     };
-    for (uint32_t i = 0; i < desc->render_target_count; i++)
+    if (D->mDynamicRendering)
     {
-        rp_desc.pColorFormats[i] = desc->color_formats[i];
-        if(desc->color_resolve_disable_mask & (AGPU_SLOT_0 << i))
+        for (uint32_t i = 0; i < desc->render_target_count; i++)
+            color_formats[i] = vulkan_agpu_format_to_vk(desc->color_formats[i]);
+        if (desc->depth_stencil_format != AGPU_FORMAT_UNDEFINED)
         {
-            rp_desc.pResolveMasks[i] = false;
+            rendering_info.depthAttachmentFormat = vulkan_agpu_format_to_vk(desc->depth_stencil_format);
+            if (vulkan_format_has_stencil(desc->depth_stencil_format))
+                rendering_info.stencilAttachmentFormat = rendering_info.depthAttachmentFormat;
         }
-        else if(rp_desc.mSampleCount != AGPU_SAMPLE_COUNT_1)
+    }
+    else
+#endif
+    {
+        VulkanRenderPassDescriptor rp_desc = {
+            .mColorAttachmentCount = desc->render_target_count,
+            .mSampleCount = desc->sample_count,
+            .mDepthStencilFormat = desc->depth_stencil_format
+        };
+        for (uint32_t i = 0; i < desc->render_target_count; i++)
         {
-            rp_desc.pResolveMasks[i] = true;
+            rp_desc.pColorFormats[i] = desc->color_formats[i];
+            if(desc->color_resolve_disable_mask & (AGPU_SLOT_0 << i))
+            {
+                rp_desc.pResolveMasks[i] = false;
+            }
+            else if(rp_desc.mSampleCount != AGPU_SAMPLE_COUNT_1)
+            {
+                rp_desc.pResolveMasks[i] = true;
+            }
         }
+        if (private_render_pass)
+            vulkan_create_render_pass(D, &rp_desc, &render_pass);
+        else
+            vulkan_find_or_create_render_pass(D, &rp_desc, &render_pass);
     }
-    vulkan_find_or_create_render_pass(D, &rp_desc, &render_pass);
     VkGraphicsPipelineCreateInfo pipelineInfo = {
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
         .stageCount = stage_count,
@@ -973,9 +1121,24 @@ AGPURenderPipelineIter agpu_create_render_pipeline_vulkan(AGPUDeviceIter device,
         .subpass = 0,
         .basePipelineHandle = VK_NULL_HANDLE,
     };
+#if VK_KHR_dynamic_rendering
+    if (D->mDynamicRendering) pipelineInfo.pNext = &rendering_info;
+#endif
     VkResult createResult = D->mVkDeviceTable.vkCreateGraphicsPipelines(D->pVkDevice,
         D->pPipelineCache, 1, &pipelineInfo, GLOBAL_VkAllocationCallbacks, &RP->pVkPipeline);
     atom_freeN(dyn_states, kVkPSOMemoryPoolName);
+    if (private_render_pass && render_pass != VK_NULL_HANDLE)
+        D->mVkDeviceTable.vkDestroyRenderPass(D->pVkDevice, render_pass, GLOBAL_VkAllocationCallbacks);
+    if (createResult == VK_SUCCESS)
+        vulkan_pipeline_cache_on_pipeline_created(D);
+    return createResult;
+}
+
+AGPURenderPipelineIter agpu_create_render_pipeline_vulkan(AGPUDeviceIter device, const struct AGPURenderPipelineDescriptor* desc)
+{
+    VulkanDevice* D = (VulkanDevice*)device;
+    VulkanRenderPipeline* RP = vulkan_alloc_render_pipeline(desc);
+    VkResult createResult = vulkan_compile_render_pipeline(D, desc, RP, false);
     if (createResult != VK_SUCCESS)
     {
         ATOM_fatal("AGPU VULKAN: Failed to create Graphics Pipeline! Error Code: %d", createResult);
@@ -985,20 +1148,99 @@ AGPURenderPipelineIter agpu_create_render_pipeline_vulkan(AGPUDeviceIter device,
 
 /* clang-format on */
 
+typedef struct VulkanRenderPipelineCompileJob {
+    VulkanDevice*                 D;
+    VulkanRenderPipeline*         RP;
+    AGPURenderPipelineDescriptor  desc;
+    AGPUShaderEntryDescriptor     shaders[5];
+    AGPUVertexLayout              vertex_layout;
+    AGPUBlendStateDescriptor      blend_state;
+    AGPUDepthStateDescriptor      depth_state;
+    AGPURasterizerStateDescriptor rasterizer_state;
+    eAGPUFormat                   color_formats[AGPU_MAX_MRT_COUNT];
+} VulkanRenderPipelineCompileJob;
+
+static void vulkan_compile_render_pipeline_job(void* user_data)
+{
+    VulkanRenderPipelineCompileJob* Job    = (VulkanRenderPipelineCompileJob*)user_data;
+    const VkResult                  result = vulkan_compile_render_pipeline(Job->D, &Job->desc, Job->RP, true);
+    vulkan_publish_pipeline_status(&Job->RP->super.status, result, "graphics");
+    atom_free(Job);
+}
+
+AGPURenderPipelineIter agpu_create_render_pipeline_async_vulkan(AGPUDeviceIter                             device,
+                                                                const struct AGPURenderPipelineDescriptor* desc)
+{
+    VulkanDevice*                    D          = (VulkanDevice*)device;
+    VulkanRenderPipeline*            RP         = vulkan_alloc_render_pipeline(desc);
+    const AGPUShaderEntryDescriptor* shaders[5] = {desc->vertex_shader,
+                                                   desc->tesc_shader,
+                                                   desc->tese_shader,
+                                                   desc->geom_shader,
+                                                   desc->fragment_shader};
+    size_t                           job_size   = sizeof(VulkanRenderPipelineCompileJob);
+    for (uint32_t i = 0; i < 5; i++) job_size += vulkan_shader_entry_storage_size(shaders[i]);
+    VulkanRenderPipelineCompileJob* Job     = (VulkanRenderPipelineCompileJob*)atom_malloc(job_size);
+    uint8_t*                        storage = (uint8_t*)(Job + 1);
+    Job->D                                  = D;
+    Job->RP                                 = RP;
+    Job->desc                               = *desc;
+    Job->desc.vertex_shader                 = vulkan_copy_shader_entry(&Job->shaders[0], shaders[0], &storage);
+    Job->desc.tesc_shader                   = vulkan_copy_shader_entry(&Job->shaders[1], shaders[1], &storage);
+    Job->desc.tese_shader                   = vulkan_copy_shader_entry(&Job->shaders[2], shaders[2], &storage);
+    Job->desc.geom_shader                   = vulkan_copy_shader_entry(&Job->shaders[3], shaders[3], &storage);
+    Job->desc.fragment_shader               = vulkan_copy_shader_entry(&Job->shaders[4], shaders[4], &storage);
+    if (desc->vertex_layout) {
+        Job->vertex_layout      = *desc->vertex_layout;
+        Job->desc.vertex_layout = &Job->vertex_layout;
+    }
+    // the common layer filled in defaults, these are never NULL
+    Job->blend_state           = *desc->blend_state;
+    Job->depth_state           = *desc->depth_state;
+    Job->rasterizer_state      = *desc->rasterizer_state;
+    Job->desc.blend_state      = &Job->blend_state;
+    Job->desc.depth_state      = &Job->depth_state;
+    Job->desc.rasterizer_state = &Job->rasterizer_state;
+    atom_assert(desc->render_target_count <= AGPU_MAX_MRT_COUNT);
+    if (desc->render_target_count)
+        memcpy(Job->color_formats, desc->color_formats, desc->render_target_count * sizeof(eAGPUFormat));
+    Job->desc.color_formats = Job->color_formats;
+    atomic_init(&RP->super.status, AGPU_PIPELINE_STATUS_PENDING);
+    RP->pCompileCounter       = atom_create_job_counter();
+    const atom_job_decl_t job = {.function  = &vulkan_compile_render_pipeline_job,
+                                 .user_data = Job,
+                                 .affinity  = ATOM_JOB_AFFINITY_ANY,
+                                 .pinned    = false};
+    atom_job_run(&job, 1, RP->pCompileCounter);
+    return &RP->super;
+}
+
+void agpu_wait_render_pipeline_vulkan(AGPURenderPipelineIter pipeline)
+{
+    VulkanRenderPipeline* RP = (VulkanRenderPipeline*)pipeline;
+    if (RP->pCompileCounter) atom_job_wait(RP->pCompileCounter);
+}
+
 void agpu_free_render_pipeline_vulkan(AGPURenderPipelineIter pipeline)
 {
     VulkanDevice*         D  = (VulkanDevice*)pipeline->device;
     VulkanRenderPipeline* RP = (VulkanRenderPipeline*)pipeline;
+    if (RP->pCompileCounter) {
+        atom_job_wait(RP->pCompileCounter);
+        atom_free_job_counter(RP->pCompileCounter);
+    }
     D->mVkDeviceTable.vkDestroyPipeline(D->pVkDevice, RP->pVkPipeline, GLOBAL_VkAllocationCallbacks);
     atom_freeN(RP, kVkPSOMemoryPoolName);
 }
 
 AGPUQueryPoolIter agpu_create_query_pool_vulkan(AGPUDeviceIter device, const struct AGPUQueryPoolDescriptor* desc)
 {
-    VulkanDevice*    D = (VulkanDevice*)device;
-    VulkanQueryPool* P = (VulkanQueryPool*)atom_calloc(1, sizeof(VulkanQueryPool));
-    P->mType           = vulkan_agpu_query_type_to_vk(desc->type);
-    P->super.count     = desc->query_count;
+    VulkanDevice*    D    = (VulkanDevice*)device;
+    VulkanQueryPool* P    = (VulkanQueryPool*)atom_calloc(1, sizeof(VulkanQueryPool));
+    P->mType              = vulkan_agpu_query_type_to_vk(desc->type);
+    P->super.count        = desc->query_count;
+    P->super.type         = desc->type;
+    P->super.result_count = 1;
     ATOM_DECLARE_ZERO(VkQueryPoolCreateInfo, createInfo)
     createInfo.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
     createInfo.pNext              = NULL;
@@ -1006,6 +1248,14 @@ AGPUQueryPoolIter agpu_create_query_pool_vulkan(AGPUDeviceIter device, const str
     createInfo.queryType          = P->mType;
     createInfo.flags              = 0;
     createInfo.pipelineStatistics = 0;
+    if (desc->type == AGPU_QUERY_TYPE_PIPELINE_STATISTICS) {
+        atom_assert(desc->pipeline_statistics && "pipeline statistics query pool without statistics!");
+        // eAGPUPipelineStatistic mirrors the vulkan bits
+        createInfo.pipelineStatistics = (VkQueryPipelineStatisticFlags)desc->pipeline_statistics;
+        P->super.result_count         = 0;
+        for (AGPUPipelineStatistics bits = desc->pipeline_statistics; bits; bits &= bits - 1) P->super.result_count++;
+    }
+    if (desc->type == AGPU_QUERY_TYPE_OCCLUSION && desc->precise_occlusion) P->mControlFlags = VK_QUERY_CONTROL_PRECISE_BIT;
     CHECK_VKRESULT(
         D->mVkDeviceTable.vkCreateQueryPool(D->pVkDevice, &createInfo, GLOBAL_VkAllocationCallbacks, &P->pVkQueryPool));
     return &P->super;
@@ -1076,11 +1326,14 @@ void agpu_submit_queue_vulkan(AGPUQueueIter queue, const struct AGPUQueueSubmitD
     // execute given command list
     atom_assert(Q->pVkQueue != VK_NULL_HANDLE);
 
-    ATOM_DECLARE_ZERO_VLA(VkCommandBuffer, vkCmds, CmdCount);
+    const atom_frame_arena_marker_t Scratch = atom_frame_arena_mark();
+    VkCommandBuffer* vkCmds = atom_frame_calloc(CmdCount, sizeof(VkCommandBuffer), _Alignof(VkCommandBuffer));
     for (uint32_t i = 0; i < CmdCount; ++i) { vkCmds[i] = Cmds[i]->pVkCmdBuf; }
     // Set wait semaphores
-    ATOM_DECLARE_ZERO_VLA(VkSemaphore, wait_semaphores, desc->wait_semaphore_count + 1)
-    ATOM_DECLARE_ZERO_VLA(VkPipelineStageFlags, wait_stages, desc->wait_semaphore_count + 1)
+    VkSemaphore* wait_semaphores =
+        atom_frame_calloc(desc->wait_semaphore_count + 1, sizeof(VkSemaphore), _Alignof(VkSemaphore));
+    VkPipelineStageFlags* wait_stages =
+        atom_frame_calloc(desc->wait_semaphore_count + 1, sizeof(VkPipelineStageFlags), _Alignof(VkPipelineStageFlags));
     uint32_t          waitCount      = 0;
     VulkanSemaphore** WaitSemaphores = (VulkanSemaphore**)desc->wait_semaphores;
     for (uint32_t i = 0; i < desc->wait_semaphore_count; ++i) {
@@ -1093,7 +1346,8 @@ void agpu_submit_queue_vulkan(AGPUQueueIter queue, const struct AGPUQueueSubmitD
         }
     }
     // Set signal semaphores
-    ATOM_DECLARE_ZERO_VLA(VkSemaphore, signal_semaphores, desc->signal_semaphore_count + 1)
+    VkSemaphore* signal_semaphores =
+        atom_frame_calloc(desc->signal_semaphore_count + 1, sizeof(VkSemaphore), _Alignof(VkSemaphore));
     uint32_t          signalCount      = 0;
     VulkanSemaphore** SignalSemaphores = (VulkanSemaphore**)desc->signal_semaphores;
     for (uint32_t i = 0; i < desc->signal_semaphore_count; ++i) {
@@ -1127,10 +1381,14 @@ void agpu_submit_queue_vulkan(AGPUQueueIter queue, const struct AGPUQueueSubmitD
             atom_assert("Unhandled VK ERROR!");
         }
     };
-    if (F) F->mSubmitted = true;
+    if (F) {
+        F->mSubmitted  = true;
+        F->mFrameIndex = atom_frame_arena_current_frame();
+    }
 #ifdef AGPU_THREAD_SAFETY
     if (Q->pMutex) mtx_unlock(Q->pMutex);
 #endif
+    atom_frame_arena_rewind(Scratch);
 }
 
 void agpu_wait_queue_idle_vulkan(AGPUQueueIter queue)
@@ -1147,7 +1405,9 @@ void agpu_queue_present_vulkan(AGPUQueueIter queue, const struct AGPUQueuePresen
     VulkanQueue*     Q  = (VulkanQueue*)queue;
     if (SC) {
         // Set semaphores
-        ATOM_DECLARE_ZERO_VLA(VkSemaphore, wait_semaphores, desc->wait_semaphore_count + 1)
+        const atom_frame_arena_marker_t Scratch = atom_frame_arena_mark();
+        VkSemaphore*                    wait_semaphores =
+            atom_frame_calloc(desc->wait_semaphore_count + 1, sizeof(VkSemaphore), _Alignof(VkSemaphore));
         uint32_t          waitCount  = 0;
         VulkanSemaphore** Semaphores = (VulkanSemaphore**)desc->wait_semaphores;
         for (uint32_t i = 0; i < desc->wait_semaphore_count; ++i) {
@@ -1177,6 +1437,7 @@ void agpu_queue_present_vulkan(AGPUQueueIter queue, const struct AGPUQueuePresen
         if (vk_res != VK_SUCCESS && vk_res != VK_SUBOPTIMAL_KHR && vk_res != VK_ERROR_OUT_OF_DATE_KHR) {
             atom_assert(0 && "Present failed!");
         }
+        atom_frame_arena_rewind(Scratch);
     }
 }
 
@@ -1237,8 +1498,7 @@ AGPUCommandBufferIter agpu_create_command_buffer_vulkan(AGPUCommandPoolIter
     VulkanCommandPool*   P = (VulkanCommandPool*)pool;
     VulkanQueue*         Q = (VulkanQueue*)P->super.queue;
     VulkanDevice*        D = (VulkanDevice*)Q->super.device;
-    VulkanCommandBuffer* Cmd =
-        (VulkanCommandBuffer*)atom_calloc_aligned(1, sizeof(VulkanCommandBuffer), _Alignof(VulkanCommandBuffer));
+    VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_COMMAND_BUFFER]);
     atom_assert(Cmd);
 
     Cmd->mType      = Q->super.type;
@@ -1268,7 +1528,7 @@ void agpu_free_command_buffer_vulkan(AGPUCommandBufferIter cmd)
     VulkanQueue*         Q   = (VulkanQueue*)P->super.queue;
     VulkanDevice*        D   = (VulkanDevice*)Q->super.device;
     D->mVkDeviceTable.vkFreeCommandBuffers(D->pVkDevice, P->pVkCmdPool, 1, &(Cmd->pVkCmdBuf));
-    atom_free_aligned(Cmd);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_COMMAND_BUFFER], Cmd);
 }
 
 void agpu_free_command_pool_vulkan(AGPUCommandPoolIter pool)
@@ -1300,7 +1560,10 @@ void agpu_cmd_resource_barrier_vulkan(AGPUCommandBufferIter cmd, const struct AG
     VkAccessFlags        srcAccessFlags = 0;
     VkAccessFlags        dstAccessFlags = 0;
 
-    ATOM_DECLARE_ZERO_VLA(VkBufferMemoryBarrier, BBs, desc->buffer_barriers_count)
+    // barrier batches can be large, keep them off the stack
+    const atom_frame_arena_marker_t Scratch = atom_frame_arena_mark();
+    VkBufferMemoryBarrier*          BBs =
+        atom_frame_calloc(desc->buffer_barriers_count, sizeof(VkBufferMemoryBarrier), _Alignof(VkBufferMemoryBarrier));
     uint32_t bufferBarrierCount = 0;
     for (uint32_t i = 0; i < desc->buffer_barriers_count; i++) {
         const AGPUBufferBarrier* buffer_barrier = &desc->buffer_barriers[i];
@@ -1344,7 +1607,8 @@ void agpu_cmd_resource_barrier_vulkan(AGPUCommandBufferIter cmd, const struct AG
         }
     }
 
-    ATOM_DECLARE_ZERO_VLA(VkImageMemoryBarrier, TBs, desc->texture_barriers_count)
+    VkImageMemoryBarrier* TBs =
+        atom_frame_calloc(desc->texture_barriers_count, sizeof(VkImageMemoryBarrier), _Alignof(VkImageMemoryBarrier));
     uint32_t imageBarrierCount = 0;
     for (uint32_t i = 0; i < desc->texture_barriers_count; i++) {
         const AGPUTextureBarrier* texture_barrier = &desc->texture_barriers[i];
@@ -1413,6 +1677,7 @@ void agpu_cmd_resource_barrier_vulkan(AGPUCommandBufferIter cmd, const struct AG
                                                imageBarrierCount,
                                                TBs);
     }
+    atom_frame_arena_rewind(Scratch);
 }
 
 void agpu_cmd_begin_query_vulkan(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, const struct AGPUQueryDescriptor* desc)
@@ -1427,9 +1692,11 @@ void agpu_cmd_begin_query_vulkan(AGPUCommandBufferIter cmd, AGPUQueryPoolIter po
                                                   P->pVkQueryPool,
                                                   desc->index);
             break;
-        case VK_QUERY_TYPE_PIPELINE_STATISTICS: break;
-        case VK_QUERY_TYPE_OCCLUSION:           break;
-        default:                                break;
+        case VK_QUERY_TYPE_PIPELINE_STATISTICS:
+        case VK_QUERY_TYPE_OCCLUSION:
+            D->mVkDeviceTable.vkCmdBeginQuery(Cmd->pVkCmdBuf, P->pVkQueryPool, desc->index, P->mControlFlags);
+            break;
+        default: break;
     }
 }
 
@@ -1446,7 +1713,15 @@ void agpu_cmd_reset_query_pool_vulkan(AGPUCommandBufferIter cmd,
 
 void agpu_cmd_end_query_vulkan(AGPUCommandBufferIter cmd, AGPUQueryPoolIter pool, const struct AGPUQueryDescriptor* desc)
 {
-    agpu_cmd_begin_query(cmd, pool, desc);
+    VulkanDevice*        D   = (VulkanDevice*)cmd->device;
+    VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)cmd;
+    VulkanQueryPool*     P   = (VulkanQueryPool*)pool;
+    // a timestamp is a single write, ending it writes the second one
+    if (P->mType == VK_QUERY_TYPE_TIMESTAMP) {
+        agpu_cmd_begin_query_vulkan(cmd, pool, desc);
+    } else {
+        D->mVkDeviceTable.vkCmdEndQuery(Cmd->pVkCmdBuf, P->pVkQueryPool, desc->index);
+    }
 }
 
 void agpu_cmd_resolve_query_vulkan(AGPUCommandBufferIter cmd,
@@ -1471,7 +1746,7 @@ void agpu_cmd_resolve_query_vulkan(AGPUCommandBufferIter cmd,
                                                 query_count,
                                                 B->pVkBuffer,
                                                 0,
-                                                sizeof(uint64_t),
+                                                sizeof(uint64_t) * pool->result_count,
                                                 flags);
 }
 
@@ -1550,7 +1825,8 @@ void agpu_cmd_end_event_vulkan(AGPUCommandBufferIter cmd)
 AGPUComputePassEncoderIter agpu_cmd_begin_compute_pass_vulkan(AGPUCommandBufferIter                   cmd,
                                                               const struct AGPUComputePassDescriptor* desc)
 {
-    // DO NOTHING NOW
+    VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)cmd;
+    Cmd->mSkipDraws          = 0;
     return (AGPUComputePassEncoderIter)cmd;
 }
 
@@ -1644,7 +1920,9 @@ void agpu_compute_encoder_bind_pipeline_vulkan(AGPUComputePassEncoderIter encode
 {
     VulkanCommandBuffer*   Cmd = (VulkanCommandBuffer*)encoder;
     VulkanComputePipeline* PPL = (VulkanComputePipeline*)pipeline;
-    const VulkanDevice*    D   = (VulkanDevice*)pipeline->device;
+    const VulkanDevice*    D   = (VulkanDevice*)encoder->device;
+    Cmd->mSkipDraws            = PPL == ATOM_NULLPTR;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdBindPipeline(Cmd->pVkCmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, PPL->pVkPipeline);
 }
 
@@ -1652,6 +1930,7 @@ void agpu_compute_encoder_dispatch_vulkan(AGPUComputePassEncoderIter encoder, ui
 {
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)encoder;
     const VulkanDevice*  D   = (VulkanDevice*)Cmd->super.device;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdDispatch(Cmd->pVkCmdBuf, X, Y, Z);
 }
 
@@ -1661,11 +1940,120 @@ void agpu_cmd_end_compute_pass_vulkan(AGPUCommandBufferIter cmd, AGPUComputePass
 }
 
 // Render CMDs
+#if VK_KHR_dynamic_rendering
+// begins straight from the descriptor without render pass or framebuffer lookups. color and depth attachments are
+// expected in their attachment layouts as on the render pass path. resolve targets are moved from UNDEFINED like the
+// render pass path does with their initialLayout, their previous contents are discarded either way
+static AGPURenderPassEncoderIter vulkan_cmd_begin_rendering(VulkanCommandBuffer*                   Cmd,
+                                                            const VulkanDevice*                    D,
+                                                            const struct AGPURenderPassDescriptor* desc)
+{
+    VkRenderingAttachmentInfoKHR        color_attachments[AGPU_MAX_MRT_COUNT] = {0};
+    VkRenderingAttachmentInfoKHR        depth_attachment                      = {0};
+    VkRenderingAttachmentInfoKHR        stencil_attachment                    = {0};
+    const VkRenderingAttachmentInfoKHR* pDepthAttachment                      = NULL;
+    const VkRenderingAttachmentInfoKHR* pStencilAttachment                    = NULL;
+    VkImageMemoryBarrier                resolve_barriers[AGPU_MAX_MRT_COUNT]  = {0};
+    uint32_t                            resolve_barrier_count                 = 0;
+    uint32_t                            Width = 0, Height = 0, Layers = 1;
+    for (uint32_t i = 0; i < desc->render_target_count; i++) {
+        const AGPUColorAttachment*    attachment  = &desc->color_attachments[i];
+        const VulkanTextureView*      TVV         = (const VulkanTextureView*)attachment->view;
+        const VulkanTextureView*      TVV_Resolve = (const VulkanTextureView*)attachment->resolve_view;
+        VkRenderingAttachmentInfoKHR* info        = &color_attachments[i];
+        info->sType                               = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        info->imageView                           = TVV->pVkRTVDSVDescriptor;
+        info->imageLayout                         = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        info->loadOp                              = gVkAttachmentLoadOpTranslator[attachment->load_action];
+        info->storeOp                             = gVkAttachmentStoreOpTranslator[attachment->store_action];
+        info->clearValue.color.float32[0]         = attachment->clear_color.r;
+        info->clearValue.color.float32[1]         = attachment->clear_color.g;
+        info->clearValue.color.float32[2]         = attachment->clear_color.b;
+        info->clearValue.color.float32[3]         = attachment->clear_color.a;
+        if (TVV_Resolve && (desc->sample_count != AGPU_SAMPLE_COUNT_1)) {
+            info->resolveMode        = VK_RESOLVE_MODE_AVERAGE_BIT;
+            info->resolveImageView   = TVV_Resolve->pVkRTVDSVDescriptor;
+            info->resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+            const AGPUTextureViewDescriptor* view_info = &TVV_Resolve->super.info;
+            VkImageMemoryBarrier*            barrier   = &resolve_barriers[resolve_barrier_count++];
+            barrier->sType                             = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier->srcAccessMask                     = 0;
+            barrier->dstAccessMask                     = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier->oldLayout                         = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier->newLayout                         = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier->srcQueueFamilyIndex               = VK_QUEUE_FAMILY_IGNORED;
+            barrier->dstQueueFamilyIndex               = VK_QUEUE_FAMILY_IGNORED;
+            barrier->image                             = ((const VulkanTexture*)view_info->texture)->pVkImage;
+            barrier->subresourceRange.aspectMask       = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier->subresourceRange.baseMipLevel     = view_info->base_mip_level;
+            barrier->subresourceRange.levelCount       = 1;
+            barrier->subresourceRange.baseArrayLayer   = view_info->base_array_layer;
+            barrier->subresourceRange.layerCount       = view_info->array_layer_count;
+        }
+        Width  = (uint32_t)attachment->view->info.texture->info->width;
+        Height = (uint32_t)attachment->view->info.texture->info->height;
+        Layers = TVV->super.info.array_layer_count;
+    }
+    if (desc->depth_stencil != ATOM_NULLPTR && desc->depth_stencil->view != ATOM_NULLPTR) {
+        const AGPUDepthStencilAttachment* attachment     = desc->depth_stencil;
+        const VulkanTextureView*          TVV            = (const VulkanTextureView*)attachment->view;
+        depth_attachment.sType                           = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        depth_attachment.imageView                       = TVV->pVkRTVDSVDescriptor;
+        depth_attachment.imageLayout                     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depth_attachment.loadOp                          = gVkAttachmentLoadOpTranslator[attachment->depth_load_action];
+        depth_attachment.storeOp                         = gVkAttachmentStoreOpTranslator[attachment->depth_store_action];
+        depth_attachment.clearValue.depthStencil.depth   = attachment->clear_depth;
+        depth_attachment.clearValue.depthStencil.stencil = attachment->clear_stencil;
+        pDepthAttachment                                 = &depth_attachment;
+        if (vulkan_format_has_stencil(attachment->view->info.format)) {
+            stencil_attachment         = depth_attachment;
+            stencil_attachment.loadOp  = gVkAttachmentLoadOpTranslator[attachment->stencil_load_action];
+            stencil_attachment.storeOp = gVkAttachmentStoreOpTranslator[attachment->stencil_store_action];
+            pStencilAttachment         = &stencil_attachment;
+        }
+        Width  = (uint32_t)attachment->view->info.texture->info->width;
+        Height = (uint32_t)attachment->view->info.texture->info->height;
+        Layers = TVV->super.info.array_layer_count;
+    }
+    if (desc->render_target_count) atom_assert(Layers == 1 && "MRT pass supports only one layer!");
+    VkRenderingInfoKHR rendering_info = {
+        .sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+        .pNext                = NULL,
+        .flags                = 0,
+        .renderArea           = {.offset.x = 0, .offset.y = 0, .extent.width = Width, .extent.height = Height},
+        .layerCount           = Layers,
+        .viewMask             = 0,
+        .colorAttachmentCount = desc->render_target_count,
+        .pColorAttachments    = color_attachments,
+        .pDepthAttachment     = pDepthAttachment,
+        .pStencilAttachment   = pStencilAttachment};
+    if (resolve_barrier_count) {
+        D->mVkDeviceTable.vkCmdPipelineBarrier(Cmd->pVkCmdBuf,
+                                               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                               0,
+                                               0,
+                                               NULL,
+                                               0,
+                                               NULL,
+                                               resolve_barrier_count,
+                                               resolve_barriers);
+    }
+    D->mVkDeviceTable.vkCmdBeginRenderingKHR(Cmd->pVkCmdBuf, &rendering_info);
+    return (AGPURenderPassEncoderIter)Cmd;
+}
+#endif
+
 AGPURenderPassEncoderIter agpu_cmd_begin_render_pass_vulkan(AGPUCommandBufferIter                  cmd,
                                                             const struct AGPURenderPassDescriptor* desc)
 {
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)cmd;
     const VulkanDevice*  D   = (VulkanDevice*)cmd->device;
+    Cmd->mSkipDraws          = 0;
+#if VK_KHR_dynamic_rendering
+    if (D->mDynamicRendering) return vulkan_cmd_begin_rendering(Cmd, D, desc);
+#endif
     // Find or create render pass
     uint32_t             Width, Height;
     VkRenderPass         render_pass = VK_NULL_HANDLE;
@@ -1798,7 +2186,9 @@ void agpu_render_encoder_bind_pipeline_vulkan(AGPURenderPassEncoderIter encoder,
 {
     VulkanCommandBuffer*  Cmd = (VulkanCommandBuffer*)encoder;
     VulkanRenderPipeline* PPL = (VulkanRenderPipeline*)pipeline;
-    const VulkanDevice*   D   = (VulkanDevice*)pipeline->device;
+    const VulkanDevice*   D   = (VulkanDevice*)encoder->device;
+    Cmd->mSkipDraws           = PPL == ATOM_NULLPTR;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdBindPipeline(Cmd->pVkCmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, PPL->pVkPipeline);
 }
 
@@ -1865,6 +2255,7 @@ void agpu_render_encoder_draw_vulkan(AGPURenderPassEncoderIter encoder, uint32_t
 {
     const VulkanDevice*  D   = (VulkanDevice*)encoder->device;
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)encoder;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdDraw(Cmd->pVkCmdBuf, vertex_count, 1, first_vertex, 0);
 }
 
@@ -1876,6 +2267,7 @@ void agpu_render_encoder_draw_instanced_vulkan(AGPURenderPassEncoderIter encoder
 {
     const VulkanDevice*  D   = (VulkanDevice*)encoder->device;
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)encoder;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdDraw(Cmd->pVkCmdBuf, vertex_count, instance_count, first_vertex, first_instance);
 }
 
@@ -1886,6 +2278,7 @@ void agpu_render_encoder_draw_indexed_vulkan(AGPURenderPassEncoderIter encoder,
 {
     const VulkanDevice*  D   = (VulkanDevice*)encoder->device;
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)encoder;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdDrawIndexed(Cmd->pVkCmdBuf, index_count, 1, first_index, first_vertex, 0);
 }
 
@@ -1898,6 +2291,7 @@ void agpu_render_encoder_draw_indexed_instanced_vulkan(AGPURenderPassEncoderIter
 {
     const VulkanDevice*  D   = (VulkanDevice*)encoder->device;
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)encoder;
+    if (Cmd->mSkipDraws) return;
     D->mVkDeviceTable.vkCmdDrawIndexed(Cmd->pVkCmdBuf, index_count, instance_count, first_index, first_vertex, first_instance);
 }
 
@@ -1905,6 +2299,12 @@ void agpu_cmd_end_render_pass_vulkan(AGPUCommandBufferIter cmd, AGPURenderPassEn
 {
     VulkanCommandBuffer* Cmd = (VulkanCommandBuffer*)cmd;
     const VulkanDevice*  D   = (VulkanDevice*)cmd->device;
+#if VK_KHR_dynamic_rendering
+    if (D->mDynamicRendering) {
+        D->mVkDeviceTable.vkCmdEndRenderingKHR(Cmd->pVkCmdBuf);
+        return;
+    }
+#endif
     D->mVkDeviceTable.vkCmdEndRenderPass(Cmd->pVkCmdBuf);
     Cmd->pRenderPass = VK_NULL_HANDLE;
 }
@@ -2201,7 +2601,7 @@ uint32_t agpu_acquire_next_image_vulkan(AGPUSwapChainIter swapchain, const struc
 void agpu_free_swapchain_vulkan(AGPUSwapChainIter swapchain)
 {
     agpu_free_swapchain_vulkan_impl(swapchain);
-    atom_free((void*)swapchain);
+    atom_free_aligned((void*)swapchain);
 }
 
 // exts
@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include <atomContainer/hashmap.hpp>
@@ -65,55 +70,134 @@ public:
 
 struct AGPUCachedRenderPass {
     VkRenderPass pass;
-    size_t       timestamp;
+    uint64_t     timestamp;
 };
 
 struct AGPUCachedFramebuffer {
     VkFramebuffer framebuffer;
-    size_t        timestamp;
+    uint64_t      timestamp;
+    uint32_t      view_count;
+    VkImageView   views[AGPU_MAX_MRT_COUNT * 2 + 1];
 };
 
+// descriptors are keyed by their 128-bit digest, collisions are negligible so lookups never compare whole descriptors.
+// entries are stamped with the frame arena frame of their last use and swept by agpu_device_begin_frame (every present
+// calls it): anything unused for retire_frames frames whose last frame has retired is destroyed. a framebuffer is
+// always looked up right after its render pass, so a render pass is never older than its framebuffers and both go in
+// the same sweep, before a recycled VkRenderPass handle could match a stale framebuffer key.
+// command buffers may record on several threads: hits only take the shared lock and stamp with an atomic store,
+// inserts, orphaning and the sweep take the exclusive lock.
 struct VulkanRenderPassTable //
 {
-    struct rpdesc_hash {
-        size_t operator()(const VulkanRenderPassDescriptor& a) const
-        {
-            return atom_hash(&a, sizeof(VulkanRenderPassDescriptor), AGPU_NAME_HASH_SEED);
-        }
-    };
+    VulkanRenderPassTable(VulkanDevice* device, uint32_t retire_frames)
+        : device{device}, retire_frames{retire_frames ? retire_frames : AGPU_DEFAULT_PASS_CACHE_RETIRE_FRAMES}
+    {
+    }
 
-    struct rpdesc_eq {
-        inline bool operator()(const VulkanRenderPassDescriptor& a, const VulkanRenderPassDescriptor& b) const
-        {
-            if (a.mColorAttachmentCount != b.mColorAttachmentCount) return false;
-            return std::memcmp(&a, &b, sizeof(VulkanRenderPassDescriptor)) == 0;
-        }
-    };
+    ~VulkanRenderPassTable()
+    {
+        for (auto& iter : cached_renderpasses) destroy(iter.second.pass);
+        for (auto& iter : cached_framebuffers) destroy(iter.second.framebuffer);
+        for (auto& orphan : orphaned_framebuffers) destroy(orphan.framebuffer);
+    }
 
-    struct fbdesc_hash {
-        size_t operator()(const VulkanFramebufferDescriptor& a) const
-        {
-            return atom_hash(&a, sizeof(VulkanFramebufferDescriptor), AGPU_NAME_HASH_SEED);
-        }
-    };
+    static atom_hash128_t key_of(const VulkanRenderPassDescriptor& desc)
+    {
+        return atom_hash_128(&desc, sizeof(VulkanRenderPassDescriptor), AGPU_NAME_HASH_SEED);
+    }
 
-    struct fbdesc_eq {
-        inline bool operator()(const VulkanFramebufferDescriptor& a, const VulkanFramebufferDescriptor& b) const
-        {
-            if (a.pRenderPass != b.pRenderPass) return false;
-            if (a.mAttachmentCount != b.mAttachmentCount) return false;
-            return std::memcmp(&a, &b, sizeof(VulkanRenderPassDescriptor)) == 0;
+    static atom_hash128_t key_of(const VulkanFramebufferDescriptor& desc)
+    {
+        return atom_hash_128(&desc, sizeof(VulkanFramebufferDescriptor), AGPU_NAME_HASH_SEED);
+    }
+
+    void destroy(VkRenderPass pass)
+    {
+        device->mVkDeviceTable.vkDestroyRenderPass(device->pVkDevice, pass, GLOBAL_VkAllocationCallbacks);
+    }
+
+    void destroy(VkFramebuffer framebuffer)
+    {
+        device->mVkDeviceTable.vkDestroyFramebuffer(device->pVkDevice, framebuffer, GLOBAL_VkAllocationCallbacks);
+    }
+
+    template <typename Entry>
+    bool expired(const Entry& entry, uint64_t frame, uint64_t retired) const
+    {
+        return entry.timestamp < retired && frame - entry.timestamp >= retire_frames;
+    }
+
+    // the current frame to stamp with
+    static uint64_t touch() { return atom_frame_arena_current_frame(); }
+
+    template <typename Entry>
+    static void stamp(Entry& entry, uint64_t frame)
+    {
+        std::atomic_ref<uint64_t>(entry.timestamp).store(frame, std::memory_order_relaxed);
+    }
+
+    void begin_frame(uint64_t frame)
+    {
+        std::unique_lock lock(mutex);
+        sweep(frame);
+    }
+
+    // exclusive lock held
+    void sweep(uint64_t frame)
+    {
+        const uint64_t retired = atom_frame_arena_retired_frames();
+        for (auto iter = cached_renderpasses.begin(); iter != cached_renderpasses.end();) {
+            if (expired(iter->second, frame, retired)) {
+                destroy(iter->second.pass);
+                cached_renderpasses.erase(iter++);
+                renderpass_evictions++;
+            } else
+                ++iter;
         }
-    };
+        for (auto iter = cached_framebuffers.begin(); iter != cached_framebuffers.end();) {
+            if (expired(iter->second, frame, retired)) {
+                destroy(iter->second.framebuffer);
+                cached_framebuffers.erase(iter++);
+                framebuffer_evictions++;
+            } else
+                ++iter;
+        }
+        // orphans only wait for their last frame to retire
+        std::erase_if(orphaned_framebuffers, [&](const AGPUCachedFramebuffer& orphan) {
+            if (orphan.timestamp >= retired) return false;
+            destroy(orphan.framebuffer);
+            return true;
+        });
+    }
 
-    atom::flat_hash_map<VulkanRenderPassDescriptor, AGPUCachedRenderPass, rpdesc_hash, rpdesc_eq>   cached_renderpasses;
-    atom::flat_hash_map<VulkanFramebufferDescriptor, AGPUCachedFramebuffer, fbdesc_hash, fbdesc_eq> cached_framebuffers;
+    VulkanDevice*             device;
+    uint32_t                  retire_frames;
+    mutable std::shared_mutex mutex;
+
+    atom::flat_hash_map<atom_hash128_t, AGPUCachedRenderPass>  cached_renderpasses;
+    atom::flat_hash_map<atom_hash128_t, AGPUCachedFramebuffer> cached_framebuffers;
+    // framebuffers over a freed image view, unreachable but possibly still referenced by frames in flight
+    std::vector<AGPUCachedFramebuffer>                         orphaned_framebuffers;
+
+    std::atomic<uint64_t> renderpass_hits       = 0;
+    std::atomic<uint64_t> renderpass_misses     = 0;
+    std::atomic<uint64_t> renderpass_evictions  = 0;
+    std::atomic<uint64_t> framebuffer_hits      = 0;
+    std::atomic<uint64_t> framebuffer_misses    = 0;
+    std::atomic<uint64_t> framebuffer_evictions = 0;
 };
 
 VkFramebuffer vulkan_frame_buffer_table_try_bind(struct VulkanRenderPassTable* table, const VulkanFramebufferDescriptor* desc)
 {
-    const auto& iter = table->cached_framebuffers.find(*desc);
-    if (iter != table->cached_framebuffers.end()) { return iter->second.framebuffer; }
+    const uint64_t   frame = table->touch();
+    std::shared_lock lock(table->mutex);
+    const auto&      iter  = table->cached_framebuffers.find(VulkanRenderPassTable::key_of(*desc));
+    if (iter != table->cached_framebuffers.end()) {
+        VulkanRenderPassTable::stamp(iter->second, frame);
+        table->framebuffer_hits.fetch_add(1, std::memory_order_relaxed);
+        return iter->second.framebuffer;
+    }
+    table->framebuffer_misses.fetch_add(1, std::memory_order_relaxed);
     return VK_NULL_HANDLE;
 }
 
@@ -121,18 +205,42 @@ void vulkan_frame_buffer_table_add(struct VulkanRenderPassTable*             tab
                                    const struct VulkanFramebufferDescriptor* desc,
                                    VkFramebuffer                             framebuffer)
 {
-    const auto& iter = table->cached_framebuffers.find(*desc);
+    const auto            key    = VulkanRenderPassTable::key_of(*desc);
+    AGPUCachedFramebuffer new_fb = {framebuffer, table->touch(), desc->mAttachmentCount};
+    std::unique_lock      lock(table->mutex);
+    const auto&           iter   = table->cached_framebuffers.find(key);
     if (iter != table->cached_framebuffers.end()) { ATOM_warn(u8"Vulkan Framebuffer with this desc already exists!"); }
-    // TODO: Add timestamp
-    AGPUCachedFramebuffer new_fb      = {framebuffer, 0};
-    table->cached_framebuffers[*desc] = new_fb;
+    memcpy(new_fb.views, desc->pImageViews, desc->mAttachmentCount * sizeof(VkImageView));
+    table->cached_framebuffers[key] = new_fb;
+}
+
+void vulkan_frame_buffer_table_forget_image_view(struct VulkanRenderPassTable* table, VkImageView view)
+{
+    if (view == VK_NULL_HANDLE) return;
+    std::unique_lock lock(table->mutex);
+    for (auto iter = table->cached_framebuffers.begin(); iter != table->cached_framebuffers.end();) {
+        const AGPUCachedFramebuffer& cached = iter->second;
+        if (std::find(cached.views, cached.views + cached.view_count, view) != cached.views + cached.view_count) {
+            table->orphaned_framebuffers.push_back(cached);
+            table->cached_framebuffers.erase(iter++);
+            table->framebuffer_evictions++;
+        } else
+            ++iter;
+    }
 }
 
 VkRenderPass vulkan_render_pass_table_try_find(struct VulkanRenderPassTable*            table,
                                                const struct VulkanRenderPassDescriptor* desc)
 {
-    const auto& iter = table->cached_renderpasses.find(*desc);
-    if (iter != table->cached_renderpasses.end()) { return iter->second.pass; }
+    const uint64_t   frame = table->touch();
+    std::shared_lock lock(table->mutex);
+    const auto&      iter  = table->cached_renderpasses.find(VulkanRenderPassTable::key_of(*desc));
+    if (iter != table->cached_renderpasses.end()) {
+        VulkanRenderPassTable::stamp(iter->second, frame);
+        table->renderpass_hits.fetch_add(1, std::memory_order_relaxed);
+        return iter->second.pass;
+    }
+    table->renderpass_misses.fetch_add(1, std::memory_order_relaxed);
     return VK_NULL_HANDLE;
 }
 
@@ -140,11 +248,12 @@ void vulkan_render_pass_table_add(struct VulkanRenderPassTable*            table
                                   const struct VulkanRenderPassDescriptor* desc,
                                   VkRenderPass                             pass)
 {
-    const auto& iter = table->cached_renderpasses.find(*desc);
+    const auto           key      = VulkanRenderPassTable::key_of(*desc);
+    AGPUCachedRenderPass new_pass = {pass, table->touch()};
+    std::unique_lock     lock(table->mutex);
+    const auto&          iter     = table->cached_renderpasses.find(key);
     if (iter != table->cached_renderpasses.end()) { ATOM_warn(u8"Vulkan Pass with this desc already exists!"); }
-    // TODO: Add timestamp
-    AGPUCachedRenderPass new_pass     = {pass, 0};
-    table->cached_renderpasses[*desc] = new_pass;
+    table->cached_renderpasses[key] = new_pass;
 }
 
 struct VulkanExtensionTable : public atom::parallel_flat_hash_map<std::string, bool> //
@@ -434,32 +543,54 @@ AGPUDeviceIter agpu_create_device_vulkan(AGPUAdapterIter adapter, const AGPUDevi
     // Single Device Only.
     volkLoadDeviceTable(&D->mVkDeviceTable, D->pVkDevice);
     atom_assert(D->mVkDeviceTable.vkCreateSwapchainKHR && "failed to load swapchain proc!");
+#if VK_KHR_dynamic_rendering
+    D->mDynamicRendering = !desc->disable_dynamic_rendering
+                           && A->mPhysicalDeviceDynamicRenderingFeatures.dynamicRendering
+                           && D->mVkDeviceTable.vkCmdBeginRenderingKHR && D->mVkDeviceTable.vkCmdEndRenderingKHR;
+#endif
 
     // Create Pipeline Cache
     D->pPipelineCache = ATOM_NULLPTR;
-    if (!desc->disable_pipeline_cache) { vulkan_create_pipeline_cache(D); }
+    if (!desc->disable_pipeline_cache) { vulkan_create_pipeline_cache(D, desc); }
 
     // Create VMA Allocator
     vulkan_create_vma_allocator(I, A, D);
     // Create Descriptor Heap
     D->pDescriptorPool = vulkan_create_desciptor_pool(D);
     // Create pass table
-    D->pPassTable      = atom_new<VulkanRenderPassTable>();
+    D->pPassTable      = atom_new<VulkanRenderPassTable>(D, desc->pass_cache_retire_frames);
+    // Create backend object pools
+    vulkan_create_object_pools(D);
     return &D->super;
 }
 
+void agpu_query_pass_cache_statistics_vulkan(const AGPUDeviceIter device, AGPUPassCacheStatistics* statistics)
+{
+    const VulkanRenderPassTable* table = ((const VulkanDevice*)device)->pPassTable;
+    std::shared_lock             lock(table->mutex);
+    statistics->render_pass_hits       = table->renderpass_hits;
+    statistics->render_pass_misses     = table->renderpass_misses;
+    statistics->render_pass_evictions  = table->renderpass_evictions;
+    statistics->framebuffer_hits       = table->framebuffer_hits;
+    statistics->framebuffer_misses     = table->framebuffer_misses;
+    statistics->framebuffer_evictions  = table->framebuffer_evictions;
+    statistics->render_pass_count      = (uint32_t)table->cached_renderpasses.size();
+    statistics->framebuffer_count      = (uint32_t)(table->cached_framebuffers.size() + table->orphaned_framebuffers.size());
+}
+
+void agpu_device_begin_frame_vulkan(AGPUDeviceIter device, uint64_t frame)
+{
+    ((VulkanDevice*)device)->pPassTable->begin_frame(frame);
+}
+
+bool agpu_save_pipeline_cache_vulkan(AGPUDeviceIter device) { return vulkan_save_pipeline_cache((VulkanDevice*)device); }
+
 void agpu_free_device_vulkan(AGPUDeviceIter device)
 {
     VulkanDevice*   D = (VulkanDevice*)device;
     VulkanAdapter*  A = (VulkanAdapter*)device->adapter;
     VulkanInstance* I = (VulkanInstance*)device->adapter->instance;
 
-    for (auto& iter : D->pPassTable->cached_renderpasses) {
-        D->mVkDeviceTable.vkDestroyRenderPass(D->pVkDevice, iter.second.pass, GLOBAL_VkAllocationCallbacks);
-    }
-    for (auto& iter : D->pPassTable->cached_framebuffers) {
-        D->mVkDeviceTable.vkDestroyFramebuffer(D->pVkDevice, iter.second.framebuffer, GLOBAL_VkAllocationCallbacks);
-    }
     atom_delete(D->pPassTable);
 
     for (uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; i++) {
@@ -469,6 +600,7 @@ void agpu_free_device_vulkan(AGPUDeviceIter device)
     vulkan_free_vma_allocator(I, A, D);
     vulkan_free_descriptor_pool(D->pDescriptorPool);
     vulkan_free_pipeline_cache(I, A, D);
+    vulkan_free_object_pools(D);
     vkDestroyDevice(D->pVkDevice, GLOBAL_VkAllocationCallbacks);
     atom_free(D);
 }
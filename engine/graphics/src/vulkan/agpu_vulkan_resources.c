@@ -9,6 +9,8 @@
 #include <atomGraphics/backend/vulkan/vulkan_utils.h>
 #include "atomGraphics/common/flags.h"
 
+static const char* kVkTileMappingMemoryPoolName = "AGPU::vk_tile_mapping";
+
 static ATOM_FORCEINLINE VkBufferCreateInfo vulkan_create_buffer_create_info(VulkanAdapter*                     A,
                                                                             const struct AGPUBufferDescriptor* desc)
 {
@@ -125,7 +127,7 @@ AGPUBufferIter agpu_create_buffer_vulkan(AGPUDeviceIter device, const struct AGP
         atom_assert(0 && "VMA failed to create buffer!");
         return ATOM_NULLPTR;
     }
-    VulkanBuffer*   B    = atom_calloc_aligned(1, sizeof(VulkanBuffer) + sizeof(AGPUBufferInfo), _Alignof(VulkanBuffer));
+    VulkanBuffer*   B    = (VulkanBuffer*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_BUFFER]);
     AGPUBufferInfo* info = (AGPUBufferInfo*)(B + 1);
     B->super.info        = info;
     B->pVkAllocation     = mVmaAllocation;
@@ -379,7 +381,7 @@ void agpu_free_buffer_vulkan(AGPUBufferIter buffer)
         B->pVkStorageTexelView = VK_NULL_HANDLE;
     }
     vmaDestroyBuffer(D->pVmaAllocator, B->pVkBuffer, B->pVkAllocation);
-    atom_free_aligned(B);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_BUFFER], B);
 }
 
 // Texture/TextureView APIs
@@ -795,7 +797,8 @@ AGPUTextureIter agpu_create_texture_vulkan(AGPUDeviceIter device, const struct A
     }
 
     // create texture object
-    VulkanTexture* T = (VulkanTexture*)atom_calloc_aligned(1, totalSize, _Alignof(VulkanTexture));
+    atom_assert(totalSize <= atom_object_pool_slot_size(D->pObjectPools[VK_OBJECT_POOL_TEXTURE]));
+    VulkanTexture* T = (VulkanTexture*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_TEXTURE]);
     atom_assert(T);
     T->pVkImage = pVkImage;
 
@@ -806,9 +809,10 @@ AGPUTextureIter agpu_create_texture_vulkan(AGPUDeviceIter device, const struct A
     if (desc->flags & AGPU_TCF_TILED_RESOURCE) {
         VkSparseImageMemoryRequirements sparseReq  = vulkan_fill_tiled_texture_info(D, T, desc, &memTypBits);
         const AGPUTiledTextureInfo*     pTiledInfo = T->super.tiled_resource;
-        pVkTileMappings                            = atom_calloc_aligned(pTiledInfo->packed_mip_start,
-                                              sizeof(VulkanTileTextureSubresourceMapping),
-                                              _Alignof(VulkanTileTextureSubresourceMapping));
+        pVkTileMappings                            = atom_calloc_alignedN(pTiledInfo->packed_mip_start,
+                                               sizeof(VulkanTileTextureSubresourceMapping),
+                                               _Alignof(VulkanTileTextureSubresourceMapping),
+                                               kVkTileMappingMemoryPoolName);
         for (uint32_t i = 0; i < pTiledInfo->packed_mip_start; i++) {
             const uint32_t                      X  = pTiledInfo->subresources[i].width_in_tiles;
             const uint32_t                      Y  = pTiledInfo->subresources[i].height_in_tiles;
@@ -818,15 +822,19 @@ AGPUTextureIter agpu_create_texture_vulkan(AGPUDeviceIter device, const struct A
                 .Y                 = Y,
                 .Z                 = Z,
                 .mVkMemoryTypeBits = memTypBits,
-                .mappings          = atom_calloc_aligned(X * Y * Z, sizeof(VulkanTileMapping), _Alignof(VulkanTileMapping))};
+                .mappings          = atom_calloc_alignedN(X * Y * Z,
+                                                 sizeof(VulkanTileMapping),
+                                                 _Alignof(VulkanTileMapping),
+                                                 kVkTileMappingMemoryPoolName)};
             memcpy(&pVkTileMappings[i], &SM, sizeof(VulkanTileTextureSubresourceMapping));
         }
         const bool SingleTail   = (sparseReq.formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT);
         T->mPackedMappingsCount = SingleTail ? 1 : arraySize;
         T->mSingleTail          = SingleTail;
-        pVkPackedMappings       = atom_calloc_aligned(T->mPackedMappingsCount,
-                                                sizeof(VulkanTileTexturePackedMipMapping),
-                                                _Alignof(VulkanTileTexturePackedMipMapping));
+        pVkPackedMappings       = atom_calloc_alignedN(T->mPackedMappingsCount,
+                                                 sizeof(VulkanTileTexturePackedMipMapping),
+                                                 _Alignof(VulkanTileTexturePackedMipMapping),
+                                                 kVkTileMappingMemoryPoolName);
         for (uint32_t i = 0; i < T->mPackedMappingsCount; i++) {
             pVkPackedMappings[i].mVkSparseTailStride = sparseReq.imageMipTailStride;
             pVkPackedMappings[i].mVkSparseTailOffset = sparseReq.imageMipTailOffset;
@@ -958,9 +966,11 @@ void agpu_queue_map_packed_mips_vulkan(AGPUQueueIter queue, const struct AGPUTil
     }
     if (N == 0) return;
 
-    uint32_t            M           = 0;
-    VkSparseMemoryBind* opaqueBinds = atom_calloc(N, sizeof(VkSparseMemoryBind) + sizeof(VkSparseImageOpaqueMemoryBindInfo));
-    VkSparseImageOpaqueMemoryBindInfo* bindInfos = (VkSparseImageOpaqueMemoryBindInfo*)(opaqueBinds + N);
+    uint32_t                        M       = 0;
+    const atom_frame_arena_marker_t Scratch = atom_frame_arena_mark();
+    VkSparseMemoryBind* opaqueBinds = atom_frame_calloc(N, sizeof(VkSparseMemoryBind), _Alignof(VkSparseMemoryBind));
+    VkSparseImageOpaqueMemoryBindInfo* bindInfos =
+        atom_frame_calloc(N, sizeof(VkSparseImageOpaqueMemoryBindInfo), _Alignof(VkSparseImageOpaqueMemoryBindInfo));
     for (uint32_t i = 0; i < regions->packed_mip_count; i++) {
         VulkanTexture*                     T        = (VulkanTexture*)regions->packed_mips[i].texture;
         uint32_t                           layer    = T->mSingleTail ? 0 : regions->packed_mips[i].layer;
@@ -1014,7 +1024,7 @@ void agpu_queue_map_packed_mips_vulkan(AGPUQueueIter queue, const struct AGPUTil
         atomic_fetch_add_explicit(&pModTiledInfo->alive_pack_count, 1, memory_order_relaxed);
     }
 
-    atom_free(opaqueBinds);
+    atom_frame_arena_rewind(Scratch);
 }
 
 void agpu_queue_unmap_packed_mips_vulkan(AGPUQueueIter queue, const struct AGPUTiledTexturePackedMips* regions)
@@ -1059,13 +1069,14 @@ void agpu_queue_map_tiled_texture_vulkan(AGPUQueueIter queue, const struct AGPUT
     }
     if (!TotalTileCount) return;
 
-    void* ArgMemory = atom_calloc(
-        TotalTileCount,
-        sizeof(VmaAllocation) + sizeof(VmaAllocationInfo) + sizeof(VkSparseImageMemoryBind) + sizeof(VulkanTileMapping*));
-    VmaAllocation*           pAllocations     = (VmaAllocation*)ArgMemory;
-    VmaAllocationInfo*       pAllocationInfos = (VmaAllocationInfo*)(pAllocations + TotalTileCount);
-    VkSparseImageMemoryBind* pBinds           = (VkSparseImageMemoryBind*)(pAllocationInfos + TotalTileCount);
-    VulkanTileMapping**      ppMappings       = (VulkanTileMapping**)(pBinds + TotalTileCount);
+    const atom_frame_arena_marker_t Scratch = atom_frame_arena_mark();
+    VmaAllocation*     pAllocations = atom_frame_calloc(TotalTileCount, sizeof(VmaAllocation), _Alignof(VmaAllocation));
+    VmaAllocationInfo* pAllocationInfos =
+        atom_frame_calloc(TotalTileCount, sizeof(VmaAllocationInfo), _Alignof(VmaAllocationInfo));
+    VkSparseImageMemoryBind* pBinds =
+        atom_frame_calloc(TotalTileCount, sizeof(VkSparseImageMemoryBind), _Alignof(VkSparseImageMemoryBind));
+    VulkanTileMapping** ppMappings =
+        atom_frame_calloc(TotalTileCount, sizeof(VulkanTileMapping*), _Alignof(VulkanTileMapping*));
     ATOM_DECLARE_ZERO(VkMemoryRequirements, memReqs);
     memReqs.size           = kPageSize;
     memReqs.memoryTypeBits = T->pVkTileMappings->mVkMemoryTypeBits;
@@ -1136,7 +1147,7 @@ void agpu_queue_map_tiled_texture_vulkan(AGPUQueueIter queue, const struct AGPUT
         atomic_fetch_add_explicit(&pModTiledInfo->alive_tiles_count, 1, memory_order_relaxed);
     }
 
-    atom_free(ArgMemory);
+    atom_frame_arena_rewind(Scratch);
 }
 
 void agpu_queue_unmap_tiled_texture_vulkan(AGPUQueueIter queue, const struct AGPUTiledTextureRegions* regions)
@@ -1235,16 +1246,16 @@ void agpu_free_texture_vulkan(AGPUTextureIter texture)
                 for (uint32_t x = 0; x < subres->X; x++)
                     for (uint32_t y = 0; y < subres->Y; y++)
                         for (uint32_t z = 0; z < subres->Z; z++) vulkan_unmap_tile_mapping_at(T, subres, x, y, z);
-                atom_free_aligned(subres->mappings);
+                atom_free_alignedN(subres->mappings, _Alignof(VulkanTileMapping), kVkTileMappingMemoryPoolName);
             }
         }
-        atom_free_aligned(T->pVkTileMappings);
+        atom_free_alignedN(T->pVkTileMappings, _Alignof(VulkanTileTextureSubresourceMapping), kVkTileMappingMemoryPoolName);
 
         for (uint32_t n = 0; n < T->mPackedMappingsCount; n++) vulkan_unmap_packed_mapping_at(T, n);
-        atom_free_aligned(T->pVkPackedMappings);
+        atom_free_alignedN(T->pVkPackedMappings, _Alignof(VulkanTileTexturePackedMipMapping), kVkTileMappingMemoryPoolName);
     }
     if (T->super.tiled_resource) atom_free_aligned((void*)T->super.tiled_resource);
-    atom_free_aligned(T);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_TEXTURE], T);
 }
 
 AGPUTextureViewIter agpu_create_texture_view_vulkan(AGPUDeviceIter device, const struct AGPUTextureViewDescriptor* desc)
@@ -1252,7 +1263,7 @@ AGPUTextureViewIter agpu_create_texture_view_vulkan(AGPUDeviceIter device, const
     VulkanDevice*          D     = (VulkanDevice*)desc->texture->device;
     VulkanTexture*         T     = (VulkanTexture*)desc->texture;
     const AGPUTextureInfo* pInfo = T->super.info;
-    VulkanTextureView* TV = (VulkanTextureView*)atom_calloc_aligned(1, sizeof(VulkanTextureView), _Alignof(VulkanTextureView));
+    VulkanTextureView* TV = (VulkanTextureView*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_TEXTURE_VIEW]);
     VkImageViewType    view_type  = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
     VkImageType        mImageType = pInfo->is_cube ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
     switch (mImageType) {
@@ -1330,6 +1341,8 @@ void agpu_free_texture_view_vulkan(AGPUTextureViewIter render_target)
 {
     VulkanDevice*      D  = (VulkanDevice*)render_target->device;
     VulkanTextureView* TV = (VulkanTextureView*)render_target;
+    // Cached framebuffers must not outlive the view, a new view could come back with the same handle
+    vulkan_frame_buffer_table_forget_image_view(D->pPassTable, TV->pVkRTVDSVDescriptor);
     // Free descriptors
     if (VK_NULL_HANDLE != TV->pVkSRVDescriptor)
         D->mVkDeviceTable.vkDestroyImageView(D->pVkDevice, TV->pVkSRVDescriptor, GLOBAL_VkAllocationCallbacks);
@@ -1337,7 +1350,7 @@ void agpu_free_texture_view_vulkan(AGPUTextureViewIter render_target)
         D->mVkDeviceTable.vkDestroyImageView(D->pVkDevice, TV->pVkRTVDSVDescriptor, GLOBAL_VkAllocationCallbacks);
     if (VK_NULL_HANDLE != TV->pVkUAVDescriptor)
         D->mVkDeviceTable.vkDestroyImageView(D->pVkDevice, TV->pVkUAVDescriptor, GLOBAL_VkAllocationCallbacks);
-    atom_free_aligned(TV);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_TEXTURE_VIEW], TV);
 }
 
 bool agpu_try_bind_aliasing_texture_vulkan(AGPUDeviceIter device, const struct AGPUTextureAliasingBindDescriptor* desc)
@@ -1376,7 +1389,7 @@ bool agpu_try_bind_aliasing_texture_vulkan(AGPUDeviceIter device, const struct A
 AGPUSamplerIter agpu_create_sampler_vulkan(AGPUDeviceIter device, const struct AGPUSamplerDescriptor* desc)
 {
     VulkanDevice*       D            = (VulkanDevice*)device;
-    VulkanSampler*      S            = (VulkanSampler*)atom_calloc_aligned(1, sizeof(VulkanSampler), _Alignof(VulkanSampler));
+    VulkanSampler*      S            = (VulkanSampler*)atom_object_pool_alloc(D->pObjectPools[VK_OBJECT_POOL_SAMPLER]);
     VkSamplerCreateInfo sampler_info = {
         .sType            = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
         .pNext            = NULL,
@@ -1406,7 +1419,7 @@ void agpu_free_sampler_vulkan(AGPUSamplerIter sampler)
     VulkanSampler* S = (VulkanSampler*)sampler;
     VulkanDevice*  D = (VulkanDevice*)sampler->device;
     D->mVkDeviceTable.vkDestroySampler(D->pVkDevice, S->pVkSampler, GLOBAL_VkAllocationCallbacks);
-    atom_free_aligned(S);
+    atom_object_pool_free(D->pObjectPools[VK_OBJECT_POOL_SAMPLER], S);
 }
 
 // Shader APIs
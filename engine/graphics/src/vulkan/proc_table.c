@@ -13,31 +13,38 @@ const AGPUProcTable tbl_vk = {
     .query_queue_count    = &agpu_query_queue_count_vulkan,
 
     // Device APIs
-    .create_device            = &agpu_create_device_vulkan,
-    .query_video_memory_info  = &agpu_query_video_memory_info_vulkan,
-    .query_shared_memory_info = &agpu_query_shared_memory_info_vulkan,
-    .free_device              = &agpu_free_device_vulkan,
+    .create_device               = &agpu_create_device_vulkan,
+    .query_video_memory_info     = &agpu_query_video_memory_info_vulkan,
+    .query_shared_memory_info    = &agpu_query_shared_memory_info_vulkan,
+    .query_pass_cache_statistics = &agpu_query_pass_cache_statistics_vulkan,
+    .device_begin_frame          = &agpu_device_begin_frame_vulkan,
+    .save_pipeline_cache         = &agpu_save_pipeline_cache_vulkan,
+    .free_device                 = &agpu_free_device_vulkan,
 
     // API Object APIs
-    .create_fence                = &agpu_create_fence_vulkan,
-    .wait_fences                 = &agpu_wait_fences_vulkan,
-    .query_fence_status          = &agpu_query_fence_status_vulkan,
-    .free_fence                  = &agpu_free_fence_vulkan,
-    .create_semaphore            = &agpu_create_semaphore_vulkan,
-    .free_semaphore              = &agpu_free_semaphore_vulkan,
-    .create_pipeline_layout      = &agpu_create_pipeline_layout_vulkan,
-    .free_pipeline_layout        = &agpu_free_pipeline_layout_vulkan,
-    .create_pipeline_layout_pool = &agpu_create_pipeline_layout_pool_vulkan,
-    .free_pipeline_layout_pool   = &agpu_free_pipeline_layout_pool_vulkan,
-    .create_descriptor_set       = &agpu_create_descriptor_set_vulkan,
-    .update_descriptor_set       = &agpu_update_descriptor_set_vulkan,
-    .free_descriptor_set         = &agpu_free_descriptor_set_vulkan,
-    .create_compute_pipeline     = &agpu_create_compute_pipeline_vulkan,
-    .free_compute_pipeline       = &agpu_free_compute_pipeline_vulkan,
-    .create_render_pipeline      = &agpu_create_render_pipeline_vulkan,
-    .free_render_pipeline        = &agpu_free_render_pipeline_vulkan,
-    .create_query_pool           = &agpu_create_query_pool_vulkan,
-    .free_query_pool             = &agpu_free_query_pool_vulkan,
+    .create_fence                  = &agpu_create_fence_vulkan,
+    .wait_fences                   = &agpu_wait_fences_vulkan,
+    .query_fence_status            = &agpu_query_fence_status_vulkan,
+    .free_fence                    = &agpu_free_fence_vulkan,
+    .create_semaphore              = &agpu_create_semaphore_vulkan,
+    .free_semaphore                = &agpu_free_semaphore_vulkan,
+    .create_pipeline_layout        = &agpu_create_pipeline_layout_vulkan,
+    .free_pipeline_layout          = &agpu_free_pipeline_layout_vulkan,
+    .create_pipeline_layout_pool   = &agpu_create_pipeline_layout_pool_vulkan,
+    .free_pipeline_layout_pool     = &agpu_free_pipeline_layout_pool_vulkan,
+    .create_descriptor_set         = &agpu_create_descriptor_set_vulkan,
+    .update_descriptor_set         = &agpu_update_descriptor_set_vulkan,
+    .free_descriptor_set           = &agpu_free_descriptor_set_vulkan,
+    .create_compute_pipeline       = &agpu_create_compute_pipeline_vulkan,
+    .free_compute_pipeline         = &agpu_free_compute_pipeline_vulkan,
+    .create_render_pipeline        = &agpu_create_render_pipeline_vulkan,
+    .free_render_pipeline          = &agpu_free_render_pipeline_vulkan,
+    .create_compute_pipeline_async = &agpu_create_compute_pipeline_async_vulkan,
+    .create_render_pipeline_async  = &agpu_create_render_pipeline_async_vulkan,
+    .wait_compute_pipeline         = &agpu_wait_compute_pipeline_vulkan,
+    .wait_render_pipeline          = &agpu_wait_render_pipeline_vulkan,
+    .create_query_pool             = &agpu_create_query_pool_vulkan,
+    .free_query_pool               = &agpu_free_query_pool_vulkan,
 
     // Queue APIs
     .get_queue                  = &agpu_get_queue_vulkan,
@@ -141,11 +148,22 @@ static const char* kVulkanInternalMemoryPoolNames[5] = {"vk::command(internal)",
                                                         "vk::instance(internal)"};
 static const char* kVulkanMemoryPoolNames[5]         = {"vk::command", "vk::object", "vk::cache", "vk::device", "vk::instance"};
 
+static ATOM_FORCEINLINE const char* agpu_vulkan_memory_pool_name(VkSystemAllocationScope allocationScope)
+{
+    return allocationScope <= 4 ? kVulkanMemoryPoolNames[allocationScope] : kVulkanMemoryPoolNameUnknown;
+}
+
+static ATOM_FORCEINLINE const char* agpu_vulkan_internal_memory_pool_name(VkSystemAllocationScope allocationScope)
+{
+    return allocationScope <= 4 ? kVulkanInternalMemoryPoolNames[allocationScope] : kVulkanMemoryPoolNameUnknown;
+}
+
 static void VKAPI_PTR agpu_vulkan_internal_alloc_notify(void*                    pUserData,
                                                         size_t                   size,
                                                         VkInternalAllocationType allocationType,
                                                         VkSystemAllocationScope  allocationScope)
 {
+    atom_memory_tag_add(agpu_vulkan_internal_memory_pool_name(allocationScope), size);
 }
 
 static void VKAPI_PTR agpu_vulkan_internal_free_notify(void*                    pUserData,
@@ -153,14 +171,9 @@ static void VKAPI_PTR agpu_vulkan_internal_free_notify(void*
                                                        VkInternalAllocationType allocationType,
                                                        VkSystemAllocationScope  allocationScope)
 {
+    atom_memory_tag_remove(agpu_vulkan_internal_memory_pool_name(allocationScope), size);
 }
 
-typedef struct AllocHeader {
-    int16_t  padding;
-    int16_t  scope;
-    uint32_t alignment;
-} AllocHeader;
-
 static void* VKAPI_PTR agpu_vulkan_alloc(void*                   pUserData,
                                          size_t                  size,
                                          size_t                  alignment,
@@ -168,34 +181,15 @@ static void* VKAPI_PTR agpu_vulkan_alloc(void*                   pUserData,
 {
     if (size == 0) return ATOM_NULLPTR;
 
-    uint8_t* ptr        = ATOM_NULLPTR;
-    alignment           = alignment ? alignment : _Alignof(AllocHeader);
-    size_t padding      = atom_align(sizeof(AllocHeader), alignment);
-    size_t aligned_size = atom_align(size, alignment);
-    if (allocationScope <= 4) {
-        ptr = atom_malloc_aligned(aligned_size + padding, alignment);
-    } else {
-        ptr = atom_malloc_aligned(aligned_size + padding, alignment);
-    }
-    uint8_t*     result  = (uint8_t*)ptr + padding;
-    AllocHeader* pHeader = (AllocHeader*)(result - sizeof(AllocHeader));
-    pHeader->padding     = (int16_t)padding;
-    pHeader->alignment   = (uint32_t)alignment;
-    pHeader->scope       = allocationScope;
-
-    return result;
+    // tagged blocks keep size and pool in their own header
+    return atom_malloc_alignedN(size, alignment, agpu_vulkan_memory_pool_name(allocationScope));
 }
 
 static void VKAPI_PTR agpu_vulkan_free(void* pUserData, void* pMemory)
 {
     if (ATOM_NULLPTR == pMemory) return;
 
-    AllocHeader* pHeader = (AllocHeader*)((uint8_t*)pMemory - sizeof(AllocHeader));
-    if (pHeader->scope <= 4) {
-        atom_free_aligned((uint8_t*)pMemory - pHeader->padding);
-    } else {
-        atom_free_aligned((uint8_t*)pMemory - pHeader->padding);
-    }
+    atom_free_alignedN(pMemory, 0);
 }
 
 static void* VKAPI_PTR agpu_vulkan_realloc(void*                   pUserData,
@@ -204,21 +198,7 @@ static void* VKAPI_PTR agpu_vulkan_realloc(void*                   pUserData,
                                            size_t                  alignment,
                                            VkSystemAllocationScope allocationScope)
 {
-    AllocHeader* pHeader = (AllocHeader*)((uint8_t*)pOriginal - sizeof(AllocHeader));
-    alignment            = alignment ? alignment : _Alignof(AllocHeader);
-    size_t padding       = atom_align(sizeof(AllocHeader), alignment);
-    size_t aligned_size  = atom_align(size, alignment);
-
-    const char* PoolName = pHeader->scope <= 4 ? kVulkanMemoryPoolNames[pHeader->scope] : kVulkanMemoryPoolNameUnknown;
-    void*       ptr      = atom_realloc_aligned((uint8_t*)pOriginal - pHeader->padding, padding + aligned_size, alignment);
-
-    uint8_t* result    = (uint8_t*)ptr + padding;
-    pHeader            = (AllocHeader*)(result - sizeof(AllocHeader));
-    pHeader->padding   = (int16_t)padding;
-    pHeader->alignment = (uint32_t)alignment;
-    pHeader->scope     = allocationScope;
-
-    return result;
+    return atom_realloc_alignedN(pOriginal, size, alignment, agpu_vulkan_memory_pool_name(allocationScope));
 }
 
 const VkAllocationCallbacks gVulkanAllocationCallbacks = {.pfnAllocation         = &agpu_vulkan_alloc,
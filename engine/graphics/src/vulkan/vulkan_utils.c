@@ -1,3 +1,8 @@
+// flock, usleep and O_CLOEXEC are hidden by a strict -std=c17
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -6,11 +11,48 @@
 #include <atomGraphics/backend/vulkan/vulkan_utils.h>
 #include <atomGraphics/backend/vulkan/agpu_vulkan.h>
 #include <atomGraphics/common/flags.h>
+#include <atomCore/job.h>
 
 #ifdef AGPU_THREAD_SAFETY
 #include <threads.h>
 #endif
 
+#ifdef _WIN32
+#include <process.h>
+#include <atomGraphics/winheaders.h>
+#define vulkan_process_id()  _getpid()
+#define vulkan_sleep_ms(ms)  Sleep(ms)
+#define VULKAN_NO_LOCK_FILE  INVALID_HANDLE_VALUE
+typedef HANDLE vulkan_lock_file_t;
+
+static vulkan_lock_file_t vulkan_open_lock_file(const char* path)
+{
+    return CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, 0, NULL);
+}
+
+static bool vulkan_try_lock_file(vulkan_lock_file_t file)
+{
+    OVERLAPPED overlapped = {0};
+    return LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &overlapped);
+}
+
+static void vulkan_close_lock_file(vulkan_lock_file_t file) { CloseHandle(file); }
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#define vulkan_process_id()  getpid()
+#define vulkan_sleep_ms(ms)  usleep((ms) * 1000)
+#define VULKAN_NO_LOCK_FILE  -1
+typedef int vulkan_lock_file_t;
+
+static vulkan_lock_file_t vulkan_open_lock_file(const char* path) { return open(path, O_CREAT | O_RDWR | O_CLOEXEC, 0644); }
+
+static bool vulkan_try_lock_file(vulkan_lock_file_t file) { return flock(file, LOCK_EX | LOCK_NB) == 0; }
+
+static void vulkan_close_lock_file(vulkan_lock_file_t file) { close(file); }
+#endif
+
 bool vulkan_initialize_environment(struct AGPUInstance* Inst)
 {
     Inst->runtime_table = agpu_create_runtime_table();
@@ -223,23 +265,278 @@ void vulkan_query_all_adapters(VulkanInstance*    I,
 }
 
 // Device APIs
-void vulkan_create_pipeline_cache(VulkanDevice* D)
+// the pipeline cache file puts a header of its own in front of the driver blob. the blob is only handed back to the
+// same vendor, device, driver version and pipelineCacheUUID, and the checksums reject torn or truncated files before
+// the driver gets to see them.
+#define VK_PIPELINE_CACHE_FILE_MAGIC   0x43505641u // "AVPC"
+#define VK_PIPELINE_CACHE_FILE_VERSION 1u
+
+typedef struct VulkanPipelineCacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint32_t reserved;
+    uint8_t  cache_uuid[VK_UUID_SIZE];
+    uint64_t data_size;
+    uint64_t data_hash;
+    // over every field above
+    uint64_t header_hash;
+} VulkanPipelineCacheFileHeader;
+
+static void vulkan_fill_pipeline_cache_header(const VulkanDevice* D, VulkanPipelineCacheFileHeader* header)
+{
+    const VulkanAdapter*              A     = (const VulkanAdapter*)D->super.adapter;
+    const VkPhysicalDeviceProperties* props = &A->mPhysicalDeviceProps.properties;
+    memset(header, 0, sizeof(VulkanPipelineCacheFileHeader));
+    header->magic          = VK_PIPELINE_CACHE_FILE_MAGIC;
+    header->version        = VK_PIPELINE_CACHE_FILE_VERSION;
+    header->vendor_id      = props->vendorID;
+    header->device_id      = props->deviceID;
+    header->driver_version = props->driverVersion;
+    memcpy(header->cache_uuid, props->pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+static uint64_t vulkan_pipeline_cache_header_hash(const VulkanPipelineCacheFileHeader* header)
+{
+    return atom_hash_64(header, offsetof(VulkanPipelineCacheFileHeader, header_hash), AGPU_NAME_HASH_SEED);
+}
+
+// NULL when there is no file or it does not match this device, the blob is atom_malloc-ed
+static void* vulkan_read_pipeline_cache_file(const VulkanDevice* D, size_t* size)
+{
+    FILE* file = fopen((const char*)D->pPipelineCachePath, "rb");
+    if (!file) return NULL;
+    VulkanPipelineCacheFileHeader header, expected;
+    vulkan_fill_pipeline_cache_header(D, &expected);
+    void* data = NULL;
+    if (fread(&header, sizeof(header), 1, file) == 1 && header.header_hash == vulkan_pipeline_cache_header_hash(&header)
+        && memcmp(&header, &expected, offsetof(VulkanPipelineCacheFileHeader, data_size)) == 0) {
+        data = atom_malloc((size_t)header.data_size);
+        if (fread(data, 1, (size_t)header.data_size, file) != header.data_size
+            || atom_hash_64(data, (size_t)header.data_size, AGPU_NAME_HASH_SEED) != header.data_hash) {
+            atom_free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    if (data) *size = (size_t)header.data_size;
+    return data;
+}
+
+// written aside and renamed over the old file, so other processes never read a half written one
+static bool vulkan_write_pipeline_cache_file(const VulkanDevice* D, const void* data, size_t size)
+{
+    VulkanPipelineCacheFileHeader header;
+    vulkan_fill_pipeline_cache_header(D, &header);
+    header.data_size   = size;
+    header.data_hash   = atom_hash_64(data, size, AGPU_NAME_HASH_SEED);
+    header.header_hash = vulkan_pipeline_cache_header_hash(&header);
+
+    const char* path      = (const char*)D->pPipelineCachePath;
+    const int   length    = snprintf(NULL, 0, "%s.%d.tmp", path, (int)vulkan_process_id());
+    char*       temp_path = (char*)atom_malloc((size_t)length + 1);
+    snprintf(temp_path, (size_t)length + 1, "%s.%d.tmp", path, (int)vulkan_process_id());
+    FILE* file    = fopen(temp_path, "wb");
+    bool  written = file && fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data, 1, size, file) == size;
+    if (file) written = (fclose(file) == 0) && written;
+#ifdef _WIN32
+    // rename does not replace existing files there
+    if (written) remove(path);
+#endif
+    written = written && rename(temp_path, path) == 0;
+    if (!written) remove(temp_path);
+    atom_free(temp_path);
+    return written;
+}
+
+#define VK_PIPELINE_CACHE_LOCK_ATTEMPTS 500
+#define VK_PIPELINE_CACHE_LOCK_RETRY_MS 10
+
+// an exclusive os lock on a file next to the cache serializes read-merge-rename across processes, otherwise whatever
+// another process wrote between our read and our rename would be lost. the os drops the lock with the handle, so a
+// crashed process never leaves it behind and the file itself is kept. VULKAN_NO_LOCK_FILE on timeout
+static vulkan_lock_file_t vulkan_lock_pipeline_cache_file(const VulkanDevice* D)
+{
+    const char* path      = (const char*)D->pPipelineCachePath;
+    const int   length    = snprintf(NULL, 0, "%s.lock", path);
+    char*       lock_path = (char*)atom_malloc((size_t)length + 1);
+    snprintf(lock_path, (size_t)length + 1, "%s.lock", path);
+    vulkan_lock_file_t file = vulkan_open_lock_file(lock_path);
+    atom_free(lock_path);
+    if (file == VULKAN_NO_LOCK_FILE) return VULKAN_NO_LOCK_FILE;
+    for (uint32_t attempt = 0; attempt < VK_PIPELINE_CACHE_LOCK_ATTEMPTS; attempt++) {
+        if (vulkan_try_lock_file(file)) return file;
+        vulkan_sleep_ms(VK_PIPELINE_CACHE_LOCK_RETRY_MS);
+    }
+    vulkan_close_lock_file(file);
+    return VULKAN_NO_LOCK_FILE;
+}
+
+// a blob the driver refuses is not worth failing over, the cache starts empty instead
+static VkResult vulkan_create_pipeline_cache_from(VulkanDevice* D, const void* data, size_t size, VkPipelineCache* cache)
+{
+    const struct VolkDeviceTable* table = &D->mVkDeviceTable;
+    VkPipelineCacheCreateInfo     info  = {.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+                                           .pNext           = NULL,
+                                           .initialDataSize = size,
+                                           .pInitialData    = data};
+    VkResult result = table->vkCreatePipelineCache(D->pVkDevice, &info, GLOBAL_VkAllocationCallbacks, cache);
+    if (result != VK_SUCCESS && data) {
+        info.initialDataSize = 0;
+        info.pInitialData    = NULL;
+        result               = table->vkCreatePipelineCache(D->pVkDevice, &info, GLOBAL_VkAllocationCallbacks, cache);
+    }
+    return result;
+}
+
+void vulkan_create_pipeline_cache(VulkanDevice* D, const AGPUDeviceDescriptor* desc)
 {
     atom_assert((D->pPipelineCache == VK_NULL_HANDLE) && "vulkan_create_pipeline_cache should be called only once!");
 
-    // TODO: serde
-    VkPipelineCacheCreateInfo info = {.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-                                      .pNext           = NULL,
-                                      .initialDataSize = 0,
-                                      .pInitialData    = NULL};
-    D->mVkDeviceTable.vkCreatePipelineCache(D->pVkDevice, &info, GLOBAL_VkAllocationCallbacks, &D->pPipelineCache);
+    void*  initial_data = NULL;
+    size_t initial_size = 0;
+    if (desc->pipeline_cache_directory) {
+        const VulkanAdapter* A      = (const VulkanAdapter*)D->super.adapter;
+        const char*          format = "%s/agpu_vk_pipeline_cache_%08x_%08x.bin";
+        const uint32_t       vendor = A->mPhysicalDeviceProps.properties.vendorID;
+        const uint32_t       device = A->mPhysicalDeviceProps.properties.deviceID;
+        const int            length = snprintf(NULL, 0, format, desc->pipeline_cache_directory, vendor, device);
+        D->pPipelineCachePath       = (char8_t*)atom_malloc((size_t)length + 1);
+        snprintf((char*)D->pPipelineCachePath, (size_t)length + 1, format, desc->pipeline_cache_directory, vendor, device);
+        D->mPipelineCacheSaveInterval = desc->pipeline_cache_save_interval;
+        if (D->mPipelineCacheSaveInterval) D->pPipelineCacheSaveCounter = atom_create_job_counter();
+        initial_data                  = vulkan_read_pipeline_cache_file(D, &initial_size);
+        if (initial_data) ATOM_info("Loaded %zu bytes of pipeline cache from %s", initial_size, D->pPipelineCachePath);
+    }
+    vulkan_create_pipeline_cache_from(D, initial_data, initial_size, &D->pPipelineCache);
+    atom_free(initial_data);
+}
+
+// the caller owns mPipelineCacheSaving
+static bool vulkan_save_pipeline_cache_claimed(VulkanDevice* D)
+{
+    atomic_store_explicit(&D->mPipelinesSinceSave, 0, memory_order_relaxed);
+    const vulkan_lock_file_t lock = vulkan_lock_pipeline_cache_file(D);
+    if (lock == VULKAN_NO_LOCK_FILE) {
+        ATOM_warn("Failed to lock pipeline cache %s", D->pPipelineCachePath);
+        return false;
+    }
+
+    // what other processes saved since is merged in through a scratch cache. the device cache is only ever a merge
+    // source, so pipeline creation on other threads goes on using it meanwhile
+    size_t          disk_size = 0;
+    void*           disk_data = vulkan_read_pipeline_cache_file(D, &disk_size);
+    VkPipelineCache merged    = VK_NULL_HANDLE;
+    VkResult        result    = vulkan_create_pipeline_cache_from(D, disk_data, disk_size, &merged);
+    atom_free(disk_data);
+    if (result == VK_SUCCESS) result = D->mVkDeviceTable.vkMergePipelineCaches(D->pVkDevice, merged, 1, &D->pPipelineCache);
+    bool   saved     = false;
+    size_t data_size = 0;
+    if (result == VK_SUCCESS) result = D->mVkDeviceTable.vkGetPipelineCacheData(D->pVkDevice, merged, &data_size, NULL);
+    if (result == VK_SUCCESS && data_size) {
+        void* data = atom_malloc(data_size);
+        if (D->mVkDeviceTable.vkGetPipelineCacheData(D->pVkDevice, merged, &data_size, data) == VK_SUCCESS)
+            saved = vulkan_write_pipeline_cache_file(D, data, data_size);
+        atom_free(data);
+    }
+    if (merged != VK_NULL_HANDLE) D->mVkDeviceTable.vkDestroyPipelineCache(D->pVkDevice, merged, GLOBAL_VkAllocationCallbacks);
+    vulkan_close_lock_file(lock);
+    if (!saved) ATOM_warn("Failed to save pipeline cache to %s", D->pPipelineCachePath);
+    return saved;
+}
+
+bool vulkan_save_pipeline_cache(VulkanDevice* D)
+{
+    if (D->pPipelineCache == VK_NULL_HANDLE || !D->pPipelineCachePath) return false;
+    // one save per device at a time, a concurrent request would write the same data
+    if (atomic_exchange_explicit(&D->mPipelineCacheSaving, 1, memory_order_acquire)) return false;
+    const bool saved = vulkan_save_pipeline_cache_claimed(D);
+    atomic_store_explicit(&D->mPipelineCacheSaving, 0, memory_order_release);
+    return saved;
+}
+
+static void vulkan_save_pipeline_cache_job(void* user_data)
+{
+    VulkanDevice* D = (VulkanDevice*)user_data;
+    vulkan_save_pipeline_cache_claimed(D);
+    atomic_store_explicit(&D->mPipelineCacheSaving, 0, memory_order_release);
+}
+
+// the periodic save runs as a job, the thread that crossed the interval goes on creating pipelines
+void vulkan_pipeline_cache_on_pipeline_created(VulkanDevice* D)
+{
+    if (!D->mPipelineCacheSaveInterval || !D->pPipelineCachePath) return;
+    const uint32_t count = atomic_fetch_add_explicit(&D->mPipelinesSinceSave, 1, memory_order_relaxed) + 1;
+    if (count < D->mPipelineCacheSaveInterval) return;
+    if (atomic_exchange_explicit(&D->mPipelineCacheSaving, 1, memory_order_acquire)) return;
+    const atom_job_decl_t job = {vulkan_save_pipeline_cache_job, D, ATOM_JOB_AFFINITY_ANY, false};
+    atom_job_run(&job, 1, D->pPipelineCacheSaveCounter);
 }
 
 void vulkan_free_pipeline_cache(VulkanInstance* I, VulkanAdapter* A, VulkanDevice* D)
 {
+    if (D->pPipelineCacheSaveCounter) {
+        // finalizing the job system drops queued jobs, a save that never ran would keep the counter up forever. the
+        // final save below takes its place
+        if (atom_job_system_is_initialized()) {
+            atom_job_wait(D->pPipelineCacheSaveCounter);
+        } else if (atom_job_counter_value(D->pPipelineCacheSaveCounter)) {
+            atom_job_counter_done(D->pPipelineCacheSaveCounter);
+            atomic_store_explicit(&D->mPipelineCacheSaving, 0, memory_order_release);
+        }
+        atom_free_job_counter(D->pPipelineCacheSaveCounter);
+    }
     if (D->pPipelineCache != VK_NULL_HANDLE) {
+        vulkan_save_pipeline_cache(D);
         D->mVkDeviceTable.vkDestroyPipelineCache(D->pVkDevice, D->pPipelineCache, GLOBAL_VkAllocationCallbacks);
     }
+    atom_free(D->pPipelineCachePath);
+}
+
+static const char* kVulkanObjectPoolNames[VK_OBJECT_POOL_COUNT] = {
+    "AGPU::vk_buffer",
+    "AGPU::vk_texture",
+    "AGPU::vk_texture_view",
+    "AGPU::vk_sampler",
+    "AGPU::vk_fence",
+    "AGPU::vk_semaphore",
+    "AGPU::vk_command_buffer",
+};
+
+void vulkan_create_object_pools(VulkanDevice* D)
+{
+    // buffers and textures carry their info block right behind the backend object
+    const size_t sizes[VK_OBJECT_POOL_COUNT] = {
+        sizeof(VulkanBuffer) + sizeof(AGPUBufferInfo),
+        sizeof(VulkanTexture) + sizeof(AGPUTextureInfo),
+        sizeof(VulkanTextureView),
+        sizeof(VulkanSampler),
+        sizeof(VulkanFence),
+        sizeof(VulkanSemaphore),
+        sizeof(VulkanCommandBuffer),
+    };
+    const size_t alignments[VK_OBJECT_POOL_COUNT] = {
+        _Alignof(VulkanBuffer),
+        _Alignof(VulkanTexture),
+        _Alignof(VulkanTextureView),
+        _Alignof(VulkanSampler),
+        _Alignof(VulkanFence),
+        _Alignof(VulkanSemaphore),
+        _Alignof(VulkanCommandBuffer),
+    };
+    for (uint32_t i = 0; i < VK_OBJECT_POOL_COUNT; i++) {
+        D->pObjectPools[i] = atom_create_object_pool(sizes[i], alignments[i], kVulkanObjectPoolNames[i]);
+    }
+}
+
+void vulkan_free_object_pools(VulkanDevice* D)
+{
+    for (uint32_t i = 0; i < VK_OBJECT_POOL_COUNT; i++) {
+        if (D->pObjectPools[i]) atom_free_object_pool(D->pObjectPools[i]);
+        D->pObjectPools[i] = ATOM_NULLPTR;
+    }
 }
 
 // Shader Reflection
@@ -639,6 +936,8 @@ void vulkan_record_adapter_detail(VulkanAdapter* VkAdapter)
     adapter_detail->wave_lane_count                     = VkAdapter->mSubgroupProperties.subgroupSize;
     adapter_detail->support_geom_shader                 = VkAdapter->mPhysicalDeviceFeatures.features.geometryShader;
     adapter_detail->support_tessellation                = VkAdapter->mPhysicalDeviceFeatures.features.tessellationShader;
+    adapter_detail->support_pipeline_statistics         = VkAdapter->mPhysicalDeviceFeatures.features.pipelineStatisticsQuery;
+    adapter_detail->support_precise_occlusion           = VkAdapter->mPhysicalDeviceFeatures.features.occlusionQueryPrecise;
 #if VK_EXT_extended_dynamic_state
     adapter_detail->dynamic_state_features |=
         VkAdapter->mPhysicalDeviceExtendedDynamicStateFeatures.extendedDynamicState ? AGPU_DYNAMIC_STATE_Tier1 : 0;
@@ -1002,16 +1301,16 @@ VKAPI_ATTR VkBool32 VKAPI_CALL vulkan_debug_utils_callback(VkDebugUtilsMessageSe
 
     switch (messageSeverity) {
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-            ATOM_trace("Vulkan validation layer: %s\n", pCallbackData->pMessage);
+            ATOM_trace_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pCallbackData->pMessage);
             break;
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-            ATOM_info("Vulkan validation layer: %s\n", pCallbackData->pMessage);
+            ATOM_info_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pCallbackData->pMessage);
             break;
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-            ATOM_warn("Vulkan validation layer: %s\n", pCallbackData->pMessage);
+            ATOM_warn_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pCallbackData->pMessage);
             break;
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-            ATOM_error("Vulkan validation layer: %s\n", pCallbackData->pMessage);
+            ATOM_error_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pCallbackData->pMessage);
             break;
         default: return VK_TRUE;
     }
@@ -1030,12 +1329,22 @@ VKAPI_ATTR VkBool32 VKAPI_CALL vulkan_debug_report_callback(VkDebugReportFlagsEX
     if (vulkan_try_ignore_message(pMessage, true)) return VK_FALSE;
 
     switch (flags) {
-        case VK_DEBUG_REPORT_INFORMATION_BIT_EXT:         ATOM_info("Vulkan validation layer: %s\n", pMessage);
-        case VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT: ATOM_warn("Vulkan validation layer: %s\n", pMessage); break;
-        case VK_DEBUG_REPORT_WARNING_BIT_EXT:             ATOM_warn("Vulkan validation layer: %s\n", pMessage); break;
-        case VK_DEBUG_REPORT_DEBUG_BIT_EXT:               ATOM_debug("Vulkan validation layer: %s\n", pMessage); break;
-        case VK_DEBUG_REPORT_ERROR_BIT_EXT:               ATOM_error("Vulkan validation layer: %s\n", pMessage); break;
-        default:                                          return VK_TRUE;
+        case VK_DEBUG_REPORT_INFORMATION_BIT_EXT:
+            ATOM_info_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pMessage);
+            break;
+        case VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT:
+            ATOM_warn_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pMessage);
+            break;
+        case VK_DEBUG_REPORT_WARNING_BIT_EXT:
+            ATOM_warn_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pMessage);
+            break;
+        case VK_DEBUG_REPORT_DEBUG_BIT_EXT:
+            ATOM_debug_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pMessage);
+            break;
+        case VK_DEBUG_REPORT_ERROR_BIT_EXT:
+            ATOM_error_in(ATOM_LOG_CATEGORY_VULKAN_VALIDATION, "Vulkan validation layer: %s\n", pMessage);
+            break;
+        default: return VK_TRUE;
     }
     return VK_FALSE;
 }
@@ -5,6 +5,6 @@ target("AtomEngine_Graphics_AGPU")
     set_kind("shared")
     add_includedirs("./include", { public = true })
     add_files("./src/build.**.c", "./src/build.**.cpp")
-    add_defines("SHARED_MODULE")
+    add_defines("SHARED_MODULE", "ATOM_LOG_CATEGORY=ATOM_LOG_CATEGORY_GRAPHICS")
     add_deps("AtomEngine_Core")
     add_packages("vksdk")
\ No newline at end of file